@@ -0,0 +1,91 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/recursive_read_write_mutex.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Roughly what a compositor or input thread does with SurfaceStack: mostly
+// (sometimes nested) read locks, with an occasional writer adding a surface.
+auto run(int thread_count, uint64_t iterations, uint64_t write_interval) -> std::chrono::nanoseconds
+{
+    mir::RecursiveReadWriteMutex mutex;
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&]
+            {
+                while (!go)
+                    std::this_thread::yield();
+
+                for (uint64_t n = 1; n <= iterations; ++n)
+                {
+                    if (write_interval && n % write_interval == 0)
+                    {
+                        mutex.write_lock();
+                        mutex.write_unlock();
+                    }
+                    else
+                    {
+                        mutex.read_lock();
+                        mutex.read_lock();
+                        mutex.read_unlock();
+                        mutex.read_unlock();
+                    }
+                }
+            });
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    go = true;
+
+    for (auto& thread : threads)
+        thread.join();
+
+    return std::chrono::steady_clock::now() - start;
+}
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cout<<"Usage: "<<argv[0]<<" <iterations per thread> [iterations between writes, 0 for none]"<<std::endl;
+        exit(1);
+    }
+
+    uint64_t const iterations = std::atoll(argv[1]);
+    uint64_t const write_interval = argc == 3 ? std::atoll(argv[2]) : 0;
+
+    for (int thread_count = 1; thread_count <= 32; thread_count *= 2)
+    {
+        auto const duration = run(thread_count, iterations, write_interval);
+        std::cout<<thread_count<<" threads: "
+                 <<duration.count() / (iterations * thread_count)<<"ns per iteration, "
+                 <<std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()<<"ms total"<<std::endl;
+    }
+
+    exit(0);
+}
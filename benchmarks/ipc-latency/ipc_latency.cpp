@@ -0,0 +1,130 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir_toolkit/mir_client_library.h"
+#include "mir_test_framework/headless_in_process_server.h"
+#include "mir_test_framework/stub_graphics_platform_operation.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// mir_connection_platform_operation() is the simplest synchronous round trip
+// available to a mirclient.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+namespace mtf = mir_test_framework;
+using namespace std::chrono;
+
+namespace
+{
+int const busy_clients = 40;
+int const probe_round_trips = 500;
+
+void release_reply(MirConnection*, MirPlatformMessage* reply, void*)
+{
+    mir_platform_message_release(reply);
+}
+
+void round_trip(MirConnection* connection)
+{
+    auto const request = mir_platform_message_create(
+        static_cast<unsigned int>(mtf::StubGraphicsPlatformOperation::add));
+    int const nums[]{1, 2};
+    mir_platform_message_set_data(request, nums, sizeof nums);
+
+    mir_wait_for(mir_connection_platform_operation(connection, request, release_reply, nullptr));
+
+    mir_platform_message_release(request);
+}
+
+/// A legacy client that keeps reconfiguring its outputs: the kind of slow
+/// SessionMediator call that used to hold up every other client.
+void reconfigure_repeatedly(MirConnection* connection, std::atomic<bool> const& done)
+{
+    auto const config = mir_connection_create_display_configuration(connection);
+
+    while (!done)
+    {
+        mir_connection_apply_session_display_config(connection, config);
+        round_trip(connection);
+        mir_connection_remove_session_display_config(connection);
+        round_trip(connection);
+    }
+
+    mir_display_config_release(config);
+}
+
+struct IpcLatency : mtf::HeadlessInProcessServer, ::testing::WithParamInterface<int>
+{
+    void SetUp() override
+    {
+        add_to_environment("MIR_SERVER_IPC_THREAD_POOL", std::to_string(GetParam()).c_str());
+        mtf::HeadlessInProcessServer::SetUp();
+    }
+};
+}
+
+TEST_P(IpcLatency, round_trip_under_reconfiguration_load)
+{
+    std::vector<MirConnection*> connections;
+    for (auto i = 0; i != busy_clients; ++i)
+        connections.push_back(mir_connect_sync(new_connection().c_str(), ("Busy client " + std::to_string(i)).c_str()));
+
+    auto const probe = mir_connect_sync(new_connection().c_str(), "Probe");
+    ASSERT_TRUE(mir_connection_is_valid(probe));
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> busy;
+    for (auto const connection : connections)
+        busy.emplace_back(reconfigure_repeatedly, connection, std::cref(done));
+
+    std::vector<double> latencies_us;
+    for (auto i = 0; i != probe_round_trips; ++i)
+    {
+        auto const start = steady_clock::now();
+        round_trip(probe);
+        latencies_us.push_back(duration<double, std::micro>(steady_clock::now() - start).count());
+    }
+
+    done = true;
+    for (auto& thread : busy)
+        thread.join();
+
+    mir_connection_release(probe);
+    for (auto const connection : connections)
+        mir_connection_release(connection);
+
+    std::sort(begin(latencies_us), end(latencies_us));
+    auto const percentile = [&](double p) { return latencies_us[static_cast<size_t>(p * (latencies_us.size() - 1))]; };
+
+    std::cout << "IPC threads: " << GetParam()
+              << ", busy clients: " << busy_clients << "\n"
+              << "  round trip latency (us): median " << percentile(0.5)
+              << ", 99th percentile " << percentile(0.99)
+              << ", max " << latencies_us.back() << std::endl;
+}
+
+INSTANTIATE_TEST_CASE_P(IpcThreadPool, IpcLatency, ::testing::Values(1, 2, 4, 0));
+
+#pragma GCC diagnostic pop
@@ -41,20 +41,28 @@ extern char const* const display_report_opt;
 extern char const* const legacy_input_report_opt;
 extern char const* const connector_report_opt;
 extern char const* const scene_report_opt;
+extern char const* const screencast_max_rate_opt;
 extern char const* const input_report_opt;
 extern char const* const seat_report_opt;
 extern char const* const touchspots_opt;
 extern char const* const cursor_opt;
+extern char const* const renderer_opt;
+extern char const* const gl_program_cache_opt;
+extern char const* const gl_texture_atlas_opt;
+extern char const* const gl_layer_cache_opt;
 extern char const* const fatal_except_opt;
 extern char const* const debug_opt;
 extern char const* const composite_delay_opt;
+extern char const* const coalesce_pointer_events_opt;
 extern char const* const enable_key_repeat_opt;
 extern char const* const x11_display_opt;
 extern char const* const wayland_extensions_opt;
 extern char const* const enable_mirclient_opt;
+extern char const* const ipc_thread_pool_opt;
 
 extern char const* const name_opt;
 extern char const* const offscreen_opt;
+extern char const* const offscreen_frame_socket;
 
 extern char const* const enable_key_repeat_opt;
 
@@ -65,6 +73,7 @@ extern char const* const lttng_opt_value;
 extern char const* const platform_graphics_lib;
 extern char const* const platform_input_lib;
 extern char const* const platform_path;
+extern char const* const platform_probe_cache;
 
 extern char const* const console_provider;
 extern char const* const logind_console;
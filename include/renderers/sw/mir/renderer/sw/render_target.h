@@ -0,0 +1,69 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RENDERER_SW_RENDER_TARGET_H_
+#define MIR_RENDERER_SW_RENDER_TARGET_H_
+
+#include "mir/geometry/size.h"
+#include "mir/geometry/dimensions.h"
+#include "mir_toolkit/common.h"
+
+#include <functional>
+
+namespace mir
+{
+namespace renderer
+{
+namespace software
+{
+
+/**
+ * A display buffer whose pixels the CPU can write directly.
+ *
+ * Platforms without a usable GPU expose this from
+ * DisplayBuffer::native_display_buffer() so the software renderer can
+ * composite into it.
+ */
+class RenderTarget
+{
+public:
+    virtual ~RenderTarget() = default;
+
+    /** The pixel format of the mapped buffer (only 32bpp formats are rendered) */
+    virtual MirPixelFormat pixel_format() const = 0;
+    virtual geometry::Size size() const = 0;
+    virtual geometry::Stride stride() const = 0;
+
+    /**
+     * Maps the back buffer for the duration of the call.
+     * The contents are undefined on entry unless the platform says otherwise.
+     */
+    virtual void write(std::function<void(unsigned char* pixels)> const& do_with_pixels) = 0;
+
+    /** Presents the buffer most recently written */
+    virtual void swap_buffers() = 0;
+
+protected:
+    RenderTarget() = default;
+    RenderTarget(RenderTarget const&) = delete;
+    RenderTarget& operator=(RenderTarget const&) = delete;
+};
+
+}
+}
+}
+
+#endif
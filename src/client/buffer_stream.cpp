@@ -26,6 +26,7 @@
 #include "perf_report.h"
 #include "logging/perf_report.h"
 #include "rpc/mir_display_server.h"
+#include "rpc/mir_protobuf_rpc_channel.h"
 #include "mir_protobuf.pb.h"
 #include "buffer_vault.h"
 #include "protobuf_to_native_buffer.h"
@@ -35,11 +36,14 @@
 #include "mir/log.h"
 #include "mir/client/client_platform.h"
 #include "mir/frontend/client_constants.h"
+#include "mir/frontend/buffer_ring.h"
 #include "mir_toolkit/mir_native_buffer.h"
 
 #include <boost/throw_exception.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 
+#include <cstring>
+#include <mutex>
 #include <stdexcept>
 
 namespace mcl = mir::client;
@@ -53,7 +57,7 @@ namespace gp = google::protobuf;
 
 namespace
 {
-class Requests : public mcl::ServerBufferRequests
+class Requests : public mcl::ServerBufferRequests, public std::enable_shared_from_this<Requests>
 {
 public:
     Requests(
@@ -65,6 +69,34 @@ public:
         platform(platform)
     {
     }
+
+    ~Requests()
+    {
+        if (auto const live_channel = channel.lock())
+        {
+            std::lock_guard<decltype(ring_mutex)> lock{ring_mutex};
+            if (ring)
+                live_channel->remove_watch(ring->incoming_event());
+        }
+    }
+
+    /*
+     * Ask the server for a shared-memory ring for this stream. Until (and
+     * unless) it arrives, buffers are submitted and released over the socket.
+     */
+    void request_ring(
+        std::shared_ptr<mclr::MirProtobufRpcChannel> const& rpc_channel,
+        std::weak_ptr<mcl::SurfaceMap> const& surface_map)
+    {
+        channel = rpc_channel;
+        buffers = surface_map;
+
+        mp::BufferStreamId request;
+        request.set_value(stream_id);
+        auto const response = std::make_shared<mp::SocketFD>();
+        server.create_buffer_ring(&request, response.get(),
+            google::protobuf::NewCallback(Requests::ring_created, std::weak_ptr<Requests>{shared_from_this()}, response));
+    }
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
     void allocate_buffer(geom::Size size, MirPixelFormat format, int usage) override
@@ -103,6 +135,12 @@ public:
 
     void submit_buffer(mcl::MirBuffer& buffer) override
     {
+        {
+            std::lock_guard<decltype(ring_mutex)> lock{ring_mutex};
+            if (ring && ring->push(buffer.rpc_id()))
+                return;
+        }
+
         mp::BufferRequest request;
         request.mutable_id()->set_value(stream_id);
         request.mutable_buffer()->set_buffer_id(buffer.rpc_id());
@@ -117,11 +155,68 @@ public:
     }
 
 private:
+    static void ring_created(std::weak_ptr<Requests> weak_self, std::shared_ptr<mp::SocketFD> response)
+    {
+        std::vector<mir::Fd> fds;
+        for (auto fd : response->fd())
+            fds.emplace_back(fd);
+
+        auto const self = weak_self.lock();
+        auto const live_channel = self ? self->channel.lock() : nullptr;
+        if (!live_channel || response->has_error() || fds.size() != 3)
+            return;
+
+        try
+        {
+            auto const new_ring = std::make_shared<mf::BufferRing>(fds[0], fds[1], fds[2], mf::BufferRing::End::client);
+
+            std::lock_guard<decltype(self->ring_mutex)> lock{self->ring_mutex};
+            self->ring = new_ring;
+            live_channel->add_watch(new_ring->incoming_event(), [weak_self] { drain_releases(weak_self); });
+        }
+        catch (std::exception const& error)
+        {
+            mir::log_warning("Failed to map buffer ring: %s", error.what());
+        }
+    }
+
+    static void drain_releases(std::weak_ptr<Requests> const& weak_self)
+    {
+        auto const self = weak_self.lock();
+        auto const surface_map = self ? self->buffers.lock() : nullptr;
+        if (!surface_map)
+            return;
+
+        std::shared_ptr<mf::BufferRing> current_ring;
+        {
+            std::lock_guard<decltype(self->ring_mutex)> lock{self->ring_mutex};
+            current_ring = self->ring;
+        }
+
+        current_ring->drain(
+            [&](int32_t buffer_id)
+            {
+                if (auto const buffer = surface_map->buffer(buffer_id))
+                    buffer->received();
+            });
+    }
+
     mclr::DisplayServer& server;
     int stream_id;
     std::shared_ptr<mcl::ClientPlatform> const platform;
+
+    std::weak_ptr<mclr::MirProtobufRpcChannel> channel;
+    std::weak_ptr<mcl::SurfaceMap> buffers;
+    std::mutex ring_mutex;
+    std::shared_ptr<mf::BufferRing> ring;
 };
 
+bool buffer_ring_requested()
+{
+    auto const env = getenv("MIR_CLIENT_BUFFER_RING");
+    return env && strcmp(env, "0") != 0;
+}
+
 mir::optional_value<int> parse_env_for_swap_interval()
 {
     if (auto env = getenv("MIR_CLIENT_FORCE_SWAP_INTERVAL"))
@@ -310,13 +405,23 @@ mcl::BufferStream::BufferStream(
 
     try
     {
+        auto const requests = std::make_shared<Requests>(server, protobuf_bs->id().value(), client_platform);
         buffer_depository = std::make_unique<BufferDepository>(
             client_platform->create_buffer_factory(), factory,
-            std::make_shared<Requests>(server, protobuf_bs->id().value(), client_platform),
+            requests,
             map,
             ideal_buffer_size, static_cast<MirPixelFormat>(protobuf_bs->pixel_format()), 
             protobuf_bs->buffer_usage(), nbuffers);
 
+        if (connection && buffer_ring_requested())
+        {
+            if (auto const channel =
+                    std::dynamic_pointer_cast<mclr::MirProtobufRpcChannel>(connection->rpc_channel()))
+            {
+                requests->request_ring(channel, map);
+            }
+        }
+
         egl_native_window_ = client_platform->create_egl_native_window(this);
 
         // This might seem like something to provide during creation but
@@ -161,6 +161,13 @@ void mclr::DisplayServer::release_buffer_stream(
 {
     channel->call_method(std::string(__func__), request, response, done);
 }
+void mclr::DisplayServer::create_buffer_ring(
+    mir::protobuf::BufferStreamId const* request,
+    mir::protobuf::SocketFD* response,
+    google::protobuf::Closure* done)
+{
+    channel->call_method(std::string(__func__), request, response, done);
+}
 void mclr::DisplayServer::configure_cursor(
     mir::protobuf::CursorSetting const* request,
     mir::protobuf::Void* response,
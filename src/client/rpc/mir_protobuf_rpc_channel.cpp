@@ -579,3 +579,13 @@ void mclr::MirProtobufRpcChannel::process_next_request_first()
     prioritise_next_request = true;
     multiplexer.remove_watch(delayed_processor);
 }
+
+void mclr::MirProtobufRpcChannel::add_watch(Fd const& fd, std::function<void()> const& callback)
+{
+    multiplexer.add_watch(fd, callback);
+}
+
+void mclr::MirProtobufRpcChannel::remove_watch(Fd const& fd)
+{
+    multiplexer.remove_watch(fd);
+}
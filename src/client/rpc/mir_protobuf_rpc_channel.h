@@ -101,6 +101,10 @@ public:
      */
     void process_next_request_first();
 
+    /// Calls \a callback on the channel's dispatch thread whenever \a fd is readable
+    void add_watch(Fd const& fd, std::function<void()> const& callback);
+    void remove_watch(Fd const& fd);
+
     void call_method(
         std::string const& method_name,
         google::protobuf::MessageLite const* parameters,
@@ -19,69 +19,162 @@
 #include "mir/recursive_read_write_mutex.h"
 
 #include <algorithm>
+#include <vector>
 
-void mir::RecursiveReadWriteMutex::read_lock()
+namespace
 {
-    auto const my_id = std::this_thread::get_id();
+std::atomic<uint64_t> next_mutex_id{1};
+std::atomic<unsigned int> next_reader_slot{0};
 
-    std::unique_lock<decltype(mutex)> lock{mutex};
-    cv.wait(lock, [&]{
-        return !write_locking_thread.count ||
-            write_locking_thread.id == my_id; });
+auto this_threads_reader_slot() -> unsigned int
+{
+    static thread_local unsigned int const slot = next_reader_slot.fetch_add(1);
+    return slot;
+}
+
+// Keyed by id rather than address, so a mutex destroyed while read locked
+// can't lend its count to a new one at the same address
+struct ReadLockCount
+{
+    uint64_t mutex_id;
+    unsigned int count;
+};
 
+thread_local std::vector<ReadLockCount> read_lock_counts;
+}
+
+mir::RecursiveReadWriteMutex::RecursiveReadWriteMutex() :
+    id{next_mutex_id.fetch_add(1)}
+{
+}
+
+auto mir::RecursiveReadWriteMutex::read_locks_held_by_this_thread() -> unsigned int&
+{
     auto const my_count = std::find_if(
-        read_locking_threads.begin(),
-        read_locking_threads.end(),
-        [my_id](ThreadLockCount const& candidate) { return my_id == candidate.id; });
+        read_lock_counts.begin(),
+        read_lock_counts.end(),
+        [this](ReadLockCount const& candidate) { return candidate.mutex_id == id; });
+
+    if (my_count != read_lock_counts.end())
+        return my_count->count;
 
-    if (my_count == read_locking_threads.end())
+    read_lock_counts.push_back(ReadLockCount{id, 0});
+    return read_lock_counts.back().count;
+}
+
+auto mir::RecursiveReadWriteMutex::read_locks_held_by_other_threads() -> unsigned int
+{
+    unsigned int total{0};
+    for (auto const& slot : reader_slots)
+        total += slot.count;
+
+    auto const my_count = std::find_if(
+        read_lock_counts.begin(),
+        read_lock_counts.end(),
+        [this](ReadLockCount const& candidate) { return candidate.mutex_id == id; });
+
+    return my_count == read_lock_counts.end() ? total : total - my_count->count;
+}
+
+void mir::RecursiveReadWriteMutex::wake_waiting_writer()
+{
+    if (waiting_writers)
     {
-        read_locking_threads.push_back(ThreadLockCount(my_id, 1U));
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        cv.notify_all();
     }
-    else
+}
+
+void mir::RecursiveReadWriteMutex::read_lock()
+{
+    auto& slot = reader_slots[this_threads_reader_slot() % slot_count].count;
+    auto& my_count = read_locks_held_by_this_thread();
+
+    // A thread already holding the lock, for reading or writing, never waits
+    if (my_count || write_locking_thread == std::this_thread::get_id())
     {
-        ++(my_count->count);
+        ++slot;
+        ++my_count;
+        return;
     }
+
+    for (;;)
+    {
+        ++slot;
+        if (!write_locked)
+            break;
+
+        // A writer has, or is about to take, the lock: step aside until it's done
+        --slot;
+        wake_waiting_writer();
+
+        std::unique_lock<decltype(mutex)> lock{mutex};
+        cv.wait(lock, [this]{ return !write_locked; });
+    }
+
+    ++my_count;
 }
 
 void mir::RecursiveReadWriteMutex::read_unlock()
 {
-    auto const my_id = std::this_thread::get_id();
-
-    std::lock_guard<decltype(mutex)> lock{mutex};
-    auto const my_count = std::find_if(
-        read_locking_threads.begin(),
-        read_locking_threads.end(),
-        [my_id](ThreadLockCount const& candidate) { return my_id == candidate.id; });
+    auto& my_count = read_locks_held_by_this_thread();
 
-    --(my_count->count);
+    if (--my_count == 0)
+    {
+        read_lock_counts.erase(
+            std::remove_if(
+                read_lock_counts.begin(),
+                read_lock_counts.end(),
+                [this](ReadLockCount const& candidate) { return candidate.mutex_id == id; }),
+            read_lock_counts.end());
+    }
 
-    cv.notify_all();
+    --reader_slots[this_threads_reader_slot() % slot_count].count;
+    wake_waiting_writer();
 }
 
 void mir::RecursiveReadWriteMutex::write_lock()
 {
     auto const my_id = std::this_thread::get_id();
 
+    if (write_locking_thread == my_id)
+    {
+        ++write_lock_count;
+        return;
+    }
+
     std::unique_lock<decltype(mutex)> lock{mutex};
-    cv.wait(lock, [&]
-        {
-            if (write_locking_thread.count &&
-                write_locking_thread.id != my_id) return false;
-            for (auto const& candidate : read_locking_threads)
-            {
-                if (candidate.id != my_id && candidate.count != 0) return false;
-            }
-            return true;
-        });
-
-    ++write_locking_thread.count;
-    write_locking_thread.id = my_id;
+
+    for (;;)
+    {
+        cv.wait(lock, [this]{ return !write_locked; });
+
+        // Announce ourselves before counting, so a reader either sees us or is counted
+        write_locked = true;
+        if (read_locks_held_by_other_threads() == 0)
+            break;
+
+        // Readers got in first: let through any we held off, and wait for them all to leave
+        write_locked = false;
+        cv.notify_all();
+
+        ++waiting_writers;
+        cv.wait(lock, [this]{ return read_locks_held_by_other_threads() == 0; });
+        --waiting_writers;
+    }
+
+    write_locking_thread = my_id;
+    write_lock_count = 1;
 }
 
 void mir::RecursiveReadWriteMutex::write_unlock()
 {
+    if (--write_lock_count)
+        return;
+
+    write_locking_thread = std::thread::id{};
+
     std::lock_guard<decltype(mutex)> lock{mutex};
-    --write_locking_thread.count;
+    write_locked = false;
     cv.notify_all();
 }
@@ -0,0 +1,198 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_BUFFER_RING_H_
+#define MIR_FRONTEND_BUFFER_RING_H_
+
+#include "mir/fd.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/memfd.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+namespace mir
+{
+namespace frontend
+{
+/**
+ * Buffer ids passed between a client buffer stream and the server through
+ * shared memory rather than as submit_buffer calls and buffer update events.
+ *
+ * The mapping holds two single-producer, single-consumer queues: submissions
+ * (client to server) and releases (server to client). Each direction has an
+ * eventfd, which the producer only signals when the consumer has said it is
+ * going to sleep, so a stream that keeps both ends busy costs no wakeups.
+ *
+ * The server must treat anything it reads from the mapping as untrusted: each
+ * end keeps its own copy of the indices it owns, and a consumer that sees an
+ * impossible producer index marks the ring broken.
+ */
+class BufferRing
+{
+public:
+    enum class End { client, server };
+
+    static uint32_t const capacity = 64;
+
+    /// Server side: allocates the mapping and eventfds to send to the client
+    static auto create() -> std::unique_ptr<BufferRing>
+    {
+        Fd shm{static_cast<int>(syscall(SYS_memfd_create, "mir-buffer-ring", MFD_CLOEXEC))};
+        if (shm < 0)
+            BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create buffer ring"}));
+        if (ftruncate(shm, sizeof(Shared)) < 0)
+            BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to size buffer ring"}));
+
+        auto ring = std::make_unique<BufferRing>(shm, new_eventfd(), new_eventfd(), End::server);
+        ring->shared->submissions.consumer_sleeping = 1;
+        ring->shared->releases.consumer_sleeping = 1;
+        return ring;
+    }
+
+    /// Maps a ring; \a fds in the order given by fds()
+    BufferRing(Fd const& shm, Fd const& submission_event, Fd const& release_event, End end) :
+        shm{shm},
+        submission_event{submission_event},
+        release_event{release_event},
+        end{end},
+        shared{static_cast<Shared*>(mmap(nullptr, sizeof(Shared), PROT_READ|PROT_WRITE, MAP_SHARED, shm, 0))}
+    {
+        if (shared == MAP_FAILED)
+            BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to map buffer ring"}));
+    }
+
+    ~BufferRing()
+    {
+        munmap(shared, sizeof(Shared));
+    }
+
+    auto fds() const -> std::vector<Fd>
+    {
+        return {shm, submission_event, release_event};
+    }
+
+    /// The fd that becomes readable when the other end has queued ids for us
+    auto incoming_event() const -> Fd
+    {
+        return end == End::server ? submission_event : release_event;
+    }
+
+    /**
+     * Queue \a buffer_id for the other end.
+     * \return false if the ring is full or broken; use the socket instead
+     */
+    bool push(int32_t buffer_id)
+    {
+        auto& queue = outgoing();
+        if (broken || out_head - queue.tail.load(std::memory_order_acquire) >= capacity)
+            return false;
+
+        queue.ids[out_head % capacity].store(buffer_id, std::memory_order_relaxed);
+        queue.head = ++out_head;
+
+        if (queue.consumer_sleeping.exchange(0))
+            eventfd_write(end == End::server ? release_event : submission_event, 1);
+
+        return true;
+    }
+
+    /// Calls \a handler with each queued id until the other end stops producing
+    template<typename Handler>
+    void drain(Handler const& handler)
+    {
+        auto& queue = incoming();
+
+        eventfd_t ignored;
+        eventfd_read(incoming_event(), &ignored);
+
+        while (!broken)
+        {
+            uint32_t const head = queue.head;
+            if (head - in_tail > capacity)
+            {
+                broken = true;
+                return;
+            }
+
+            for (; in_tail != head; ++in_tail)
+                handler(queue.ids[in_tail % capacity].load(std::memory_order_relaxed));
+            queue.tail.store(in_tail, std::memory_order_release);
+
+            // Announce we're going to sleep before the final check, so that a
+            // producer either sees the flag or we see its new head.
+            queue.consumer_sleeping = 1;
+            if (queue.head == in_tail)
+                return;
+            queue.consumer_sleeping = 0;
+        }
+    }
+
+    bool is_broken() const { return broken; }
+
+private:
+    struct Queue
+    {
+        alignas(64) std::atomic<uint32_t> head;
+        alignas(64) std::atomic<uint32_t> tail;
+        alignas(64) std::atomic<uint32_t> consumer_sleeping;
+        std::atomic<int32_t> ids[capacity];
+    };
+
+    struct Shared
+    {
+        Queue submissions;
+        Queue releases;
+    };
+
+    static_assert(ATOMIC_INT_LOCK_FREE == 2, "BufferRing needs address-free atomics");
+
+    static auto new_eventfd() -> Fd
+    {
+        Fd fd{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)};
+        if (fd < 0)
+            BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create eventfd"}));
+        return fd;
+    }
+
+    auto outgoing() -> Queue& { return end == End::server ? shared->releases : shared->submissions; }
+    auto incoming() -> Queue& { return end == End::server ? shared->submissions : shared->releases; }
+
+    Fd const shm;
+    Fd const submission_event;
+    Fd const release_event;
+    End const end;
+    Shared* const shared;
+
+    uint32_t out_head{0};
+    uint32_t in_tail{0};
+    bool broken{false};
+};
+}
+}
+
+#endif /* MIR_FRONTEND_BUFFER_RING_H_ */
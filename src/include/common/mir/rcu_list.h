@@ -0,0 +1,367 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RCU_LIST_H_
+#define MIR_RCU_LIST_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace mir
+{
+/**
+ * A list that is cheap to iterate and rarely changed (e.g. observers).
+ *
+ * for_each() takes no locks: it claims a reader slot, records the current
+ * epoch in it and walks an immutable snapshot of the list. add() and remove()
+ * copy the snapshot, publish the copy, and retire the old one in the current
+ * epoch before advancing it. Whatever was retired is freed (by a writer, or
+ * by a reader on its way out) once no slot records an epoch that old, so it
+ * is reclaimed even while newer readers keep overlapping.
+ *
+ * The guarantees match ThreadSafeList:
+ *  - an element may remove itself, or any other, from within for_each();
+ *  - an element that has been removed is not called again; and
+ *  - remove() waits until calls of that element on other threads complete.
+ *
+ * Requirements for type 'Element'
+ *  - copy-constructible
+ *  - bool operator==: equality of elements
+ */
+template<class Element>
+class RcuList
+{
+public:
+    RcuList() = default;
+    ~RcuList();
+
+    void add(Element const& element);
+    void remove(Element const& element);
+    unsigned int remove_all(Element const& element);
+    void clear();
+
+    template<typename Functor>
+    void for_each(Functor const& f);
+
+private:
+    RcuList(RcuList const&) = delete;
+    RcuList& operator=(RcuList const&) = delete;
+
+    struct Node
+    {
+        explicit Node(Element const& element) : element{element} {}
+
+        Element const element;
+        std::atomic<bool> live{true};
+        std::atomic<unsigned int> in_flight{0};
+    };
+
+    using Snapshot = std::vector<Node*>;
+
+    /// One per concurrent reader; slots are reused, and only freed with the list
+    struct ReaderSlot
+    {
+        std::atomic<bool> claimed{true};
+        std::atomic<std::uint64_t> epoch{0};  ///< 0 while not reading
+        ReaderSlot* next{nullptr};
+    };
+
+    struct Reader
+    {
+        explicit Reader(RcuList& list);
+        ~Reader();
+
+        RcuList& list;
+        ReaderSlot& slot;
+    };
+
+    /// A snapshot, and any nodes removed with it, that readers in epoch or before might hold
+    struct Retired
+    {
+        std::uint64_t epoch;
+        Snapshot* snapshot;
+        std::vector<Node*> nodes;
+    };
+
+    struct Call
+    {
+        explicit Call(RcuList& list, Node* node);
+        ~Call();
+
+        RcuList& list;
+        Node* const node;
+    };
+
+    /// Nodes this thread is calling, so remove() doesn't wait for itself
+    static auto nodes_in_use_by_this_thread() -> std::vector<Node const*>&
+    {
+        static thread_local std::vector<Node const*> nodes;
+        return nodes;
+    }
+
+    template<typename Predicate>
+    auto remove_if(Predicate const& matches, bool all) -> unsigned int;
+    auto claim_reader_slot() -> ReaderSlot&;
+    void retire(std::lock_guard<std::mutex> const&, Snapshot* snapshot, std::vector<Node*> nodes);
+    void reclaim_if_unread();
+    void reclaim_if_unread(std::lock_guard<std::mutex> const&);
+    void wait_until_unused(Node const* node);
+
+    std::atomic<Snapshot*> current{new Snapshot};
+    std::atomic<std::uint64_t> epoch{1};
+    std::atomic<ReaderSlot*> reader_slots{nullptr};
+    std::atomic<bool> has_garbage{false};
+
+    std::mutex writer_mutex;
+    std::vector<Retired> retired;  ///< In epoch order
+
+    std::mutex unused_mutex;
+    std::condition_variable unused_cv;
+};
+
+template<class Element>
+RcuList<Element>::~RcuList()
+{
+    for (auto const node : *current.load())
+        delete node;
+    delete current.load();
+
+    for (auto const& garbage : retired)
+    {
+        delete garbage.snapshot;
+        for (auto const node : garbage.nodes)
+            delete node;
+    }
+
+    for (auto slot = reader_slots.load(); slot;)
+    {
+        auto const next = slot->next;
+        delete slot;
+        slot = next;
+    }
+}
+
+template<class Element>
+RcuList<Element>::Reader::Reader(RcuList& list) :
+    list(list),
+    slot(list.claim_reader_slot())
+{
+    // A writer that saw this slot idle has already published; we load its snapshot, not an older one
+    slot.epoch = list.epoch.load();
+}
+
+template<class Element>
+RcuList<Element>::Reader::~Reader()
+{
+    slot.epoch = 0;
+    slot.claimed = false;
+
+    if (list.has_garbage)
+        list.reclaim_if_unread();
+}
+
+template<class Element>
+auto RcuList<Element>::claim_reader_slot() -> ReaderSlot&
+{
+    for (auto slot = reader_slots.load(); slot; slot = slot->next)
+    {
+        bool unclaimed = false;
+        if (!slot->claimed && slot->claimed.compare_exchange_strong(unclaimed, true))
+            return *slot;
+    }
+
+    // Every slot is in use, so there's another concurrent reader
+    auto const slot = new ReaderSlot;
+    slot->next = reader_slots.load();
+    while (!reader_slots.compare_exchange_weak(slot->next, slot))
+        ;
+    return *slot;
+}
+
+template<class Element>
+RcuList<Element>::Call::Call(RcuList& list, Node* node) :
+    list(list),
+    node{node}
+{
+    node->in_flight.fetch_add(1);
+    nodes_in_use_by_this_thread().push_back(node);
+}
+
+template<class Element>
+RcuList<Element>::Call::~Call()
+{
+    nodes_in_use_by_this_thread().pop_back();
+    node->in_flight.fetch_sub(1);
+
+    // A remover may be waiting for the count to fall to its own calls, not necessarily to zero
+    if (!node->live)
+    {
+        std::lock_guard<std::mutex> const lock{list.unused_mutex};
+        list.unused_cv.notify_all();
+    }
+}
+
+template<class Element>
+template<typename Functor>
+void RcuList<Element>::for_each(Functor const& f)
+{
+    Reader const reader{*this};
+
+    for (auto const node : *current.load())
+    {
+        Call const call{*this, node};
+
+        // Registering the call before checking live pairs with remove() clearing it before waiting
+        if (node->live)
+            f(node->element);
+    }
+}
+
+template<class Element>
+void RcuList<Element>::add(Element const& element)
+{
+    std::lock_guard<std::mutex> const lock{writer_mutex};
+
+    auto const old = current.load();
+    auto const updated = new Snapshot{*old};
+    updated->push_back(new Node{element});
+
+    current = updated;
+    retire(lock, old, {});
+
+    reclaim_if_unread(lock);
+}
+
+template<class Element>
+void RcuList<Element>::remove(Element const& element)
+{
+    remove_if([&](Element const& candidate) { return candidate == element; }, false);
+}
+
+template<class Element>
+unsigned int RcuList<Element>::remove_all(Element const& element)
+{
+    return remove_if([&](Element const& candidate) { return candidate == element; }, true);
+}
+
+template<class Element>
+void RcuList<Element>::clear()
+{
+    remove_if([](Element const&) { return true; }, true);
+}
+
+template<class Element>
+template<typename Predicate>
+auto RcuList<Element>::remove_if(Predicate const& matches, bool all) -> unsigned int
+{
+    // Stay registered as a reader so the removed nodes can't be freed while we wait on them
+    Reader const reader{*this};
+    std::vector<Node*> removed;
+
+    {
+        std::lock_guard<std::mutex> const lock{writer_mutex};
+
+        auto const old = current.load();
+        auto const updated = new Snapshot;
+        updated->reserve(old->size());
+
+        for (auto const node : *old)
+        {
+            if ((all || removed.empty()) && matches(node->element))
+            {
+                node->live = false;
+                removed.push_back(node);
+            }
+            else
+            {
+                updated->push_back(node);
+            }
+        }
+
+        if (removed.empty())
+        {
+            delete updated;
+            return 0;
+        }
+
+        current = updated;
+        retire(lock, old, removed);
+    }
+
+    for (auto const node : removed)
+        wait_until_unused(node);
+
+    return removed.size();
+}
+
+template<class Element>
+void RcuList<Element>::wait_until_unused(Node const* node)
+{
+    auto const& in_use = nodes_in_use_by_this_thread();
+    auto const ours = static_cast<unsigned int>(std::count(begin(in_use), end(in_use), node));
+
+    std::unique_lock<std::mutex> lock{unused_mutex};
+    unused_cv.wait(lock, [&] { return node->in_flight <= ours; });
+}
+
+template<class Element>
+void RcuList<Element>::retire(std::lock_guard<std::mutex> const&, Snapshot* snapshot, std::vector<Node*> nodes)
+{
+    // Only readers that recorded this epoch (or an earlier one) can have loaded what's retired
+    retired.push_back(Retired{epoch.fetch_add(1), snapshot, std::move(nodes)});
+    has_garbage = true;
+}
+
+template<class Element>
+void RcuList<Element>::reclaim_if_unread()
+{
+    // If a writer holds the lock the garbage waits for it, or for the next reader out
+    if (!writer_mutex.try_lock())
+        return;
+
+    std::lock_guard<std::mutex> const lock{writer_mutex, std::adopt_lock};
+    reclaim_if_unread(lock);
+}
+
+template<class Element>
+void RcuList<Element>::reclaim_if_unread(std::lock_guard<std::mutex> const&)
+{
+    auto oldest_read = epoch.load();
+    for (auto slot = reader_slots.load(); slot; slot = slot->next)
+    {
+        auto const slot_epoch = slot->epoch.load();
+        if (slot_epoch != 0 && slot_epoch < oldest_read)
+            oldest_read = slot_epoch;
+    }
+
+    auto unread = begin(retired);
+    for (; unread != end(retired) && unread->epoch < oldest_read; ++unread)
+    {
+        delete unread->snapshot;
+        for (auto const node : unread->nodes)
+            delete node;
+    }
+
+    retired.erase(begin(retired), unread);
+    has_garbage = !retired.empty();
+}
+}
+
+#endif /* MIR_RCU_LIST_H_ */
@@ -19,18 +19,28 @@
 #ifndef MIR_RECURSIVE_READ_WRITE_MUTEX_H_
 #define MIR_RECURSIVE_READ_WRITE_MUTEX_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <thread>
-#include <vector>
 
 namespace mir
 {
 /** a recursive read-write mutex.
  * Note that a write lock can be acquired if no other threads have a read lock.
+ *
+ * Readers are counted in per-thread slots, so uncontended read_lock() and
+ * read_unlock() touch one (mostly) unshared cache line and take no mutex. The
+ * internal mutex and condition variable are only used when a writer holds,
+ * or is waiting for, the lock. A writer waiting for readers to leave doesn't
+ * hold off new readers.
  */
 class RecursiveReadWriteMutex
 {
 public:
+    RecursiveReadWriteMutex();
+
     void read_lock();
 
     void read_unlock();
@@ -40,17 +50,30 @@ public:
     void write_unlock();
 
 private:
-    std::mutex mutex;
-    std::condition_variable cv;
-    struct ThreadLockCount
+    RecursiveReadWriteMutex(RecursiveReadWriteMutex const&) = delete;
+    RecursiveReadWriteMutex& operator=(RecursiveReadWriteMutex const&) = delete;
+
+    static unsigned int const slot_count = 8;
+
+    struct alignas(64) ReaderSlot
     {
-        ThreadLockCount() : id(), count(0) {}
-        ThreadLockCount(std::thread::id id, unsigned int count) : id(id), count(count) {}
-        std::thread::id id;
-        unsigned int count;
+        std::atomic<unsigned int> count{0};
     };
-    std::vector<ThreadLockCount> read_locking_threads;
-    ThreadLockCount write_locking_thread;
+
+    auto read_locks_held_by_this_thread() -> unsigned int&;
+    auto read_locks_held_by_other_threads() -> unsigned int;
+    void wake_waiting_writer();
+
+    ReaderSlot reader_slots[slot_count];
+
+    uint64_t const id;
+    std::atomic<bool> write_locked{false};
+    std::atomic<std::thread::id> write_locking_thread{};
+    unsigned int write_lock_count{0};
+    std::atomic<unsigned int> waiting_writers{0};
+
+    std::mutex mutex;
+    std::condition_variable cv;
 };
 
 class RecursiveReadLock
@@ -72,6 +72,14 @@ public:
     virtual void register_compositor(CompositorID id) = 0;
     virtual void unregister_compositor(CompositorID id) = 0;
 
+    /**
+     * Tell the scene which area a registered compositor displays. Its
+     * scene_elements_for() may then leave out elements that cannot appear
+     * within that area and frames_pending() need only consider surfaces
+     * within it. Compositors that never set an area are given the whole scene.
+     */
+    virtual void set_compositor_area(CompositorID id, geometry::Rectangle const& area) = 0;
+
     virtual void add_observer(std::shared_ptr<scene::Observer> const& observer) = 0;
     virtual void remove_observer(std::weak_ptr<scene::Observer> const& observer) = 0;
 
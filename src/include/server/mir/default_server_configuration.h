@@ -205,6 +205,7 @@ public:
             std::function<void(std::function<void()>&& work)> const&)> builder) override;
 
     void set_wayland_extension_filter(WaylandProtocolExtensionFilter const& extension_filter) override;
+    void set_wayland_pointer_coalescing_filter(WaylandPointerCoalescingFilter const& filter) override;
     void set_enabled_wayland_extensions(std::vector<std::string> const& extensions) override;
 
     /**
@@ -495,6 +496,8 @@ private:
     std::vector<WaylandExtensionHook> wayland_extension_hooks;
     WaylandProtocolExtensionFilter wayland_extension_filter =
         [](std::shared_ptr<scene::Session> const&, char const*) { return true; };
+    WaylandPointerCoalescingFilter wayland_pointer_coalescing_filter =
+        [](std::shared_ptr<scene::Session> const&) { return true; };
     std::vector<std::string> enabled_wayland_extensions;
 };
 }
@@ -27,6 +27,7 @@
 #include "mir_protobuf.pb.h"
 
 #include <google/protobuf/stubs/common.h>
+#include <google/protobuf/arena.h>
 #include <boost/exception/diagnostic_information.hpp>
 
 #include <memory>
@@ -45,8 +46,31 @@ namespace detail
 template<typename ResultType> struct result_ptr_t
 { typedef ::google::protobuf::MessageLite* type; };
 
+// Closure that sends a result message through Self::send_response(). Lives on
+// the stack of invoke(), so the server function must complete synchronously.
+template<class Self, class ResultMessage>
+class SendResponseClosure : public ::google::protobuf::Closure
+{
+public:
+    SendResponseClosure(Self* self, ::google::protobuf::uint32 id, ResultMessage* result_message) :
+        self{self}, id{id}, result_message{result_message}
+    {
+    }
+
+    void Run() override
+    {
+        self->send_response(id, static_cast<typename result_ptr_t<ResultMessage>::type>(result_message));
+    }
+
+private:
+    Self* const self;
+    ::google::protobuf::uint32 const id;
+    ResultMessage* const result_message;
+};
+
 // Boiler plate for unpacking a parameter message, invoking a server function, and
-// sending the result message. Assumes the existence of Self::send_response().
+// sending the result message. Assumes the existence of Self::send_response() and
+// of Self::arena(), which owns the messages until the invocation is complete.
 template<class Self, class Server, class ServerX, class ParameterMessage, class ResultMessage>
 void invoke(
     Self* self,
@@ -57,27 +81,19 @@ void invoke(
         ::google::protobuf::Closure* done),
         Invocation const& invocation)
 {
-    ParameterMessage parameter_message;
-    if (!parameter_message.ParseFromString(invocation.parameters()))
+    auto const parameter_message = google::protobuf::Arena::CreateMessage<ParameterMessage>(self->arena());
+    if (!parameter_message->ParseFromString(invocation.parameters()))
         BOOST_THROW_EXCEPTION(std::runtime_error("Failed to parse message parameters!"));
-    ResultMessage result_message;
+    auto const result_message = google::protobuf::Arena::CreateMessage<ResultMessage>(self->arena());
 
     try
     {
-        std::unique_ptr<google::protobuf::Closure> callback(
-            google::protobuf::NewPermanentCallback<
-                Self,
-                ::google::protobuf::uint32,
-                typename result_ptr_t<ResultMessage>::type>(
-                    self,
-                    &Self::send_response,
-                    invocation.id(),
-                    &result_message));
+        SendResponseClosure<Self, ResultMessage> callback{self, invocation.id(), result_message};
 
         (server->*function)(
-            &parameter_message,
-            &result_message,
-            callback.get());
+            parameter_message,
+            result_message,
+            &callback);
     }
     catch (mir::cookie::SecurityCheckError const& /*err*/)
     {
@@ -85,17 +101,17 @@ void invoke(
     }
     catch (mir::ClientVisibleError const& error)
     {
-        auto client_error = result_message.mutable_structured_error();
+        auto client_error = result_message->mutable_structured_error();
         client_error->set_code(error.code());
         client_error->set_domain(error.domain());
-        self->send_response(invocation.id(), &result_message);
+        self->send_response(invocation.id(), result_message);
     }
     catch (std::exception const& x)
     {
         using namespace std::literals::string_literals;
-        result_message.set_error("Error processing request: "s +
+        result_message->set_error("Error processing request: "s +
             x.what() + "\nInternal error details: " + boost::diagnostic_information(x));
-        self->send_response(invocation.id(), &result_message);
+        self->send_response(invocation.id(), result_message);
     }
 }
 
@@ -73,12 +73,86 @@ void add_server_action_gsource(
     std::function<void()> const& action,
     std::function<bool(void const*)> const& should_dispatch);
 
-GSourceHandle add_timer_gsource(
-    GMainContext* main_context,
-    std::shared_ptr<time::Clock> const& clock,
-    std::shared_ptr<LockableCallback> const& handler,
-    std::function<void()> const& exception_handler,
-    time::Timestamp target_time);
+/**
+ * The actions enqueued on a main loop, dispatched from a single GSource.
+ *
+ * Producers push onto a lock-free stack and only the first push after the
+ * main loop has taken the stack wakes it, so a burst of actions costs one
+ * wakeup and runs in one dispatch (in the order it was enqueued). Actions
+ * for paused owners are held, in order, until the owner is resumed.
+ */
+class ServerActionQueue
+{
+public:
+    ServerActionQueue(GMainContext* main_context);
+    ~ServerActionQueue();
+
+    void enqueue(void const* owner, std::function<void()> const& action);
+    void pause(void const* owner);
+    void resume(void const* owner);
+
+private:
+    ServerActionQueue(ServerActionQueue const&) = delete;
+    ServerActionQueue& operator=(ServerActionQueue const&) = delete;
+
+    struct Action;
+    struct State;
+    struct ActionGSource;
+
+    GMainContext* const main_context;
+    State* const state;
+    GSourceHandle gsource;
+};
+
+/**
+ * The alarms of a main loop, kept on a timer wheel dispatched by a single GSource.
+ *
+ * Scheduling or cancelling an alarm is a constant-time change to the wheel
+ * rather than the creation (and deferred destruction) of a GSource. Alarms
+ * due within the same millisecond are dispatched together, and the main loop
+ * is only woken when an alarm is scheduled earlier than it intends to wake.
+ */
+class AlarmQueue
+{
+    struct State;
+    struct Entry;
+
+public:
+    AlarmQueue(GMainContext* main_context, std::shared_ptr<time::Clock> const& clock);
+    ~AlarmQueue();
+
+    /// One alarm's place on the queue; may outlive the queue
+    class Timer
+    {
+    public:
+        Timer(
+            AlarmQueue& queue,
+            std::shared_ptr<LockableCallback> const& handler,
+            std::function<void()> const& exception_handler);
+        ~Timer();
+
+        void schedule(time::Timestamp time);
+
+        /// Ensures no further dispatch, waiting for any dispatch in progress on another thread
+        void cancel();
+
+    private:
+        Timer(Timer const&) = delete;
+        Timer& operator=(Timer const&) = delete;
+
+        std::shared_ptr<State> const state;
+        std::shared_ptr<Entry> const entry;
+    };
+
+private:
+    AlarmQueue(AlarmQueue const&) = delete;
+    AlarmQueue& operator=(AlarmQueue const&) = delete;
+
+    struct AlarmGSource;
+
+    std::shared_ptr<State> const state;
+    GSourceHandle gsource;
+};
 
 class FdSources
 {
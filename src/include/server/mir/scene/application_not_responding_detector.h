@@ -55,6 +55,17 @@ public:
     virtual void unregister_session(scene::Session const* session) = 0;
     virtual void pong_received(scene::Session const* received_for) = 0;
 
+    /**
+     * Notification that a session has shown signs of life other than a pong,
+     * such as submitting a buffer.
+     *
+     * A detector may use this to skip pinging sessions that are evidently
+     * running; it does not answer a ping that is already outstanding. This is
+     * called on hot paths, so implementations should not block. The default
+     * ignores it.
+     */
+    virtual void activity_received(scene::Session const* /*session*/) {}
+
     virtual void register_observer(std::shared_ptr<Observer> const& observer) = 0;
     virtual void unregister_observer(std::shared_ptr<Observer> const& observer) = 0;
 };
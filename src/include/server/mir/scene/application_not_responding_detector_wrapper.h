@@ -36,6 +36,7 @@ public:
     virtual void register_session(scene::Session const* session, std::function<void()> const& pinger) override;
     virtual void unregister_session(scene::Session const* session) override;
     virtual void pong_received(scene::Session const* received_for) override;
+    virtual void activity_received(scene::Session const* session) override;
     virtual void register_observer(std::shared_ptr<Observer> const& observer) override;
     virtual void unregister_observer(std::shared_ptr<Observer> const& observer) override;
 
@@ -482,6 +482,11 @@ public:
     void set_wayland_extension_filter(
         std::function<bool(std::shared_ptr<scene::Session> const&, char const*)> const& extension_filter);
 
+    /// Decide which Wayland clients get pointer motion coalesced (when enabled by
+    /// --coalesce-pointer-events). Latency-critical clients, such as games, can be excluded.
+    void set_wayland_pointer_coalescing_filter(
+        std::function<bool(std::shared_ptr<scene::Session> const&)> const& filter);
+
     /// Get the name of the Mir endpoint (if any) usable as a $MIR_SERVER value
     auto mir_socket_name() const -> optional_value<std::string>;
 
@@ -97,6 +97,8 @@ public:
 
     using WaylandProtocolExtensionFilter = std::function<bool(std::shared_ptr<scene::Session> const&, char const*)>;
     virtual void set_wayland_extension_filter(WaylandProtocolExtensionFilter const& extension_filter) = 0;
+    using WaylandPointerCoalescingFilter = std::function<bool(std::shared_ptr<scene::Session> const&)>;
+    virtual void set_wayland_pointer_coalescing_filter(WaylandPointerCoalescingFilter const& filter) = 0;
     virtual void set_enabled_wayland_extensions(std::vector<std::string> const& extensions) = 0;
 
 protected:
@@ -0,0 +1,129 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_TIME_TIMER_WHEEL_H_
+#define MIR_TIME_TIMER_WHEEL_H_
+
+#include "mir/time/types.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace mir
+{
+namespace time
+{
+/**
+ * A hierarchical timer wheel: O(1) schedule() and cancel() of timers that
+ * only need to fire to within a tick of their time.
+ *
+ * Timers are bucketed by tick into four levels of 64 slots; level 0 covers
+ * the next 64 ticks one tick per slot, and each level above covers 64 times
+ * the span of the one below. As time advances the slot of the next level up
+ * is "cascaded" into the levels below. Timers beyond the top level's span
+ * park in its furthest slot and are cascaded again until they come in range.
+ *
+ * Timers due in the same tick expire together, and expiry never runs early:
+ * a timer expires on the first tick that is at or after its time. A timer
+ * scheduled for a time that has already been processed expires on the next
+ * call to expire().
+ *
+ * The wheel does no locking, and doesn't own the timers scheduled on it.
+ */
+class TimerWheel
+{
+public:
+    /// Intrusive list node; embed (or derive from) one per timer
+    class Timer
+    {
+    public:
+        Timer() = default;
+        ~Timer() = default;
+
+        auto is_scheduled() const -> bool { return level >= 0; }
+        auto expiry() const -> Timestamp { return time; }
+
+    private:
+        friend class TimerWheel;
+        Timer(Timer const&) = delete;
+        Timer& operator=(Timer const&) = delete;
+
+        Timestamp time;
+        Timer* prev{nullptr};
+        Timer* next{nullptr};
+        int level{-1};
+        unsigned int index{0};
+    };
+
+    TimerWheel(Timestamp origin, Duration tick);
+
+    /// (Re)schedules \a timer for \a time; returns true if it was already scheduled
+    auto schedule(Timer& timer, Timestamp time) -> bool;
+
+    /// Removes \a timer if it is scheduled; returns true if it was
+    auto cancel(Timer& timer) -> bool;
+
+    /// Removes the timers due at or before \a now and appends them to \a expired
+    void expire(Timestamp now, std::vector<Timer*>& expired);
+
+    /**
+     * When expire() next needs to be called: the time of the first timer due
+     * or, if that is further off, when its slot is due to be cascaded.
+     * Timestamp::max() if nothing is scheduled.
+     */
+    auto next_deadline() const -> Timestamp;
+
+    auto empty() const -> bool { return scheduled == 0; }
+
+private:
+    TimerWheel(TimerWheel const&) = delete;
+    TimerWheel& operator=(TimerWheel const&) = delete;
+
+    static int const levels = 4;
+    static int const slot_bits = 6;
+    static uint64_t const slot_count = 1u << slot_bits;
+    static uint64_t const slot_mask = slot_count - 1;
+
+    struct Level
+    {
+        std::array<Timer*, slot_count> slots{};
+        uint64_t occupied{0};
+    };
+
+    auto tick_at_or_after(Timestamp time) const -> uint64_t;
+    auto time_of(uint64_t tick) const -> Timestamp;
+    auto next_event_tick() const -> uint64_t;
+
+    void insert(Timer& timer, uint64_t tick);
+    void unlink(Timer& timer);
+    auto head_of(Timer const& timer) -> Timer*&;
+    void cascade(int level);
+
+    Timestamp const origin;
+    Duration const tick;
+
+    /// The next tick to be processed by expire()
+    uint64_t current{0};
+    std::array<Level, levels> wheel;
+    /// Timers scheduled for a tick already processed
+    Timer* overdue{nullptr};
+    uint64_t scheduled{0};
+};
+}
+}
+
+#endif /* MIR_TIME_TIMER_WHEEL_H_ */
@@ -77,6 +77,7 @@ miral::BasicWindowManager::BasicWindowManager(
     policy_application_zone_addendum{WindowManagementPolicy::ApplicationZoneAddendum::from(policy.get())},
     display_config_monitor{std::make_shared<DisplayConfigurationListeners>()}
 {
+    update_window_index();
     display_config_monitor->add_listener(this);
     display_configuration_observers.register_interest(display_config_monitor);
 }
@@ -91,13 +92,15 @@ miral::BasicWindowManager::~BasicWindowManager()
 void miral::BasicWindowManager::add_session(std::shared_ptr<scene::Session> const& session)
 {
     Locker lock{this};
-    policy->advise_new_app(app_info[session] = ApplicationInfo(session));
+    if (app_info.find(session.get()) == app_info.end())
+        app_order.push_back(session.get());
+    policy->advise_new_app(app_info[session.get()] = ApplicationInfo(session));
 }
 
 void miral::BasicWindowManager::remove_session(std::shared_ptr<scene::Session> const& session)
 {
     Locker lock{this};
-    auto info = app_info.find(session);
+    auto info = app_info.find(session.get());
     if (info == app_info.end())
     {
         log_debug(
@@ -107,7 +110,8 @@ void miral::BasicWindowManager::remove_session(std::shared_ptr<scene::Session> c
         return;
     }
     policy->advise_delete_app(info->second);
-    app_info.erase(session);
+    app_info.erase(info);
+    app_order.erase(std::remove(begin(app_order), end(app_order), session.get()), end(app_order));
 }
 
 auto miral::BasicWindowManager::add_surface(
@@ -132,7 +136,8 @@ auto miral::BasicWindowManager::add_surface(
     spec.update(parameters);
     auto const surface = build(session, parameters);
     Window const window{session, surface};
-    auto& window_info = this->window_info.emplace(window, WindowInfo{window, spec}).first->second;
+    auto& window_info = this->window_info[surface.get()] = WindowInfo{window, spec};
+    update_window_index();
 
     if (spec.parent().is_set() && spec.parent().value().lock())
         window_info.parent(info_for(spec.parent().value()).window());
@@ -196,7 +201,7 @@ void miral::BasicWindowManager::remove_surface(
     std::weak_ptr<scene::Surface> const& surface)
 {
     Locker lock{this};
-    if (app_info.find(session) == app_info.end())
+    if (app_info.find(session.get()) == app_info.end())
     {
         log_debug(
             "BasicWindowManager::remove_surface() called with unknown or already removed session %s (PID: %d)",
@@ -318,7 +323,12 @@ void miral::BasicWindowManager::erase(miral::WindowInfo const& info)
     for (auto& child : info.children())
         info_for(child).parent({});
 
-    window_info.erase(info.window());
+    auto const i = find_window_info(info.window());
+    if (i != window_info.end())
+    {
+        window_info.erase(i);
+        update_window_index();
+    }
 }
 
 #pragma GCC diagnostic push
@@ -493,20 +503,21 @@ auto miral::BasicWindowManager::count_applications() const
 
 void miral::BasicWindowManager::for_each_application(std::function<void(ApplicationInfo& info)> const& functor)
 {
-    for(auto& info : app_info)
+    for (auto const session : app_order)
     {
-        functor(info.second);
+        functor(app_info.at(session));
     }
 }
 
 auto miral::BasicWindowManager::find_application(std::function<bool(ApplicationInfo const& info)> const& predicate)
 -> Application
 {
-    for(auto& info : app_info)
+    for (auto const session : app_order)
     {
-        if (predicate(info.second))
+        auto const& info = app_info.at(session);
+        if (predicate(info))
         {
-            return Application{info.first};
+            return info.application();
         }
     }
 
@@ -516,18 +527,31 @@ auto miral::BasicWindowManager::find_application(std::function<bool(ApplicationI
 auto miral::BasicWindowManager::info_for(std::weak_ptr<scene::Session> const& session) const
 -> ApplicationInfo&
 {
-    return const_cast<ApplicationInfo&>(app_info.at(session));
+    // ApplicationInfo holds the session, so it cannot expire while it has an entry
+    return const_cast<ApplicationInfo&>(app_info.at(session.lock().get()));
 }
 
 auto miral::BasicWindowManager::info_for(std::weak_ptr<scene::Surface> const& surface) const
 -> WindowInfo&
 {
-    return const_cast<WindowInfo&>(window_info.at(surface));
+    auto const info = find_window_info(surface);
+
+    if (info == window_info.end())
+        BOOST_THROW_EXCEPTION(std::out_of_range{"Unknown window"});
+
+    return const_cast<WindowInfo&>(info->second);
 }
 
 auto miral::BasicWindowManager::info_for(Window const& window) const
 -> WindowInfo&
 {
+    if (auto const surface = std::shared_ptr<scene::Surface>(window))
+    {
+        auto const info = window_info.find(surface.get());
+        if (info != window_info.end())
+            return const_cast<WindowInfo&>(info->second);
+    }
+
     return info_for(std::weak_ptr<mir::scene::Surface>(window));
 }
 
@@ -873,8 +897,13 @@ void miral::BasicWindowManager::focus_prev_within_application()
 auto miral::BasicWindowManager::window_at(geometry::Point cursor) const
 -> Window
 {
-    auto surface_at = focus_controller->surface_at(cursor);
-    return surface_at ? info_for(surface_at).window() : Window{};
+    auto const surface_at = focus_controller->surface_at(cursor);
+    if (!surface_at)
+        return {};
+
+    auto const index = std::atomic_load(&window_index);
+    auto const window = index->find(surface_at.get());
+    return window != index->end() ? window->second : Window{};
 }
 
 auto miral::BasicWindowManager::active_output() -> geometry::Rectangle const
@@ -1655,7 +1684,7 @@ auto miral::BasicWindowManager::surface_known(
     std::weak_ptr<scene::Surface> const& surface,
     std::string const& action) -> bool
 {
-    if (window_info.find(surface) != window_info.end())
+    if (find_window_info(surface) != window_info.end())
     {
         return true;
     }
@@ -1677,6 +1706,31 @@ auto miral::BasicWindowManager::surface_known(
     }
 }
 
+auto miral::BasicWindowManager::find_window_info(std::weak_ptr<scene::Surface> const& surface) const
+-> SurfaceInfoMap::const_iterator
+{
+    if (auto const shared = surface.lock())
+        return window_info.find(shared.get());
+
+    // The surface may have gone before we are told to remove it, so fall back to matching ownership
+    return std::find_if(begin(window_info), end(window_info), [&](SurfaceInfoMap::value_type const& info)
+        {
+            std::weak_ptr<scene::Surface> const known = info.second.window();
+            return !known.owner_before(surface) && !surface.owner_before(known);
+        });
+}
+
+void miral::BasicWindowManager::update_window_index()
+{
+    auto const index = std::make_shared<WindowIndex>();
+    index->reserve(window_info.size());
+
+    for (auto const& info : window_info)
+        index->emplace(info.first, info.second.window());
+
+    std::atomic_store(&window_index, std::shared_ptr<WindowIndex const>{index});
+}
+
 auto miral::BasicWindowManager::can_activate_window_for_session(miral::Application const& session) -> bool
 {
     miral::Window new_focus;
@@ -39,8 +39,8 @@
 #include <boost/bimap/multiset_of.hpp>
 #include <experimental/optional>
 
-#include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace mir
 {
@@ -178,6 +178,7 @@ public:
     void focus_next_within_application() override;
     void focus_prev_within_application() override;
 
+    /// Uses the published window_index, not window_info, so doesn't need the lock
     auto window_at(mir::geometry::Point cursor) const -> Window override;
 
     auto active_output() -> mir::geometry::Rectangle const override;
@@ -218,8 +219,9 @@ private:
         std::set<Window> attached_windows; ///< Maximized/anchored/etc windows attached to this area
     };
 
-    using SurfaceInfoMap = std::map<std::weak_ptr<mir::scene::Surface>, WindowInfo, std::owner_less<std::weak_ptr<mir::scene::Surface>>>;
-    using SessionInfoMap = std::map<std::weak_ptr<mir::scene::Session>, ApplicationInfo, std::owner_less<std::weak_ptr<mir::scene::Session>>>;
+    using SurfaceInfoMap = std::unordered_map<mir::scene::Surface const*, WindowInfo>;
+    using SessionInfoMap = std::unordered_map<mir::scene::Session const*, ApplicationInfo>;
+    using WindowIndex = std::unordered_map<mir::scene::Surface const*, Window>;
 
     mir::shell::FocusController* const focus_controller;
     std::shared_ptr<mir::shell::DisplayLayout> const display_layout;
@@ -239,7 +241,11 @@ private:
 
     std::mutex mutex;
     SessionInfoMap app_info;
+    std::vector<mir::scene::Session const*> app_order; ///< The keys of app_info, in the order sessions were added
     SurfaceInfoMap window_info;
+    /// A copy of the windows in window_info, republished as they come and go, so that window_at() doesn't need
+    /// the lock. Only accessed with std::atomic_load()/std::atomic_store().
+    std::shared_ptr<WindowIndex const> window_index;
     mir::geometry::Rectangles outputs;
     mir::geometry::Point cursor;
     uint64_t last_input_event_timestamp{0};
@@ -265,6 +271,8 @@ private:
     void update_event_timestamp(MirInputEvent const* iev);
 
     auto surface_known(std::weak_ptr<mir::scene::Surface> const& surface, std::string const& action) -> bool;
+    auto find_window_info(std::weak_ptr<mir::scene::Surface> const& surface) const -> SurfaceInfoMap::const_iterator;
+    void update_window_index();
 
     auto can_activate_window_for_session(miral::Application const& session) -> bool;
     auto can_activate_window_for_session_in_workspace(
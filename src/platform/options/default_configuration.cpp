@@ -38,21 +38,29 @@ char const* const mo::display_report_opt          = "display-report";
 char const* const mo::legacy_input_report_opt     = "legacy-input-report";
 char const* const mo::connector_report_opt        = "connector-report";
 char const* const mo::scene_report_opt            = "scene-report";
+char const* const mo::screencast_max_rate_opt     = "screencast-max-rate";
 char const* const mo::input_report_opt            = "input-report";
 char const* const mo::seat_report_opt            = "seat-report";
 char const* const mo::shared_library_prober_report_opt = "shared-library-prober-report";
 char const* const mo::shell_report_opt            = "shell-report";
 char const* const mo::name_opt                    = "name";
 char const* const mo::offscreen_opt               = "offscreen";
+char const* const mo::offscreen_frame_socket      = "offscreen-frame-socket";
 char const* const mo::touchspots_opt              = "enable-touchspots";
 char const* const mo::cursor_opt                  = "cursor";
+char const* const mo::renderer_opt                = "renderer";
+char const* const mo::gl_program_cache_opt        = "gl-program-cache";
+char const* const mo::gl_texture_atlas_opt        = "gl-texture-atlas";
+char const* const mo::gl_layer_cache_opt          = "gl-layer-cache";
 char const* const mo::fatal_except_opt            = "on-fatal-error-except";
 char const* const mo::debug_opt                   = "debug";
 char const* const mo::composite_delay_opt         = "composite-delay";
+char const* const mo::coalesce_pointer_events_opt = "coalesce-pointer-events";
 char const* const mo::enable_key_repeat_opt       = "enable-key-repeat";
 char const* const mo::x11_display_opt             = "enable-x11";
 char const* const mo::wayland_extensions_opt      = "wayland-extensions";
 char const* const mo::enable_mirclient_opt        = "enable-mirclient";
+char const* const mo::ipc_thread_pool_opt         = "ipc-thread-pool";
 
 char const* const mo::off_opt_value = "off";
 char const* const mo::log_opt_value = "log";
@@ -61,6 +69,7 @@ char const* const mo::lttng_opt_value = "lttng";
 char const* const mo::platform_graphics_lib = "platform-graphics-lib";
 char const* const mo::platform_input_lib = "platform-input-lib";
 char const* const mo::platform_path = "platform-path";
+char const* const mo::platform_probe_cache = "platform-probe-cache";
 
 char const* const mo::console_provider = "console-provider";
 char const* const mo::logind_console = "logind";
@@ -158,6 +167,10 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "Library to use for platform input support (default: input-stub.so)")
         (platform_path, po::value<std::string>()->default_value(MIR_SERVER_PLATFORM_PATH),
             "Directory to look for platform libraries (default: " MIR_SERVER_PLATFORM_PATH ")")
+        (platform_probe_cache, po::value<std::string>(),
+            "File in which to remember the graphics platform chosen by autodetection. "
+            "While the modules, DRM devices and host display are unchanged, that "
+            "platform is tried before probing the others (default: no cache)")
         (enable_input_opt, po::value<bool>()->default_value(enable_input_default),
             "Enable input.")
         (compositor_report_opt, po::value<std::string>()->default_value(off_opt_value),
@@ -187,15 +200,46 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "frames from clients before compositing). Higher values result in "
             "lower latency but risk causing frame skipping. "
             "Default: A negative value means decide automatically.")
+        (coalesce_pointer_events_opt, po::value<int>()->default_value(0),
+            "Hold back Wayland pointer motion and scroll events for up to this many "
+            "milliseconds and merge them, so that each client gets at most one pointer "
+            "frame per interval (e.g. 16 for 60Hz). Buttons, keys, touches and "
+            "enter/leave are never delayed. 0 disables coalescing.")
+        (screencast_max_rate_opt, po::value<int>()->default_value(0),
+            "Most frames per second a screencast session composites. Captures "
+            "requested sooner, or when nothing in the captured region has changed, "
+            "return the previous frame. 0 means no limit.")
         (name_opt, po::value<std::string>(),
             "When nested, the name Mir uses when registering with the host.")
         (offscreen_opt,
             "Render to offscreen buffers instead of the real outputs.")
+        (offscreen_frame_socket, po::value<std::string>(),
+            "With --offscreen, publish each composited frame on this Unix socket "
+            "for a local consumer (e.g. recording or CI). Frames are shared through "
+            "a small ring of memfd buffers, with timestamps and damage. Outputs after "
+            "the first use \"<socket>.<n>\".")
         (touchspots_opt,
             "Display visualization of touchspots (e.g. for screencasting).")
         (cursor_opt,
             po::value<std::string>()->default_value("auto"),
             "Cursor (mouse pointer) to use [{auto,null,software}]")
+        (renderer_opt,
+            po::value<std::string>()->default_value("auto"),
+            "Compositor renderer to use [{auto,gl,software}]. \"auto\" uses GL "
+            "where the output supports it and software rendering otherwise.")
+        (gl_program_cache_opt, po::value<std::string>(),
+            "Directory in which the GL renderer keeps its linked shader programs "
+            "(where the driver supports program binaries), so that later runs "
+            "need not compile them again. Programs are always shared between "
+            "outputs within a run (default: none)")
+        (gl_texture_atlas_opt, po::value<bool>()->default_value(false),
+            "Have the GL renderer copy small, rarely changing software (SHM) "
+            "surfaces such as cursors and decorations into a shared texture, and "
+            "draw runs of them in one call")
+        (gl_layer_cache_opt, po::value<bool>()->default_value(false),
+            "Have the GL renderer composite the surfaces at the bottom of the "
+            "stack that have stopped changing (e.g. wallpaper and panels) into an "
+            "offscreen copy, and draw that until one of them changes")
         (enable_key_repeat_opt, po::value<bool>()->default_value(true),
              "Enable server generated key repeat")
         (fatal_except_opt, "On \"fatal error\" conditions [e.g. drivers behaving "
@@ -203,6 +247,10 @@ mo::DefaultConfiguration::DefaultConfiguration(
         (debug_opt, "Enable extra development debugging. "
             "This is only interesting for people doing Mir server or client development.")
         (enable_mirclient_opt, "Enable deprecated mirclient socket (for running old clients)")
+        (ipc_thread_pool_opt, po::value<int>()->default_value(1),
+            "Number of threads serving mirclient IPC. Requests from each client are "
+            "always handled in order, but with more than one thread a slow request "
+            "from one client does not hold up the others. 0 means one per CPU.")
         (console_provider,
             po::value<std::string>()->default_value("auto"),
             "Console device handling\n"
@@ -257,6 +257,10 @@ try
             }
         }
 
+        // Handlers (and the compositor) may have queued requests, such as
+        // buffer attaches and pongs; send them before we sleep.
+        wl_display_flush(display);
+
         if (poll(fds, indices, -1) == -1)
         {
             wl_display_cancel_read(display);
@@ -18,11 +18,16 @@
 #include "displayclient.h"
 #include "mir/graphics/egl_error.h"
 #include <mir/graphics/pixel_format_utils.h>
+#include <mir/graphics/renderable.h>
+#include <mir/graphics/buffer.h>
+#include <mir/renderer/sw/pixel_source.h>
+#include <mir/fd.h>
 
 #include <wayland-client.h>
 #include <wayland-egl.h>
 
 #include <fcntl.h>
+#include <unistd.h>
 #include <sys/mman.h>
 #include <xkbcommon/xkbcommon.h>
 
@@ -32,8 +37,14 @@
 #include <stdlib.h>
 #include <system_error>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace mgw = mir::graphics::wayland;
+namespace mrs = mir::renderer::software;
 
 class mgw::DisplayClient::Output  :
     public DisplaySyncGroup,
@@ -110,6 +121,45 @@ public:
     void release_current() override;
     void swap_buffers() override;
     void bind() override;
+
+private:
+    /*
+     * A fullscreen software client is handed to the host on a subsurface of
+     * the output's surface, so the frame doesn't go through our GL
+     * compositing and EGL window.
+     */
+    struct PassthroughBuffer
+    {
+        PassthroughBuffer(wl_shm* shm, geometry::Size size, uint32_t format);
+        ~PassthroughBuffer();
+
+        static wl_buffer_listener const buffer_listener;
+
+        geometry::Size const size;
+        uint32_t const format;
+        size_t const stride;
+        size_t const bytes;
+        void* data;
+        wl_buffer* buffer;
+        std::atomic<bool> busy{false};
+    };
+
+    bool passthrough(Renderable const& renderable);
+    void hide_passthrough();
+    void cancel_passthrough_frame();
+
+    static wl_callback_listener const frame_listener;
+
+    bool has_swapped{false};
+    wl_surface* passthrough_surface{nullptr};
+    wl_subsurface* passthrough_subsurface{nullptr};
+    std::vector<std::unique_ptr<PassthroughBuffer>> passthrough_buffers;
+    bool passthrough_visible{false};
+
+    // Until the host calls back for the last passthrough frame post() holds the compositor
+    std::mutex frame_mutex;
+    std::condition_variable frame_cv;
+    wl_callback* frame_callback{nullptr};
 };
 
 namespace
@@ -243,6 +293,15 @@ mgw::DisplayClient::Output::Output(
 
 mgw::DisplayClient::Output::~Output()
 {
+    cancel_passthrough_frame();
+    passthrough_buffers.clear();
+
+    if (passthrough_subsurface)
+        wl_subsurface_destroy(passthrough_subsurface);
+
+    if (passthrough_surface)
+        wl_surface_destroy(passthrough_surface);
+
     if (output)
         wl_output_destroy(output);
 
@@ -284,7 +343,10 @@ void mgw::DisplayClient::Output::for_each_display_buffer(std::function<void(Disp
         window = wl_shell_get_shell_surface(owner->shell, surface);
         wl_shell_surface_add_listener(window, &shell_surface_listener, this);
         wl_shell_surface_set_fullscreen(window, WL_SHELL_SURFACE_FULLSCREEN_METHOD_SCALE, 0, output);
-        wl_display_dispatch(owner->display);
+
+        // Any response is handled by the Display's event thread; there's no
+        // need to block the compositor waiting for it.
+        wl_display_flush(owner->display);
 
         auto const& size = dcout.modes[dcout.current_mode_index].size;
 
@@ -299,6 +361,11 @@ void mgw::DisplayClient::Output::for_each_display_buffer(std::function<void(Disp
 
 void mgw::DisplayClient::Output::post()
 {
+    // Keep a client posting faster than the host from using up the passthrough buffers. (Composited
+    // frames are throttled by eglSwapBuffers() instead.) A host may withhold frame callbacks from a
+    // surface it isn't showing, so don't wait indefinitely.
+    std::unique_lock<std::mutex> lock{frame_mutex};
+    frame_cv.wait_for(lock, std::chrono::milliseconds{100}, [this] { return !frame_callback; });
 }
 
 auto mgw::DisplayClient::Output::recommended_sleep() const -> std::chrono::milliseconds
@@ -311,11 +378,199 @@ auto mgw::DisplayClient::Output::view_area() const -> geometry::Rectangle
     return dcout.extents();
 }
 
-bool mgw::DisplayClient::Output::overlay(mir::graphics::RenderableList const&)
+bool mgw::DisplayClient::Output::overlay(mir::graphics::RenderableList const& renderlist)
 {
+    if (renderlist.size() == 1 && passthrough(*renderlist.front()))
+        return true;
+
+    hide_passthrough();
     return false;
 }
 
+mgw::DisplayClient::Output::PassthroughBuffer::PassthroughBuffer(
+    wl_shm* shm,
+    geometry::Size size,
+    uint32_t format) :
+    size{size},
+    format{format},
+    stride{4 * size.width.as_uint32_t()},
+    bytes{stride * size.height.as_uint32_t()}
+{
+    // Like the cursor, create the shm file the way Wayland clients do
+    static auto const template_filename =
+        std::string{getenv("XDG_RUNTIME_DIR")} + "/wayland-passthrough-shared-XXXXXX";
+
+    auto const filename = strdup(template_filename.c_str());
+    mir::Fd const fd{mkostemp(filename, O_CLOEXEC)};
+    unlink(filename);
+    free(filename);
+
+    if (fd < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create shm buffer"}));
+
+    if (auto error = posix_fallocate(fd, 0, bytes))
+        BOOST_THROW_EXCEPTION((std::system_error{error, std::system_category(), "Failed to allocate shm buffer"}));
+
+    if ((data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to mmap shm buffer"}));
+
+    auto const pool = wl_shm_create_pool(shm, fd, bytes);
+    buffer = wl_shm_pool_create_buffer(
+        pool, 0, size.width.as_int(), size.height.as_int(), stride, format);
+    wl_shm_pool_destroy(pool);
+
+    wl_buffer_add_listener(buffer, &buffer_listener, this);
+}
+
+mgw::DisplayClient::Output::PassthroughBuffer::~PassthroughBuffer()
+{
+    wl_buffer_destroy(buffer);
+    munmap(data, bytes);
+}
+
+// Called on the Display's event thread
+wl_buffer_listener const mgw::DisplayClient::Output::PassthroughBuffer::buffer_listener = {
+    [](void* data, wl_buffer*) { static_cast<PassthroughBuffer*>(data)->busy = false; }
+};
+
+bool mgw::DisplayClient::Output::passthrough(Renderable const& renderable)
+{
+    // Until the output's surface has a buffer a subsurface of it won't be shown
+    if (!has_swapped || !owner->subcompositor || !owner->shm || dcout.scale != 1)
+        return false;
+
+    auto const buffer = renderable.buffer();
+    auto const size = buffer->size();
+
+    if (renderable.screen_position() != view_area() ||
+        size != view_area().size ||
+        renderable.clip_area() ||
+        renderable.alpha() < 1.0f ||
+        renderable.transformation() != glm::mat4{1})
+    {
+        return false;
+    }
+
+    uint32_t format;
+    switch (buffer->pixel_format())
+    {
+    case mir_pixel_format_argb_8888:
+        // Translucent content would be blended over what's beneath it on the host, not our background
+        if (renderable.shaped())
+            return false;
+        // ...and the renderer ignores the alpha of an unshaped renderable, so the host should too
+        format = WL_SHM_FORMAT_XRGB8888;
+        break;
+
+    case mir_pixel_format_xrgb_8888:
+        format = WL_SHM_FORMAT_XRGB8888;
+        break;
+
+    default:
+        return false;
+    }
+
+    auto const pixel_source = dynamic_cast<mrs::PixelSource*>(buffer->native_buffer_base());
+    if (!pixel_source)
+        return false;
+
+    // Outputs can change mode, and clients format; drop buffers that no longer fit
+    passthrough_buffers.erase(
+        std::remove_if(begin(passthrough_buffers), end(passthrough_buffers),
+            [&](auto const& b) { return !b->busy && (b->size != size || b->format != format); }),
+        end(passthrough_buffers));
+
+    auto free_buffer = std::find_if(begin(passthrough_buffers), end(passthrough_buffers),
+        [&](auto const& b) { return !b->busy && b->size == size && b->format == format; });
+
+    if (free_buffer == end(passthrough_buffers))
+    {
+        // Triple buffering is enough to keep up with the host; beyond that
+        // skip the frame, leaving the last one shown, rather than flipping
+        // between the subsurface and compositing.
+        if (passthrough_buffers.size() >= 3)
+            return passthrough_visible;
+
+        passthrough_buffers.push_back(std::make_unique<PassthroughBuffer>(owner->shm, size, format));
+        free_buffer = end(passthrough_buffers) - 1;
+    }
+
+    auto& target = **free_buffer;
+    auto const source_stride = pixel_source->stride().as_uint32_t();
+    pixel_source->read([&](unsigned char const* pixels)
+        {
+            auto dest = static_cast<unsigned char*>(target.data);
+            for (auto row = 0; row != size.height.as_int(); ++row)
+                memcpy(dest + row * target.stride, pixels + row * source_stride, target.stride);
+        });
+
+    if (!passthrough_surface)
+    {
+        passthrough_surface = wl_compositor_create_surface(owner->compositor);
+        passthrough_subsurface = wl_subcompositor_get_subsurface(owner->subcompositor, passthrough_surface, surface);
+        wl_subsurface_set_position(passthrough_subsurface, 0, 0);
+        wl_subsurface_set_desync(passthrough_subsurface);
+    }
+
+    target.busy = true;
+    wl_surface_attach(passthrough_surface, target.buffer, 0, 0);
+    wl_surface_damage(passthrough_surface, 0, 0, size.width.as_int(), size.height.as_int());
+    {
+        std::lock_guard<std::mutex> lock{frame_mutex};
+        if (frame_callback)
+            wl_callback_destroy(frame_callback);
+        frame_callback = wl_surface_frame(passthrough_surface);
+        wl_callback_add_listener(frame_callback, &frame_listener, this);
+    }
+    wl_surface_commit(passthrough_surface);
+
+    if (!passthrough_visible)
+    {
+        // The subsurface's position is parent state
+        wl_surface_commit(surface);
+        passthrough_visible = true;
+    }
+
+    wl_display_flush(owner->display);
+    return true;
+}
+
+void mgw::DisplayClient::Output::hide_passthrough()
+{
+    if (!passthrough_visible)
+        return;
+
+    // An unmapped surface gets no frame callbacks
+    cancel_passthrough_frame();
+
+    wl_surface_attach(passthrough_surface, nullptr, 0, 0);
+    wl_surface_commit(passthrough_surface);
+    passthrough_visible = false;
+}
+
+void mgw::DisplayClient::Output::cancel_passthrough_frame()
+{
+    std::lock_guard<std::mutex> lock{frame_mutex};
+    if (frame_callback)
+    {
+        wl_callback_destroy(frame_callback);
+        frame_callback = nullptr;
+        frame_cv.notify_all();
+    }
+}
+
+// Called on the Display's event thread
+wl_callback_listener const mgw::DisplayClient::Output::frame_listener = {
+    [](void* data, wl_callback* callback, uint32_t)
+    {
+        auto const self = static_cast<Output*>(data);
+        std::lock_guard<std::mutex> lock{self->frame_mutex};
+        wl_callback_destroy(callback);
+        self->frame_callback = nullptr;
+        self->frame_cv.notify_all();
+    }
+};
+
 auto mgw::DisplayClient::Output::transformation() const -> glm::mat2
 {
     return glm::mat2{1};
@@ -344,6 +599,8 @@ void mgw::DisplayClient::Output::swap_buffers()
 {
     if (eglSwapBuffers(owner->egldisplay, eglsurface) != EGL_TRUE)
         BOOST_THROW_EXCEPTION(egl_error("Failed to perform buffer swap"));
+
+    has_swapped = true;
 }
 
 void mgw::DisplayClient::Output::bind()
@@ -479,6 +736,11 @@ void mgw::DisplayClient::new_global(
                     [self](Output const& output) { self->on_new_output(&output); },
                     [self](Output const& output) { self->on_output_changed(&output); })));
     }
+    else if (strcmp(interface, "wl_subcompositor") == 0)
+    {
+        self->subcompositor =
+            static_cast<decltype(self->subcompositor)>(wl_registry_bind(registry, id, &wl_subcompositor_interface, 1));
+    }
     else if (strcmp(interface, "wl_shell") == 0)
     {
         self->shell = static_cast<decltype(self->shell)>(wl_registry_bind(registry, id, &wl_shell_interface, std::min(version, 1u)));
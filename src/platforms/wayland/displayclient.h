@@ -132,6 +132,7 @@ protected:
     wl_shell* shell = nullptr;
     wl_seat* seat = nullptr;
     wl_shm* shm = nullptr;
+    wl_subcompositor* subcompositor = nullptr;
 
     static void new_global(
         void* data,
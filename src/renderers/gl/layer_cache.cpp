@@ -0,0 +1,179 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "layer_cache.h"
+#include "mir/graphics/buffer.h"
+
+#include <algorithm>
+
+namespace mg = mir::graphics;
+namespace mrg = mir::renderer::gl;
+namespace geom = mir::geometry;
+
+namespace
+{
+/// How long a renderable must be left alone before it is worth caching
+int const frames_to_settle = 3;
+
+/// Drawing a single renderable from the cache would save nothing
+size_t const min_cached = 2;
+}
+
+mrg::LayerCache::LayerCache() = default;
+
+mrg::LayerCache::~LayerCache()
+{
+    release();
+}
+
+bool mrg::LayerCache::same(Layer const& a, Layer const& b)
+{
+    return a.id == b.id &&
+           a.buffer == b.buffer &&
+           a.position == b.position &&
+           a.clip_area == b.clip_area &&
+           a.alpha == b.alpha &&
+           a.transformation == b.transformation &&
+           a.shaped == b.shaped;
+}
+
+auto mrg::LayerCache::plan(mg::RenderableList const& renderables) -> Plan
+{
+    layers.clear();
+    for (auto const& r : renderables)
+    {
+        auto const buffer = r->buffer();
+        layers.push_back(Layer{
+            r->id(),
+            buffer ? buffer->id() : mg::BufferID{},
+            r->screen_position(),
+            r->clip_area(),
+            r->alpha(),
+            r->transformation(),
+            r->shaped()});
+
+        auto const& layer = layers.back();
+        auto const found = history.find(layer.id);
+        if (found == history.end())
+        {
+            history.emplace(layer.id, History{layer, 0, true});
+        }
+        else if (!same(found->second.layer, layer))
+        {
+            found->second = History{layer, 0, true};
+        }
+        else
+        {
+            found->second.unchanged_frames = std::min(found->second.unchanged_frames + 1, frames_to_settle);
+            found->second.used = true;
+        }
+    }
+
+    for (auto i = history.begin(); i != history.end();)
+    {
+        if (i->second.used)
+        {
+            i->second.used = false;
+            ++i;
+        }
+        else
+        {
+            i = history.erase(i);
+        }
+    }
+
+    size_t settled = 0;
+    while (settled != layers.size() &&
+           history.at(layers[settled].id).unchanged_frames >= frames_to_settle)
+    {
+        ++settled;
+    }
+
+    bool const still_valid =
+        valid &&
+        cached.size() <= layers.size() &&
+        std::equal(cached.begin(), cached.end(), layers.begin(), same);
+
+    if (still_valid && settled <= cached.size())
+        return Plan{cached.size(), false};
+
+    if (settled < min_cached)
+    {
+        cached.clear();
+        valid = false;
+        return Plan{0, false};
+    }
+
+    // Either something in the cache changed, or more of the stack has settled
+    cached.assign(layers.begin(), layers.begin() + settled);
+    valid = true;
+    return Plan{settled, true};
+}
+
+bool mrg::LayerCache::bind_for_redraw(geom::Size const& size)
+{
+    if (size != this->size || !framebuffer)
+    {
+        release();
+        this->size = size;
+
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size.width.as_int(), size.height.as_int(),
+                     0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            release();
+            cached.clear();
+            valid = false;
+            return false;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, size.width.as_int(), size.height.as_int());
+    return true;
+}
+
+void mrg::LayerCache::bind() const
+{
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void mrg::LayerCache::invalidate()
+{
+    cached.clear();
+    valid = false;
+}
+
+void mrg::LayerCache::release()
+{
+    if (framebuffer)
+        glDeleteFramebuffers(1, &framebuffer);
+    if (texture)
+        glDeleteTextures(1, &texture);
+    framebuffer = 0;
+    texture = 0;
+}
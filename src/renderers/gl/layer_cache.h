@@ -0,0 +1,117 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RENDERER_GL_LAYER_CACHE_H_
+#define MIR_RENDERER_GL_LAYER_CACHE_H_
+
+#include <mir/graphics/buffer_id.h>
+#include <mir/graphics/renderable.h>
+#include <mir/geometry/size.h>
+
+#include MIR_SERVER_GL_H
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace renderer
+{
+namespace gl
+{
+
+/**
+ * An offscreen copy of the bottom of the scene, for outputs where only the
+ * top of the stack changes (e.g. a video over a wallpaper and static panels).
+ *
+ * The renderables at the bottom of the list that have been left alone for a
+ * few frames are composited into a texture once, which is then drawn in their
+ * place until one of them changes buffer, moves, or is restacked. A change
+ * of buffer is the renderer's only sign of new content, so it stands for
+ * damage, as it does for the texture cache.
+ *
+ * \note bind_for_redraw() and bind() must be called with the renderer's GL context current
+ */
+class LayerCache
+{
+public:
+    LayerCache();
+    ~LayerCache();
+
+    LayerCache(LayerCache const&) = delete;
+    LayerCache& operator=(LayerCache const&) = delete;
+
+    struct Plan
+    {
+        /// How many renderables at the bottom of the list to draw from the cache
+        size_t cached;
+        /// Whether they must first be drawn into it
+        bool redraw;
+    };
+
+    /// Call once per frame, with everything that is about to be drawn
+    auto plan(graphics::RenderableList const& renderables) -> Plan;
+
+    /**
+     * Makes the cache the framebuffer to draw into, sized to match the
+     * output's viewport.
+     * \return false if the driver can't render to a texture
+     */
+    bool bind_for_redraw(geometry::Size const& size);
+
+    void bind() const;
+
+    /// The cache contents must be drawn again before use
+    void invalidate();
+
+private:
+    /// Everything about a renderable that shows in the composited result
+    struct Layer
+    {
+        graphics::Renderable::ID id;
+        graphics::BufferID buffer;
+        geometry::Rectangle position;
+        std::experimental::optional<geometry::Rectangle> clip_area;
+        float alpha;
+        glm::mat4 transformation;
+        bool shaped;
+    };
+
+    struct History
+    {
+        Layer layer;
+        int unchanged_frames;
+        bool used;
+    };
+
+    static bool same(Layer const& a, Layer const& b);
+
+    void release();
+
+    std::vector<Layer> layers;
+    std::vector<Layer> cached;
+    bool valid{false};
+    std::unordered_map<graphics::Renderable::ID, History> history;
+
+    geometry::Size size;
+    GLuint texture{0};
+    GLuint framebuffer{0};
+};
+
+}
+}
+}
+
+#endif // MIR_RENDERER_GL_LAYER_CACHE_H_
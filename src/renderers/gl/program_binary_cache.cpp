@@ -0,0 +1,330 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define MIR_LOG_COMPONENT "GLRenderer"
+
+#include "program_binary_cache.h"
+#include "mir/log.h"
+
+#include <EGL/egl.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mrg = mir::renderer::gl;
+
+namespace
+{
+// GL_OES_get_program_binary and GL_ARB_get_program_binary share these values
+GLenum const program_binary_length = 0x8741;
+GLenum const num_program_binary_formats = 0x87FE;
+GLenum const program_binary_retrievable_hint = 0x8257;
+
+char const file_magic[] = "mir-gl-program-binary 1\n";
+uint64_t const max_binary_size = 64 * 1024 * 1024;
+
+using GetProgramBinary = void (*)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+using ProgramBinary = void (*)(GLuint, GLenum, void const*, GLint);
+using ProgramParameteri = void (*)(GLuint, GLenum, GLint);
+
+struct Entrypoints
+{
+    Entrypoints(char const* get_binary_name, char const* binary_name, char const* parameteri_name) :
+        get_binary{reinterpret_cast<GetProgramBinary>(eglGetProcAddress(get_binary_name))},
+        binary{reinterpret_cast<ProgramBinary>(eglGetProcAddress(binary_name))},
+        parameteri{parameteri_name ?
+            reinterpret_cast<ProgramParameteri>(eglGetProcAddress(parameteri_name)) : nullptr}
+    {
+    }
+
+    GetProgramBinary const get_binary;
+    ProgramBinary const binary;
+    ProgramParameteri const parameteri;
+};
+
+/// What the current context can do with program binaries
+struct Driver
+{
+    Entrypoints const* entrypoints = nullptr;
+    std::string id;
+
+    explicit operator bool() const
+    {
+        return entrypoints && entrypoints->get_binary && entrypoints->binary;
+    }
+};
+
+auto gl_string(GLenum name) -> std::string
+{
+    auto const value = reinterpret_cast<char const*>(glGetString(name));
+    return value ? value : "";
+}
+
+bool has_extension(std::string const& extensions, char const* name)
+{
+    auto const length = strlen(name);
+    for (auto pos = extensions.find(name); pos != std::string::npos; pos = extensions.find(name, pos + 1))
+    {
+        if ((pos == 0 || extensions[pos - 1] == ' ') &&
+            (pos + length == extensions.size() || extensions[pos + length] == ' '))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto current_driver() -> Driver
+{
+    Driver driver;
+
+    auto const extensions = gl_string(GL_EXTENSIONS);
+    if (has_extension(extensions, "GL_OES_get_program_binary"))
+    {
+        static Entrypoints const oes{"glGetProgramBinaryOES", "glProgramBinaryOES", nullptr};
+        driver.entrypoints = &oes;
+    }
+    else if (has_extension(extensions, "GL_ARB_get_program_binary"))
+    {
+        static Entrypoints const arb{"glGetProgramBinary", "glProgramBinary", "glProgramParameteri"};
+        driver.entrypoints = &arb;
+    }
+    else
+    {
+        return driver;
+    }
+
+    // Some drivers advertise the extension but have no binary formats to offer
+    GLint formats = 0;
+    glGetIntegerv(num_program_binary_formats, &formats);
+    if (formats <= 0)
+    {
+        driver.entrypoints = nullptr;
+        return driver;
+    }
+
+    driver.id = gl_string(GL_VENDOR) + '\n' + gl_string(GL_RENDERER) + '\n' + gl_string(GL_VERSION);
+    return driver;
+}
+
+auto key_for(Driver const& driver, GLchar const* vertex_src, GLchar const* fragment_src) -> std::string
+{
+    std::string key{driver.id};
+    key += '\n';
+    key += vertex_src;
+    key += '\0';
+    key += fragment_src;
+    return key;
+}
+
+template<typename T>
+bool read_value(std::istream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof value));
+}
+
+template<typename T>
+void write_value(std::ostream& out, T const& value)
+{
+    out.write(reinterpret_cast<char const*>(&value), sizeof value);
+}
+}
+
+mrg::ProgramBinaryCache::ProgramBinaryCache(std::string const& directory) :
+    directory{directory}
+{
+    if (!directory.empty() && mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST)
+        mir::log_debug("Failed to create GL program cache %s", directory.c_str());
+}
+
+auto mrg::ProgramBinaryCache::find(std::string const& key) -> std::shared_ptr<Binary const>
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto const i = binaries.find(key);
+        if (i != binaries.end())
+            return i->second;
+    }
+
+    if (directory.empty())
+        return {};
+
+    auto const binary = read_file(key);
+    if (binary)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        binaries.emplace(key, binary);
+    }
+    return binary;
+}
+
+void mrg::ProgramBinaryCache::insert(std::string const& key, std::shared_ptr<Binary const> const& binary)
+{
+    bool inserted;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        inserted = binaries.emplace(key, binary).second;
+    }
+
+    // Only the first renderer to link a program writes it out
+    if (inserted && !directory.empty())
+        write_file(key, *binary);
+}
+
+void mrg::ProgramBinaryCache::erase(std::string const& key)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        binaries.erase(key);
+    }
+
+    if (!directory.empty())
+        std::remove(filename_for(key).c_str());
+}
+
+auto mrg::ProgramBinaryCache::load_program(GLchar const* vertex_src, GLchar const* fragment_src) -> GLuint
+{
+    auto const driver = current_driver();
+    if (!driver)
+        return 0;
+
+    auto const key = key_for(driver, vertex_src, fragment_src);
+    auto const binary = find(key);
+    if (!binary)
+        return 0;
+
+    GLuint const program = glCreateProgram();
+    if (!program)
+        return 0;
+
+    driver.entrypoints->binary(program, binary->format, binary->data.data(), binary->data.size());
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok)
+    {
+        // Typically a driver update that kept its version string
+        mir::log_debug("Cached GL program rejected by the driver; compiling it instead");
+        glDeleteProgram(program);
+        erase(key);
+        return 0;
+    }
+
+    return program;
+}
+
+void mrg::ProgramBinaryCache::prepare_to_link(GLuint program) const
+{
+    auto const driver = current_driver();
+    if (driver && driver.entrypoints->parameteri)
+        driver.entrypoints->parameteri(program, program_binary_retrievable_hint, GL_TRUE);
+}
+
+void mrg::ProgramBinaryCache::store_program(GLuint program, GLchar const* vertex_src, GLchar const* fragment_src)
+{
+    auto const driver = current_driver();
+    if (!driver)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, program_binary_length, &length);
+    if (length <= 0)
+        return;
+
+    auto const binary = std::make_shared<Binary>();
+    binary->data.resize(length);
+
+    GLsizei written = 0;
+    driver.entrypoints->get_binary(program, length, &written, &binary->format, binary->data.data());
+    if (written <= 0)
+        return;
+    binary->data.resize(written);
+
+    insert(key_for(driver, vertex_src, fragment_src), binary);
+}
+
+auto mrg::ProgramBinaryCache::filename_for(std::string const& key) const -> std::string
+{
+    std::ostringstream filename;
+    filename << directory << '/' << std::hex << std::hash<std::string>{}(key) << ".bin";
+    return filename.str();
+}
+
+auto mrg::ProgramBinaryCache::read_file(std::string const& key) const -> std::shared_ptr<Binary const>
+{
+    std::ifstream in{filename_for(key), std::ios::binary};
+
+    char magic[sizeof file_magic - 1];
+    uint64_t key_size;
+    if (!in.read(magic, sizeof magic) || memcmp(magic, file_magic, sizeof magic) != 0 ||
+        !read_value(in, key_size) || key_size != key.size())
+    {
+        return {};
+    }
+
+    // The file name is only a hash; make sure it really is our program
+    std::string stored_key(key_size, '\0');
+    if (!in.read(&stored_key[0], key_size) || stored_key != key)
+        return {};
+
+    auto const binary = std::make_shared<Binary>();
+    uint32_t format;
+    uint64_t size;
+    if (!read_value(in, format) || !read_value(in, size) || size == 0 || size > max_binary_size)
+        return {};
+
+    binary->format = format;
+    binary->data.resize(size);
+    if (!in.read(binary->data.data(), size))
+        return {};
+
+    return binary;
+}
+
+void mrg::ProgramBinaryCache::write_file(std::string const& key, Binary const& binary) const
+{
+    // Write and rename, so a concurrently starting server never sees half a file
+    auto const filename = filename_for(key);
+    auto const temporary = filename + ".new." + std::to_string(getpid());
+    {
+        std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+        out.write(file_magic, sizeof file_magic - 1);
+        write_value(out, uint64_t{key.size()});
+        out.write(key.data(), key.size());
+        write_value(out, uint32_t{binary.format});
+        write_value(out, uint64_t{binary.data.size()});
+        out.write(binary.data.data(), binary.data.size());
+        if (!out)
+        {
+            mir::log_debug("Failed to write GL program cache %s", temporary.c_str());
+            std::remove(temporary.c_str());
+            return;
+        }
+    }
+
+    if (rename(temporary.c_str(), filename.c_str()) != 0)
+    {
+        mir::log_debug("Failed to update GL program cache %s", filename.c_str());
+        std::remove(temporary.c_str());
+    }
+}
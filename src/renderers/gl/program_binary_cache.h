@@ -0,0 +1,87 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RENDERER_GL_PROGRAM_BINARY_CACHE_H_
+#define MIR_RENDERER_GL_PROGRAM_BINARY_CACHE_H_
+
+#include MIR_SERVER_GL_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace renderer
+{
+namespace gl
+{
+
+/**
+ * Linked GL programs, kept as driver binaries (GL_OES_get_program_binary or
+ * GL_ARB_get_program_binary) so that renderers created later, in this process
+ * or the next, can skip compiling and linking GLSL.
+ *
+ * Binaries are keyed on the driver (GL vendor, renderer and version strings)
+ * and the full shader sources. A binary the driver no longer accepts is
+ * dropped, and the caller compiles the program as it would without a cache.
+ */
+class ProgramBinaryCache
+{
+public:
+    /// \param directory where to keep binaries between runs; empty to keep them in memory only
+    explicit ProgramBinaryCache(std::string const& directory = {});
+
+    struct Binary
+    {
+        GLenum format;
+        std::vector<char> data;
+    };
+
+    auto find(std::string const& key) -> std::shared_ptr<Binary const>;
+    /// Does nothing if \a key is already cached
+    void insert(std::string const& key, std::shared_ptr<Binary const> const& binary);
+    void erase(std::string const& key);
+
+    // These must be called with a current GL context:
+
+    /// A linked program for the sources from a cached binary, or 0 if there is none
+    auto load_program(GLchar const* vertex_src, GLchar const* fragment_src) -> GLuint;
+
+    /// Call between glCreateProgram() and glLinkProgram() for programs that will be stored
+    void prepare_to_link(GLuint program) const;
+
+    /// Remember the binary of \a program, which was linked from the sources
+    void store_program(GLuint program, GLchar const* vertex_src, GLchar const* fragment_src);
+
+private:
+    auto filename_for(std::string const& key) const -> std::string;
+    auto read_file(std::string const& key) const -> std::shared_ptr<Binary const>;
+    void write_file(std::string const& key, Binary const& binary) const;
+
+    std::string const directory;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Binary const>> binaries;
+};
+
+}
+}
+}
+
+#endif // MIR_RENDERER_GL_PROGRAM_BINARY_CACHE_H_
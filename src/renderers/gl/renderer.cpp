@@ -19,6 +19,9 @@
 #define MIR_LOG_COMPONENT "GLRenderer"
 
 #include "renderer.h"
+#include "program_binary_cache.h"
+#include "texture_atlas.h"
+#include "layer_cache.h"
 #include "mir/compositor/buffer_stream.h"
 #include "mir/gl/default_program_factory.h"
 #include "mir/graphics/renderable.h"
@@ -40,6 +43,7 @@
 #include <EGL/egl.h>
 
 #include <boost/throw_exception.hpp>
+#include <algorithm>
 #include <stdexcept>
 #include <cmath>
 #include <sstream>
@@ -198,9 +202,8 @@ const GLchar* const vertex_shader_src =
 class mrg::Renderer::ProgramFactory : public mir::graphics::gl::ProgramFactory
 {
 public:
-    // NOTE: This must be called with a current GL context
-    ProgramFactory()
-        : vertex_shader{compile_shader(GL_VERTEX_SHADER, vertex_shader_src)}
+    ProgramFactory(std::shared_ptr<ProgramBinaryCache> const& program_cache)
+        : program_cache{program_cache}
     {
     }
 
@@ -247,20 +250,31 @@ public:
         // GL shader compilation is *not* threadsafe, and requires external synchronisation
         std::lock_guard<std::mutex> lock{compilation_mutex};
 
-        ShaderHandle const opaque_shader{
-            compile_shader(GL_FRAGMENT_SHADER, opaque_fragment.str().c_str())};
-        ShaderHandle const alpha_shader{
-            compile_shader(GL_FRAGMENT_SHADER, alpha_fragment.str().c_str())};
-
         return std::make_unique<::Program>(
-            link_shader(vertex_shader, opaque_shader),
-            link_shader(vertex_shader, alpha_shader));
-
-        // We delete opaque_shader and alpha_shader here. This is fine; it only marks them
-        // for deletion. GL will only delete them once the GL Program they're linked in is destroyed.
+            load_or_link(opaque_fragment.str()),
+            load_or_link(alpha_fragment.str()));
     }
 
 private:
+    // NOTE: This must be called with a current GL context
+    ProgramHandle load_or_link(std::string const& fragment_src)
+    {
+        if (auto const cached = program_cache->load_program(vertex_shader_src, fragment_src.c_str()))
+            return ProgramHandle{cached};
+
+        // Only compile the vertex shader once we find a program that isn't cached
+        if (!vertex_shader)
+            vertex_shader = std::make_unique<ShaderHandle>(compile_shader(GL_VERTEX_SHADER, vertex_shader_src));
+
+        ShaderHandle const fragment_shader{compile_shader(GL_FRAGMENT_SHADER, fragment_src.c_str())};
+        auto program = link_shader(*vertex_shader, fragment_shader, *program_cache);
+        program_cache->store_program(program, vertex_shader_src, fragment_src.c_str());
+        return program;
+
+        // We delete fragment_shader here. This is fine; it only marks it for deletion.
+        // GL will only delete it once the GL Program it's linked in is destroyed.
+    }
+
     static GLuint compile_shader(GLenum type, GLchar const* src)
     {
         GLuint id = glCreateShader(type);
@@ -288,11 +302,13 @@ private:
 
     static ProgramHandle link_shader(
         ShaderHandle const& vertex_shader,
-        ShaderHandle const& fragment_shader)
+        ShaderHandle const& fragment_shader,
+        ProgramBinaryCache const& program_cache)
     {
         ProgramHandle program{glCreateProgram()};
         glAttachShader(program, fragment_shader);
         glAttachShader(program, vertex_shader);
+        program_cache.prepare_to_link(program);
         glLinkProgram(program);
         GLint ok;
         glGetProgramiv(program, GL_LINK_STATUS, &ok);
@@ -309,7 +325,8 @@ private:
         return program;
     }
 
-    ShaderHandle const vertex_shader;
+    std::shared_ptr<ProgramBinaryCache> const program_cache;
+    std::unique_ptr<ShaderHandle> vertex_shader;
     // GL requires us to synchronise multi-threaded access to the shader APIs.
     std::mutex compilation_mutex;
 };
@@ -335,13 +352,26 @@ mrg::Renderer::Program::Program(GLuint program_id)
 }
 
 mrg::Renderer::Renderer(graphics::DisplayBuffer& display_buffer)
+    : Renderer(display_buffer, std::make_shared<ProgramBinaryCache>())
+{
+}
+
+mrg::Renderer::Renderer(
+    graphics::DisplayBuffer& display_buffer,
+    std::shared_ptr<ProgramBinaryCache> const& program_cache,
+    bool use_texture_atlas,
+    bool use_layer_cache)
     : render_target(&display_buffer),
+      program_cache{program_cache},
       clear_color{0.0f, 0.0f, 0.0f, 0.0f},
+      family{program_cache},
       default_program(family.add_program(vshader, default_fshader)),
       alpha_program(family.add_program(vshader, alpha_fshader)),
-      program_factory{std::make_unique<ProgramFactory>()},
+      program_factory{std::make_unique<ProgramFactory>(program_cache)},
       texture_cache(mgl::DefaultProgramFactory().create_texture_cache()),
-      display_transform(1)
+      display_transform(1),
+      use_texture_atlas{use_texture_atlas},
+      layer_cache{use_layer_cache ? std::make_unique<LayerCache>() : nullptr}
 {
     eglBindAPI(MIR_SERVER_EGL_OPENGL_API);
     EGLDisplay disp = eglGetCurrentDisplay();
@@ -409,16 +439,35 @@ void mrg::Renderer::tessellate(std::vector<mgl::Primitive>& primitives,
 
 void mrg::Renderer::render(mg::RenderableList const& renderables) const
 {
+    ++frameno;
+
+    if (use_texture_atlas && !texture_atlas)
+    {
+        GLint max_texture_size = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+        texture_atlas = std::make_unique<TextureAtlas>(std::min(1024, std::max(64, max_texture_size)));
+    }
+
+    auto const layers = layer_cache ? layer_cache->plan(renderables) : LayerCache::Plan{0, false};
+    auto const first_uncached = renderables.begin() + layers.cached;
+
+    if (layers.redraw)
+        redraw_layer_cache(renderables.begin(), first_uncached);
+
     render_target.bind();
 
     glClearColor(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    ++frameno;
-    for (auto const& r : renderables)
+    if (layer_cache && layers.cached)
     {
-        draw(*r);
+        draw_layer_cache();
+        draw_all(first_uncached, renderables.end());
+    }
+    else
+    {
+        draw_all(renderables.begin(), renderables.end());
     }
 
     render_target.swap_buffers();
@@ -426,11 +475,207 @@ void mrg::Renderer::render(mg::RenderableList const& renderables) const
     // Deleting unused textures only requires the GL context. This clean-up
     // does not affect screen contents so can happen after swap_buffers...
     texture_cache->drop_unused();
+    if (texture_atlas)
+        texture_atlas->drop_unused();
 
     while (auto const gl_error = glGetError())
         mir::log_debug("GL error: %d", gl_error);
 }
 
+void mrg::Renderer::draw_all(
+    mg::RenderableList::const_iterator first,
+    mg::RenderableList::const_iterator last) const
+{
+    // Consecutive renderables found in the atlas that blend the same way are
+    // drawn together, so the stacking order is kept
+    bool batch_shaped = false;
+    float batch_alpha = 1.0f;
+    for (auto i = first; i != last; ++i)
+    {
+        auto const& r = *i;
+        auto const region = texture_atlas ? texture_atlas->region_for(*r) : nullptr;
+
+        if (!atlas_batch.empty() &&
+            (!region || r->shaped() != batch_shaped || r->alpha() != batch_alpha))
+        {
+            draw_atlas_batch(batch_shaped, batch_alpha);
+        }
+
+        if (!region)
+        {
+            draw(*r);
+            continue;
+        }
+
+        batch_shaped = r->shaped();
+        batch_alpha = r->alpha();
+
+        auto const& rect = r->screen_position();
+        GLfloat const left = rect.top_left.x.as_int();
+        GLfloat const top = rect.top_left.y.as_int();
+        GLfloat const right = left + rect.size.width.as_int();
+        GLfloat const bottom = top + rect.size.height.as_int();
+
+        mgl::Vertex const quad[] =
+        {
+            {{left,  top,    0.0f}, {region->left,  region->top}},
+            {{left,  bottom, 0.0f}, {region->left,  region->bottom}},
+            {{right, top,    0.0f}, {region->right, region->top}},
+            {{right, top,    0.0f}, {region->right, region->top}},
+            {{left,  bottom, 0.0f}, {region->left,  region->bottom}},
+            {{right, bottom, 0.0f}, {region->right, region->bottom}},
+        };
+        atlas_batch.insert(atlas_batch.end(), std::begin(quad), std::end(quad));
+    }
+
+    if (!atlas_batch.empty())
+        draw_atlas_batch(batch_shaped, batch_alpha);
+}
+
+void mrg::Renderer::redraw_layer_cache(
+    mg::RenderableList::const_iterator first,
+    mg::RenderableList::const_iterator last) const
+{
+    render_target.bind();
+
+    // The cache stands in for the output's viewport, however it is letterboxed
+    GLint target_viewport[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_VIEWPORT, target_viewport);
+
+    if (!layer_cache->bind_for_redraw({target_viewport[2], target_viewport[3]}))
+    {
+        mir::log_warning("Offscreen rendering is not supported; disabling the layer cache");
+        layer_cache.reset();
+        return;
+    }
+
+    glClearColor(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    draw_all(first, last);
+
+    render_target.bind();
+    glViewport(target_viewport[0], target_viewport[1], target_viewport[2], target_viewport[3]);
+}
+
+void mrg::Renderer::draw_layer_cache() const
+{
+    auto const& prog = default_program;
+
+    use_program(prog);
+    glActiveTexture(GL_TEXTURE0);
+
+    // The cache already holds the result of the screen transformations, so
+    // cover the viewport in GL coordinates...
+    glm::mat4 const identity{1};
+    glUniformMatrix4fv(prog.display_transform_uniform, 1, GL_FALSE, glm::value_ptr(identity));
+    glUniformMatrix4fv(prog.screen_to_gl_coords_uniform, 1, GL_FALSE, glm::value_ptr(identity));
+    glUniformMatrix4fv(prog.transform_uniform, 1, GL_FALSE, glm::value_ptr(identity));
+    glUniform2f(prog.centre_uniform, 0.0f, 0.0f);
+    // ...and have them reloaded for the next renderable drawn with this program
+    prog.last_used_frameno = 0;
+
+    // It replaces what the bottom of the stack would have drawn over the clear colour
+    glDisable(GL_BLEND);
+    layer_cache->bind();
+
+    mgl::Vertex const quad[] =
+    {
+        {{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
+        {{ 1.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{ 1.0f,  1.0f, 0.0f}, {1.0f, 1.0f}},
+        {{-1.0f,  1.0f, 0.0f}, {0.0f, 1.0f}},
+    };
+
+    glEnableVertexAttribArray(prog.position_attr);
+    glEnableVertexAttribArray(prog.texcoord_attr);
+    glVertexAttribPointer(prog.position_attr, 3, GL_FLOAT,
+                          GL_FALSE, sizeof(mgl::Vertex),
+                          &quad[0].position);
+    glVertexAttribPointer(prog.texcoord_attr, 2, GL_FLOAT,
+                          GL_FALSE, sizeof(mgl::Vertex),
+                          &quad[0].texcoord);
+
+    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+
+    glDisableVertexAttribArray(prog.texcoord_attr);
+    glDisableVertexAttribArray(prog.position_attr);
+}
+
+void mrg::Renderer::use_program(Program const& prog) const
+{
+    glUseProgram(prog.id);
+    if (prog.last_used_frameno != frameno)
+    {   // Avoid reloading the screen-global uniforms on every renderable
+        // TODO: We actually only need to bind these *once*, right? Not once per frame?
+        prog.last_used_frameno = frameno;
+        for (auto i = 0u; i < prog.tex_uniforms.size(); ++i)
+        {
+            if (prog.tex_uniforms[i] != -1)
+            {
+                glUniform1i(prog.tex_uniforms[i], i);
+            }
+        }
+        glUniformMatrix4fv(prog.display_transform_uniform, 1, GL_FALSE,
+                           glm::value_ptr(display_transform));
+        glUniformMatrix4fv(prog.screen_to_gl_coords_uniform, 1, GL_FALSE,
+                           glm::value_ptr(screen_to_gl_coords));
+    }
+}
+
+void mrg::Renderer::draw_atlas_batch(bool shaped, float alpha) const
+{
+    auto const& prog = alpha < 1.0f ? alpha_program : default_program;
+
+    use_program(prog);
+    glActiveTexture(GL_TEXTURE0);
+
+    // The quads are already in screen coordinates
+    glUniform2f(prog.centre_uniform, 0.0f, 0.0f);
+    glm::mat4 const identity{1};
+    glUniformMatrix4fv(prog.transform_uniform, 1, GL_FALSE, glm::value_ptr(identity));
+    if (prog.alpha_uniform >= 0)
+        glUniform1f(prog.alpha_uniform, alpha);
+
+    // Blend as draw() would for each renderable
+    if (shaped)
+    {
+        glEnable(GL_BLEND);
+        glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA,
+                            GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else if (alpha == 1.0f)
+    {
+        glDisable(GL_BLEND);
+    }
+    else
+    {
+        glEnable(GL_BLEND);
+        glBlendColor(0.0f, 0.0f, 0.0f, alpha);
+        glBlendFuncSeparate(GL_ONE,  GL_ONE_MINUS_CONSTANT_ALPHA,
+                            GL_ZERO, GL_ONE);
+    }
+
+    texture_atlas->bind();
+
+    glEnableVertexAttribArray(prog.position_attr);
+    glEnableVertexAttribArray(prog.texcoord_attr);
+    glVertexAttribPointer(prog.position_attr, 3, GL_FLOAT,
+                          GL_FALSE, sizeof(mgl::Vertex),
+                          &atlas_batch[0].position);
+    glVertexAttribPointer(prog.texcoord_attr, 2, GL_FLOAT,
+                          GL_FALSE, sizeof(mgl::Vertex),
+                          &atlas_batch[0].texcoord);
+
+    glDrawArrays(GL_TRIANGLES, 0, atlas_batch.size());
+
+    glDisableVertexAttribArray(prog.texcoord_attr);
+    glDisableVertexAttribArray(prog.position_attr);
+
+    atlas_batch.clear();
+}
+
 void mrg::Renderer::draw(mg::Renderable const& renderable) const
 {
     auto const clip_area = renderable.clip_area();
@@ -498,23 +743,7 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
 
     auto const& prog = *maybe_prog;
 
-    glUseProgram(prog.id);
-    if (prog.last_used_frameno != frameno)
-    {   // Avoid reloading the screen-global uniforms on every renderable
-        // TODO: We actually only need to bind these *once*, right? Not once per frame?
-        prog.last_used_frameno = frameno;
-        for (auto i = 0u; i < prog.tex_uniforms.size(); ++i)
-        {
-            if (prog.tex_uniforms[i] != -1)
-            {
-                glUniform1i(prog.tex_uniforms[i], i);
-            }
-        }
-        glUniformMatrix4fv(prog.display_transform_uniform, 1, GL_FALSE,
-                           glm::value_ptr(display_transform));
-        glUniformMatrix4fv(prog.screen_to_gl_coords_uniform, 1, GL_FALSE,
-                           glm::value_ptr(screen_to_gl_coords));
-    }
+    use_program(prog);
 
     glActiveTexture(GL_TEXTURE0);
 
@@ -686,6 +915,10 @@ void mrg::Renderer::update_gl_viewport()
      */
     render_target.ensure_current();
 
+    // Everything cached was drawn for the old screen coordinates
+    if (layer_cache)
+        layer_cache->invalidate();
+
     auto transformed_viewport = display_transform *
                                 glm::vec4(viewport.size.width.as_int(),
                                           viewport.size.height.as_int(), 0, 1);
@@ -726,5 +959,9 @@ void mrg::Renderer::set_output_transform(glm::mat2 const& t)
 void mrg::Renderer::suspend()
 {
     texture_cache->invalidate();
+    if (texture_atlas)
+        texture_atlas->invalidate();
+    if (layer_cache)
+        layer_cache->invalidate();
 }
 
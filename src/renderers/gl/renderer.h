@@ -41,6 +41,9 @@ namespace renderer
 {
 namespace gl
 {
+class ProgramBinaryCache;
+class TextureAtlas;
+class LayerCache;
 
 class CurrentRenderTarget
 {
@@ -60,6 +63,17 @@ class Renderer : public renderer::Renderer
 {
 public:
     Renderer(graphics::DisplayBuffer& display_buffer);
+    /**
+     * \param program_cache      shares linked programs with the other renderers using it
+     * \param use_texture_atlas  draw small, rarely changing SHM renderables from a
+     *                           shared texture, in batches
+     * \param use_layer_cache    draw the unchanging bottom of the scene from an
+     *                           offscreen copy
+     */
+    Renderer(graphics::DisplayBuffer& display_buffer,
+             std::shared_ptr<ProgramBinaryCache> const& program_cache,
+             bool use_texture_atlas = false,
+             bool use_layer_cache = false);
     virtual ~Renderer();
 
     // These are called with a valid GL context:
@@ -91,6 +105,7 @@ public:
     };
 private:
     mutable CurrentRenderTarget render_target;
+    std::shared_ptr<ProgramBinaryCache> const program_cache;
 
 protected:
     /**
@@ -127,6 +142,13 @@ protected:
 
 private:
     void update_gl_viewport();
+    void use_program(Program const& prog) const;
+    void draw_atlas_batch(bool shaped, float alpha) const;
+    void draw_all(graphics::RenderableList::const_iterator first,
+                  graphics::RenderableList::const_iterator last) const;
+    void redraw_layer_cache(graphics::RenderableList::const_iterator first,
+                            graphics::RenderableList::const_iterator last) const;
+    void draw_layer_cache() const;
 
     class ProgramFactory;
     std::unique_ptr<ProgramFactory> const program_factory;
@@ -135,6 +157,10 @@ private:
     glm::mat4 screen_to_gl_coords;
     glm::mat4 display_transform;
     std::vector<mir::gl::Primitive> mutable primitives;
+    bool const use_texture_atlas;
+    std::unique_ptr<TextureAtlas> mutable texture_atlas;
+    std::vector<mir::gl::Vertex> mutable atlas_batch;
+    std::unique_ptr<LayerCache> mutable layer_cache;
 };
 
 }
@@ -18,13 +18,26 @@
 
 #include "renderer_factory.h"
 #include "renderer.h"
+#include "program_binary_cache.h"
 #include "mir/graphics/display_buffer.h"
 
 namespace mrg = mir::renderer::gl;
 
+mrg::RendererFactory::RendererFactory(
+    std::string const& program_cache_dir,
+    bool texture_atlas,
+    bool layer_cache)
+    : program_cache{std::make_shared<ProgramBinaryCache>(program_cache_dir)},
+      texture_atlas{texture_atlas},
+      layer_cache{layer_cache}
+{
+}
+
+mrg::RendererFactory::~RendererFactory() = default;
+
 std::unique_ptr<mir::renderer::Renderer>
 mrg::RendererFactory::create_renderer_for(
     graphics::DisplayBuffer& display_buffer)
 {
-    return std::make_unique<Renderer>(display_buffer);
+    return std::make_unique<Renderer>(display_buffer, program_cache, texture_atlas, layer_cache);
 }
@@ -21,18 +21,39 @@
 
 #include "mir/renderer/renderer_factory.h"
 
+#include <memory>
+#include <string>
+
 namespace mir
 {
 namespace renderer
 {
 namespace gl
 {
+class ProgramBinaryCache;
 
 class RendererFactory : public renderer::RendererFactory
 {
 public:
+    /**
+     * \param program_cache_dir  where to keep linked GL programs between runs (empty for none)
+     * \param texture_atlas      whether renderers draw small SHM renderables from a texture atlas
+     * \param layer_cache        whether renderers draw the unchanging bottom of the scene from
+     *                           an offscreen copy
+     */
+    explicit RendererFactory(
+        std::string const& program_cache_dir = {},
+        bool texture_atlas = false,
+        bool layer_cache = false);
+    ~RendererFactory();
+
     std::unique_ptr<renderer::Renderer> create_renderer_for(
         graphics::DisplayBuffer& display_buffer) override;
+
+private:
+    std::shared_ptr<ProgramBinaryCache> const program_cache;
+    bool const texture_atlas;
+    bool const layer_cache;
 };
 
 }
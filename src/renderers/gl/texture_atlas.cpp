@@ -0,0 +1,291 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "texture_atlas.h"
+#include "mir/graphics/buffer.h"
+#include "mir/renderer/sw/pixel_source.h"
+
+#include <algorithm>
+
+namespace mg = mir::graphics;
+namespace mrg = mir::renderer::gl;
+namespace mrs = mir::renderer::software;
+namespace geom = mir::geometry;
+
+namespace
+{
+/// Around each slot, holding copies of its edge pixels so that linear filtering doesn't reach into a neighbour
+int const padding = 1;
+
+/// A change this soon after the last one suggests the content is animating
+long long const min_frames_between_changes = 8;
+
+bool is_32bpp_rgb(MirPixelFormat format)
+{
+    switch (format)
+    {
+    case mir_pixel_format_abgr_8888:
+    case mir_pixel_format_xbgr_8888:
+    case mir_pixel_format_argb_8888:
+    case mir_pixel_format_xrgb_8888:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Whether red is the lowest addressed byte (true) or blue is (false)
+bool red_first(MirPixelFormat format)
+{
+    return format == mir_pixel_format_abgr_8888 || format == mir_pixel_format_xbgr_8888;
+}
+
+bool has_alpha(MirPixelFormat format)
+{
+    return format == mir_pixel_format_abgr_8888 || format == mir_pixel_format_argb_8888;
+}
+}
+
+mrg::TextureAtlas::TextureAtlas(int size)
+    : size{size}
+{
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+}
+
+mrg::TextureAtlas::~TextureAtlas()
+{
+    glDeleteTextures(1, &texture);
+}
+
+bool mrg::TextureAtlas::accepts(mg::Renderable const& renderable) const
+{
+    auto const buffer = renderable.buffer();
+    if (!buffer ||
+        !is_32bpp_rgb(buffer->pixel_format()) ||
+        !dynamic_cast<mrs::PixelSource*>(buffer->native_buffer_base()))
+    {
+        return false;
+    }
+
+    auto const buffer_size = buffer->size();
+    auto const width = buffer_size.width.as_int();
+    auto const height = buffer_size.height.as_int();
+    if (width <= 0 || height <= 0 || width > size / 2 || height > size / 2 ||
+        width * height > size * size / 16)
+    {
+        return false;
+    }
+
+    // Batches are drawn without a per-renderable transformation or scissor
+    return renderable.screen_position().size == buffer_size &&
+           !renderable.clip_area() &&
+           renderable.transformation() == glm::mat4(1);
+}
+
+auto mrg::TextureAtlas::region_for(mg::Renderable const& renderable) -> Region const*
+{
+    if (!accepts(renderable))
+        return nullptr;
+
+    auto const buffer = renderable.buffer();
+    auto const buffer_id = buffer->id();
+    auto const inserted = entries.emplace(renderable.id(), Entry{});
+    auto& entry = inserted.first->second;
+    entry.used = true;
+
+    if (entry.has_buffer && entry.buffer == buffer_id)
+    {
+        if (entry.uploaded)
+            return &entry.region;
+
+        // It arrived while the content was changing; copy it in once it has been left alone for a while
+        if (frameno - entry.buffer_frameno < min_frames_between_changes)
+            return nullptr;
+    }
+    else
+    {
+        bool const settled = !entry.has_buffer || frameno - entry.buffer_frameno >= min_frames_between_changes;
+        entry.has_buffer = true;
+        entry.buffer = buffer_id;
+        entry.buffer_frameno = frameno;
+        entry.uploaded = false;
+
+        if (!settled)
+            return nullptr;
+    }
+
+    auto const buffer_size = buffer->size();
+    if (entry.has_slot &&
+        (entry.slot.width < buffer_size.width.as_int() || entry.slot.height < buffer_size.height.as_int()))
+    {
+        entry.has_slot = false;
+        has_waste = true;
+    }
+
+    if (!entry.has_slot && !(entry.has_slot = allocate(buffer_size, entry.slot)))
+        return nullptr;
+
+    upload(*buffer, entry);
+    return &entry.region;
+}
+
+void mrg::TextureAtlas::bind() const
+{
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void mrg::TextureAtlas::drop_unused()
+{
+    ++frameno;
+
+    for (auto i = entries.begin(); i != entries.end();)
+    {
+        if (i->second.used)
+        {
+            i->second.used = false;
+            ++i;
+        }
+        else
+        {
+            has_waste = has_waste || i->second.has_slot;
+            i = entries.erase(i);
+        }
+    }
+
+    if (full && has_waste)
+    {
+        // Start again; renderables still in use are uploaded next time they're drawn
+        shelves.clear();
+        shelves_height = 0;
+        full = false;
+        has_waste = false;
+
+        for (auto& e : entries)
+        {
+            e.second.has_slot = false;
+            e.second.uploaded = false;
+            e.second.has_buffer = false;
+        }
+    }
+}
+
+void mrg::TextureAtlas::invalidate()
+{
+    for (auto& e : entries)
+    {
+        e.second.uploaded = false;
+        e.second.has_buffer = false;
+    }
+}
+
+bool mrg::TextureAtlas::allocate(geom::Size const& buffer_size, Slot& slot)
+{
+    int const width = buffer_size.width.as_int() + 2 * padding;
+    int const height = buffer_size.height.as_int() + 2 * padding;
+
+    // The lowest shelf with room, so that tall shelves are left for tall renderables
+    Shelf* best = nullptr;
+    for (auto& shelf : shelves)
+    {
+        if (shelf.height >= height && shelf.used_width + width <= size &&
+            (!best || shelf.height < best->height))
+        {
+            best = &shelf;
+        }
+    }
+
+    if (!best)
+    {
+        if (shelves_height + height > size)
+        {
+            full = true;
+            return false;
+        }
+
+        shelves.push_back(Shelf{shelves_height, height, 0});
+        shelves_height += height;
+        best = &shelves.back();
+    }
+
+    slot = Slot{best->used_width + padding, best->y + padding, width - 2 * padding, height - 2 * padding};
+    best->used_width += width;
+    return true;
+}
+
+void mrg::TextureAtlas::upload(mg::Buffer& buffer, Entry& entry)
+{
+    auto const source = dynamic_cast<mrs::PixelSource*>(buffer.native_buffer_base());
+    auto const format = buffer.pixel_format();
+    auto const width = buffer.size().width.as_int();
+    auto const height = buffer.size().height.as_int();
+    auto const stride = source->stride().as_int();
+    bool const swap_red_blue = !red_first(format);
+    bool const force_opaque = !has_alpha(format);
+
+    int const padded_width = width + 2 * padding;
+    int const padded_height = height + 2 * padding;
+
+    // The atlas holds RGBA, whatever order the renderables' pixels come in
+    staging.resize(padded_width * padded_height);
+    source->read(
+        [&](unsigned char const* pixels)
+        {
+            for (int y = 0; y != height; ++y)
+            {
+                auto const row = reinterpret_cast<uint32_t const*>(pixels + y * stride);
+                auto const dest = staging.data() + (y + padding) * padded_width + padding;
+                for (int x = 0; x != width; ++x)
+                {
+                    uint32_t pixel = row[x];
+                    if (swap_red_blue)
+                        pixel = (pixel & 0xff00ff00) | ((pixel >> 16) & 0xff) | ((pixel & 0xff) << 16);
+                    if (force_opaque)
+                        pixel |= 0xff000000;
+                    dest[x] = pixel;
+                }
+
+                // Extend the edges into the padding, so filtering at them sees the renderable's own pixels
+                std::fill(dest - padding, dest, dest[0]);
+                std::fill(dest + width, dest + width + padding, dest[width - 1]);
+            }
+        });
+
+    auto const first_row = staging.begin() + padding * padded_width;
+    auto const last_row = staging.begin() + (padding + height - 1) * padded_width;
+    for (int y = 0; y != padding; ++y)
+    {
+        std::copy(first_row, first_row + padded_width, staging.begin() + y * padded_width);
+        std::copy(last_row, last_row + padded_width, last_row + (y + 1) * padded_width);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexSubImage2D(
+        GL_TEXTURE_2D, 0,
+        entry.slot.x - padding, entry.slot.y - padding, padded_width, padded_height,
+        GL_RGBA, GL_UNSIGNED_BYTE, staging.data());
+
+    GLfloat const scale = 1.0f / size;
+    entry.region = Region{
+        entry.slot.x * scale, entry.slot.y * scale,
+        (entry.slot.x + width) * scale, (entry.slot.y + height) * scale};
+    entry.uploaded = true;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RENDERER_GL_TEXTURE_ATLAS_H_
+#define MIR_RENDERER_GL_TEXTURE_ATLAS_H_
+
+#include <mir/graphics/buffer_id.h>
+#include <mir/graphics/renderable.h>
+#include <mir/geometry/size.h>
+
+#include MIR_SERVER_GL_H
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace renderer
+{
+namespace gl
+{
+
+/**
+ * One texture shared by small, rarely changing SHM renderables (cursors,
+ * touchspots, decorations, small popups...), so that the renderer can draw a
+ * run of them with a single bind and draw call.
+ *
+ * A renderable's pixels are copied in when it first appears and whenever its
+ * buffer changes. A buffer that arrives only a few frames after the last one
+ * is drawn from its own texture instead, and copied in once it has been shown
+ * for a few frames unchanged; content that changes every frame never is. The
+ * buffer is held while it is shown, so it can still be read then.
+ *
+ * Renderables are packed onto shelves. Space left by renderables that have
+ * gone is reclaimed by repacking, once the atlas has filled up.
+ *
+ * \note Everything here must be called with the renderer's GL context current
+ */
+class TextureAtlas
+{
+public:
+    explicit TextureAtlas(int size);
+    ~TextureAtlas();
+
+    TextureAtlas(TextureAtlas const&) = delete;
+    TextureAtlas& operator=(TextureAtlas const&) = delete;
+
+    /// Texture coordinates of a renderable's pixels in the atlas
+    struct Region
+    {
+        GLfloat left, top, right, bottom;
+    };
+
+    /**
+     * Where \a renderable's current pixels are in the atlas, uploading them
+     * first if need be.
+     * \return nullptr if \a renderable should be drawn from its own texture
+     */
+    auto region_for(graphics::Renderable const& renderable) -> Region const*;
+
+    void bind() const;
+
+    /// Call after each frame: forgets renderables that weren't drawn
+    void drop_unused();
+    /// The atlas contents must be uploaded again before use
+    void invalidate();
+
+private:
+    struct Slot
+    {
+        int x, y, width, height;
+    };
+
+    struct Shelf
+    {
+        int y, height, used_width;
+    };
+
+    struct Entry
+    {
+        bool has_buffer{false};
+        graphics::BufferID buffer;
+        long long buffer_frameno{0};
+        bool uploaded{false};
+        bool has_slot{false};
+        Slot slot;
+        Region region;
+        bool used{true};
+    };
+
+    bool accepts(graphics::Renderable const& renderable) const;
+    bool allocate(geometry::Size const& size, Slot& slot);
+    void upload(graphics::Buffer& buffer, Entry& entry);
+
+    int const size;
+    GLuint texture{0};
+
+    std::vector<Shelf> shelves;
+    int shelves_height{0};
+    bool full{false};
+    bool has_waste{false};
+    long long frameno{0};
+
+    std::unordered_map<graphics::Renderable::ID, Entry> entries;
+    std::vector<uint32_t> staging;
+};
+
+}
+}
+}
+
+#endif // MIR_RENDERER_GL_TEXTURE_ATLAS_H_
@@ -0,0 +1,173 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pixel_ops.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace mrs = mir::renderer::software;
+
+namespace
+{
+uint32_t const alpha_mask = 0xff000000u;
+
+/// x*y/255, rounded, for x, y in [0, 255]
+inline uint32_t mul_div255(uint32_t x, uint32_t y)
+{
+    uint32_t const t = x * y + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+inline uint32_t swap_red_blue(uint32_t p)
+{
+    return (p & 0xff00ff00u) | ((p >> 16) & 0xffu) | ((p & 0xffu) << 16);
+}
+
+inline uint32_t blend_pixel(uint32_t d, uint32_t s, uint32_t alpha)
+{
+    uint32_t const s_alpha = mul_div255(s >> 24, alpha);
+    uint32_t const d_weight = 255 - s_alpha;
+    uint32_t result = 0;
+
+    for (int shift = 0; shift != 32; shift += 8)
+    {
+        uint32_t const c = mul_div255((s >> shift) & 0xff, alpha) +
+                           mul_div255((d >> shift) & 0xff, d_weight);
+        result |= (c > 255 ? 255 : c) << shift;
+    }
+
+    return result;
+}
+
+#ifdef __SSE2__
+/// Per 16-bit lane x*y/255, rounded, for lanes in [0, 255]
+inline __m128i mul_div255(__m128i x, __m128i y)
+{
+    __m128i const t = _mm_add_epi16(_mm_mullo_epi16(x, y), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+inline __m128i broadcast_alpha(__m128i pixels16)
+{
+    return _mm_shufflehi_epi16(
+        _mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)),
+        _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+/// Blends two pixels unpacked to 16 bits per channel
+inline __m128i blend_pixels16(__m128i d, __m128i s, __m128i alpha)
+{
+    __m128i const s_scaled = mul_div255(s, alpha);
+    __m128i const d_weight = _mm_sub_epi16(_mm_set1_epi16(255), broadcast_alpha(s_scaled));
+    return _mm_add_epi16(s_scaled, mul_div255(d, d_weight));
+}
+#endif
+}
+
+void mrs::convert_row(uint32_t* pixels, size_t count, bool swap, bool force_opaque)
+{
+    if (!swap && !force_opaque)
+        return;
+
+    uint32_t const opaque = force_opaque ? alpha_mask : 0;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    if (swap)
+    {
+        __m128i const ag_mask = _mm_set1_epi32(0xff00ff00);
+        __m128i const low_mask = _mm_set1_epi32(0xff);
+        __m128i const opaque4 = _mm_set1_epi32(opaque);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            auto const p = reinterpret_cast<__m128i*>(pixels + i);
+            __m128i const v = _mm_loadu_si128(p);
+            __m128i const r = _mm_and_si128(_mm_srli_epi32(v, 16), low_mask);
+            __m128i const b = _mm_slli_epi32(_mm_and_si128(v, low_mask), 16);
+            _mm_storeu_si128(
+                p,
+                _mm_or_si128(_mm_or_si128(_mm_and_si128(v, ag_mask), opaque4), _mm_or_si128(r, b)));
+        }
+    }
+    else
+    {
+        __m128i const opaque4 = _mm_set1_epi32(opaque);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            auto const p = reinterpret_cast<__m128i*>(pixels + i);
+            _mm_storeu_si128(p, _mm_or_si128(_mm_loadu_si128(p), opaque4));
+        }
+    }
+#endif
+
+    for (; i != count; ++i)
+        pixels[i] = (swap ? swap_red_blue(pixels[i]) : pixels[i]) | opaque;
+}
+
+void mrs::gather_row(uint32_t* dest, uint32_t const* src, int const* columns, size_t count)
+{
+    for (size_t i = 0; i != count; ++i)
+        dest[i] = src[columns[i]];
+}
+
+void mrs::blend_row(uint32_t* dest, uint32_t const* src, size_t count, uint8_t alpha)
+{
+    size_t i = 0;
+
+#ifdef __SSE2__
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const alpha16 = _mm_set1_epi16(alpha);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i const s = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+        int const opaque_lanes =
+            _mm_movemask_epi8(_mm_cmpeq_epi32(
+                _mm_and_si128(s, _mm_set1_epi32(alpha_mask)), _mm_set1_epi32(alpha_mask)));
+
+        auto const d_ptr = reinterpret_cast<__m128i*>(dest + i);
+
+        if (alpha == 255 && opaque_lanes == 0xffff)
+        {
+            _mm_storeu_si128(d_ptr, s);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(s, zero)) == 0xffff)
+            continue;
+
+        __m128i const d = _mm_loadu_si128(d_ptr);
+        __m128i const lo = blend_pixels16(
+            _mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero), alpha16);
+        __m128i const hi = blend_pixels16(
+            _mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero), alpha16);
+        _mm_storeu_si128(d_ptr, _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    for (; i != count; ++i)
+    {
+        uint32_t const s = src[i];
+
+        if (alpha == 255 && (s & alpha_mask) == alpha_mask)
+            dest[i] = s;
+        else if (s != 0)
+            dest[i] = blend_pixel(dest[i], s, alpha);
+    }
+}
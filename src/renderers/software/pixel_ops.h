@@ -0,0 +1,48 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RENDERER_SOFTWARE_PIXEL_OPS_H_
+#define MIR_RENDERER_SOFTWARE_PIXEL_OPS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mir
+{
+namespace renderer
+{
+namespace software
+{
+/*
+ * Row kernels for 32bpp pixels with alpha (or padding) in the most
+ * significant byte. Colour channels are premultiplied, as for the GL
+ * renderer. SSE2 is used where the compiler targets it.
+ */
+
+/// Swaps the red and blue channels and/or sets alpha to opaque, in place.
+void convert_row(uint32_t* pixels, size_t count, bool swap_red_blue, bool force_opaque);
+
+/// dest[i] = src[columns[i]]
+void gather_row(uint32_t* dest, uint32_t const* src, int const* columns, size_t count);
+
+/// Premultiplied "over": dest = src*alpha + dest*(1 - src.alpha*alpha), with alpha in [0, 255]
+void blend_row(uint32_t* dest, uint32_t const* src, size_t count, uint8_t alpha);
+
+}
+}
+}
+
+#endif /* MIR_RENDERER_SOFTWARE_PIXEL_OPS_H_ */
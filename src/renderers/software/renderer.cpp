@@ -0,0 +1,513 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define MIR_LOG_COMPONENT "SoftwareRenderer"
+
+#include "renderer.h"
+#include "pixel_ops.h"
+#include "mir/renderer/sw/render_target.h"
+#include "mir/renderer/sw/pixel_source.h"
+#include "mir/graphics/buffer.h"
+#include "mir/graphics/display_buffer.h"
+#include "mir/log.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace mg = mir::graphics;
+namespace mrs = mir::renderer::software;
+namespace geom = mir::geometry;
+
+struct mrs::Renderer::Draw
+{
+    enum class Sampling
+    {
+        direct,   ///< texels map 1:1 onto target pixels
+        columns,  ///< axis-aligned scaling and/or flipping
+        general   ///< anything else (rotation, shear)
+    };
+
+    std::shared_ptr<mg::Buffer> buffer;
+    PixelSource* source;
+    int source_width;
+    int source_height;
+    Mapping to_source;      ///< target pixel centre to texel
+    geom::Rectangle bounds; ///< target pixels touched
+    Sampling sampling;
+    bool swap_red_blue;
+    bool force_opaque;
+    uint8_t alpha;
+    bool opaque;            ///< replaces everything within bounds
+};
+
+namespace
+{
+uint32_t const transparent_black = 0;
+
+bool is_32bpp_rgb(MirPixelFormat format)
+{
+    switch (format)
+    {
+    case mir_pixel_format_abgr_8888:
+    case mir_pixel_format_xbgr_8888:
+    case mir_pixel_format_argb_8888:
+    case mir_pixel_format_xrgb_8888:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Whether red is the lowest addressed byte (true) or blue is (false)
+bool red_first(MirPixelFormat format)
+{
+    return format == mir_pixel_format_abgr_8888 || format == mir_pixel_format_xbgr_8888;
+}
+
+bool has_alpha(MirPixelFormat format)
+{
+    return format == mir_pixel_format_abgr_8888 || format == mir_pixel_format_argb_8888;
+}
+
+mrs::RenderTarget* render_target_for(mg::DisplayBuffer& display_buffer)
+{
+    auto const target = dynamic_cast<mrs::RenderTarget*>(display_buffer.native_display_buffer());
+
+    if (!target)
+        BOOST_THROW_EXCEPTION(std::logic_error("DisplayBuffer does not support software rendering"));
+
+    if (!is_32bpp_rgb(target->pixel_format()))
+        BOOST_THROW_EXCEPTION(std::logic_error("Software rendering requires a 32bpp RGB display buffer"));
+
+    return target;
+}
+
+using Mapping = mrs::Renderer::Mapping;
+
+/// a ∘ b
+Mapping compose(Mapping const& a, Mapping const& b)
+{
+    Mapping result;
+    for (int i = 0; i != 2; ++i)
+    {
+        for (int j = 0; j != 2; ++j)
+            result.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j];
+
+        result.offset[i] = a.m[i][0] * b.offset[0] + a.m[i][1] * b.offset[1] + a.offset[i];
+    }
+    return result;
+}
+
+bool invert(Mapping const& a, Mapping& inverse)
+{
+    float const det = a.m[0][0] * a.m[1][1] - a.m[0][1] * a.m[1][0];
+    if (std::fabs(det) < 1e-6f)
+        return false;
+
+    inverse.m[0][0] = a.m[1][1] / det;
+    inverse.m[0][1] = -a.m[0][1] / det;
+    inverse.m[1][0] = -a.m[1][0] / det;
+    inverse.m[1][1] = a.m[0][0] / det;
+    inverse.offset[0] = -(inverse.m[0][0] * a.offset[0] + inverse.m[0][1] * a.offset[1]);
+    inverse.offset[1] = -(inverse.m[1][0] * a.offset[0] + inverse.m[1][1] * a.offset[1]);
+    return true;
+}
+
+/// Rounds away float noise so that pixel-aligned mappings are recognised as such
+void snap(Mapping& mapping)
+{
+    auto const snap_to = [](float& value)
+        {
+            auto const nearest = std::round(value);
+            if (std::fabs(value - nearest) < 1e-4f)
+                value = nearest;
+        };
+
+    for (auto& row : mapping.m)
+        for (auto& value : row)
+            snap_to(value);
+    for (auto& value : mapping.offset)
+        snap_to(value);
+}
+
+/// The target pixels covered by a rectangle in the source space of a mapping
+geom::Rectangle map_bounds(Mapping const& mapping, float left, float top, float right, float bottom)
+{
+    float const xs[] = {left, right, left, right};
+    float const ys[] = {top, top, bottom, bottom};
+    float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
+
+    for (int i = 0; i != 4; ++i)
+    {
+        float const x = mapping.m[0][0] * xs[i] + mapping.m[0][1] * ys[i] + mapping.offset[0];
+        float const y = mapping.m[1][0] * xs[i] + mapping.m[1][1] * ys[i] + mapping.offset[1];
+        min_x = std::min(min_x, x);
+        min_y = std::min(min_y, y);
+        max_x = std::max(max_x, x);
+        max_y = std::max(max_y, y);
+    }
+
+    // Pixels whose centres fall inside the mapped rectangle
+    int const x0 = std::ceil(min_x - 0.5f);
+    int const y0 = std::ceil(min_y - 0.5f);
+    int const x1 = std::ceil(max_x - 0.5f);
+    int const y1 = std::ceil(max_y - 0.5f);
+
+    return {{x0, y0}, {std::max(x1 - x0, 0), std::max(y1 - y0, 0)}};
+}
+}
+
+mrs::Renderer::Renderer(mg::DisplayBuffer& display_buffer)
+    : render_target{render_target_for(display_buffer)},
+      target_format{render_target->pixel_format()},
+      target_size{render_target->size()},
+      target_stride{render_target->stride()},
+      output_transform(1)
+{
+    mir::log_info("Software renderer: %dx%d target, SIMD %s",
+                  target_size.width.as_int(), target_size.height.as_int(),
+#ifdef __SSE2__
+                  "SSE2"
+#else
+                  "none"
+#endif
+                  );
+
+    set_viewport(display_buffer.view_area());
+}
+
+void mrs::Renderer::set_viewport(geom::Rectangle const& rect)
+{
+    if (rect == viewport)
+        return;
+
+    viewport = rect;
+    update_output_mapping();
+}
+
+void mrs::Renderer::set_output_transform(glm::mat2 const& t)
+{
+    if (t == output_transform)
+        return;
+
+    output_transform = t;
+    update_output_mapping();
+}
+
+void mrs::Renderer::update_output_mapping()
+{
+    float const viewport_width = viewport.size.width.as_int();
+    float const viewport_height = viewport.size.height.as_int();
+    float const target_width = target_size.width.as_int();
+    float const target_height = target_size.height.as_int();
+
+    /*
+     * The output transform acts on GL clip space, where y points up. Scene
+     * and target coordinates have y pointing down, so flip it around the
+     * transform.
+     */
+    float const d[2][2] = {
+        { output_transform[0][0], -output_transform[1][0]},
+        {-output_transform[0][1],  output_transform[1][1]}};
+
+    // Letterbox the same way as the GL renderer does, to keep pixels square
+    float const transformed_width = std::fabs(d[0][0] * viewport_width + d[0][1] * viewport_height);
+    float const transformed_height = std::fabs(d[1][0] * viewport_width + d[1][1] * viewport_height);
+
+    int area_width = target_width, area_height = target_height;
+    if (transformed_width > 0 && transformed_height > 0)
+    {
+        if (transformed_width * target_height >= target_width * transformed_height)
+            area_height = target_width * transformed_height / transformed_width;
+        else
+            area_width = target_height * transformed_width / transformed_height;
+    }
+    output_area = {
+        {(target_width - area_width) / 2, (target_height - area_height) / 2},
+        {area_width, area_height}};
+
+    float const area[2] = {float(area_width), float(area_height)};
+    float const view[2] = {viewport_width, viewport_height};
+
+    for (int i = 0; i != 2; ++i)
+        for (int j = 0; j != 2; ++j)
+            output_mapping.m[i][j] = view[j] > 0 ? area[i] * d[i][j] / view[j] : 0;
+
+    // The viewport centre lands on the centre of the output area
+    float const viewport_centre[2] = {
+        viewport.top_left.x.as_int() + viewport_width / 2,
+        viewport.top_left.y.as_int() + viewport_height / 2};
+    float const area_centre[2] = {
+        output_area.top_left.x.as_int() + area[0] / 2,
+        output_area.top_left.y.as_int() + area[1] / 2};
+
+    for (int i = 0; i != 2; ++i)
+    {
+        output_mapping.offset[i] = area_centre[i] -
+            output_mapping.m[i][0] * viewport_centre[0] -
+            output_mapping.m[i][1] * viewport_centre[1];
+    }
+
+    snap(output_mapping);
+}
+
+bool mrs::Renderer::prepare(mg::Renderable const& renderable, Draw& draw) const
+{
+    draw.buffer = renderable.buffer();
+    draw.source = draw.buffer ?
+        dynamic_cast<PixelSource*>(draw.buffer->native_buffer_base()) : nullptr;
+
+    if (!draw.source)
+    {
+        mir::log_error("Buffer does not support software rendering!");
+        return false;
+    }
+
+    auto const format = draw.buffer->pixel_format();
+    if (!is_32bpp_rgb(format))
+    {
+        mir::log_error("Software rendering does not support pixel format %d", format);
+        return false;
+    }
+
+    auto const rect = renderable.screen_position();
+    auto const buffer_size = draw.buffer->size();
+
+    // Like the GL renderer, texels map 1:1 onto the surface rectangle
+    draw.source_width = std::min(rect.size.width.as_int(), buffer_size.width.as_int());
+    draw.source_height = std::min(rect.size.height.as_int(), buffer_size.height.as_int());
+
+    float const alpha = renderable.alpha();
+    if (draw.source_width <= 0 || draw.source_height <= 0 || alpha <= 0.0f)
+        return false;
+
+    // Texels -> scene: translate to the rectangle, then transform about its centre
+    glm::mat4 const transform = renderable.transformation();
+    float const centre[2] = {
+        rect.top_left.x.as_int() + rect.size.width.as_int() / 2.0f,
+        rect.top_left.y.as_int() + rect.size.height.as_int() / 2.0f};
+    float const top_left[2] = {float(rect.top_left.x.as_int()), float(rect.top_left.y.as_int())};
+
+    Mapping to_scene;
+    for (int i = 0; i != 2; ++i)
+    {
+        to_scene.m[i][0] = transform[0][i];
+        to_scene.m[i][1] = transform[1][i];
+        to_scene.offset[i] = centre[i] + transform[3][i] +
+            transform[0][i] * (top_left[0] - centre[0]) +
+            transform[1][i] * (top_left[1] - centre[1]);
+    }
+
+    auto to_target = compose(output_mapping, to_scene);
+    snap(to_target);
+    if (!invert(to_target, draw.to_source))
+        return false;
+
+    draw.bounds = map_bounds(to_target, 0, 0, draw.source_width, draw.source_height)
+        .intersection_with(output_area)
+        .intersection_with({{0, 0}, target_size});
+
+    if (auto const clip = renderable.clip_area())
+    {
+        auto const& c = clip.value();
+        draw.bounds = draw.bounds.intersection_with(map_bounds(
+            output_mapping,
+            c.top_left.x.as_int(), c.top_left.y.as_int(),
+            c.bottom_right().x.as_int(), c.bottom_right().y.as_int()));
+    }
+
+    if (draw.bounds.size.width.as_int() <= 0 || draw.bounds.size.height.as_int() <= 0)
+        return false;
+
+    auto const& m = draw.to_source.m;
+    if (m[0][1] != 0 || m[1][0] != 0)
+        draw.sampling = Draw::Sampling::general;
+    else if (m[0][0] == 1 && m[1][1] == 1 &&
+             draw.to_source.offset[0] == std::round(draw.to_source.offset[0]) &&
+             draw.to_source.offset[1] == std::round(draw.to_source.offset[1]))
+        draw.sampling = Draw::Sampling::direct;
+    else
+        draw.sampling = Draw::Sampling::columns;
+
+    // These renderable method names could be better (see LP: #1236224)
+    bool const shaped = renderable.shaped() && has_alpha(format);
+    draw.swap_red_blue = red_first(format) != red_first(target_format);
+    draw.force_opaque = !shaped;
+    draw.alpha = static_cast<uint8_t>(std::lround(std::min(alpha, 1.0f) * 255));
+    draw.opaque = !shaped && draw.alpha == 255;
+
+    return true;
+}
+
+void mrs::Renderer::render(mg::RenderableList const& renderables) const
+{
+    std::vector<Draw> draws;
+    draws.reserve(renderables.size());
+
+    for (auto const& renderable : renderables)
+    {
+        draws.emplace_back();
+        if (!prepare(*renderable, draws.back()))
+            draws.pop_back();
+    }
+
+    /*
+     * Everything beneath an opaque renderable that covers the whole target
+     * is invisible, and so is the background.
+     */
+    geom::Rectangle const whole_target{{0, 0}, target_size};
+    auto first_visible = draws.begin();
+    for (auto d = draws.rbegin(); d != draws.rend(); ++d)
+    {
+        if (d->opaque && d->sampling != Draw::Sampling::general && d->bounds == whole_target)
+        {
+            first_visible = std::prev(d.base());
+            break;
+        }
+    }
+
+    render_target->write(
+        [&](unsigned char* pixels)
+        {
+            if (first_visible == draws.begin() &&
+                (draws.empty() || !draws.front().opaque ||
+                 draws.front().sampling == Draw::Sampling::general ||
+                 draws.front().bounds != whole_target))
+            {
+                auto const row_bytes = target_size.width.as_int() * sizeof(uint32_t);
+                for (int y = 0; y != target_size.height.as_int(); ++y)
+                {
+                    std::memset(pixels + y * target_stride.as_int(), transparent_black, row_bytes);
+                }
+            }
+
+            for (auto d = first_visible; d != draws.end(); ++d)
+                draw(*d, pixels);
+        });
+
+    render_target->swap_buffers();
+}
+
+void mrs::Renderer::draw(Draw const& draw, unsigned char* pixels) const
+{
+    int const x0 = draw.bounds.top_left.x.as_int();
+    int const y0 = draw.bounds.top_left.y.as_int();
+    int const width = draw.bounds.size.width.as_int();
+    int const height = draw.bounds.size.height.as_int();
+    auto const& to_source = draw.to_source;
+    int const source_stride = draw.source->stride().as_int();
+
+    row.resize(width);
+
+    if (draw.sampling == Draw::Sampling::columns)
+    {
+        columns.resize(width);
+        for (int x = 0; x != width; ++x)
+        {
+            int const column =
+                std::floor(to_source.m[0][0] * (x0 + x + 0.5f) + to_source.offset[0]);
+            columns[x] = std::max(0, std::min(column, draw.source_width - 1));
+        }
+    }
+
+    draw.source->read(
+        [&](unsigned char const* source_pixels)
+        {
+            for (int y = y0; y != y0 + height; ++y)
+            {
+                auto const dest =
+                    reinterpret_cast<uint32_t*>(pixels + y * target_stride.as_int()) + x0;
+                uint32_t const* src = nullptr;
+                int start = 0, count = width;
+
+                switch (draw.sampling)
+                {
+                case Draw::Sampling::direct:
+                case Draw::Sampling::columns:
+                {
+                    int const source_row = std::max(0, std::min<int>(
+                        std::floor(to_source.m[1][1] * (y + 0.5f) + to_source.offset[1]),
+                        draw.source_height - 1));
+                    auto const source_line =
+                        reinterpret_cast<uint32_t const*>(source_pixels + source_row * source_stride);
+
+                    if (draw.sampling == Draw::Sampling::direct)
+                    {
+                        src = source_line + x0 + static_cast<int>(to_source.offset[0]);
+                    }
+                    else
+                    {
+                        gather_row(row.data(), source_line, columns.data(), width);
+                        src = row.data();
+                    }
+                    break;
+                }
+                case Draw::Sampling::general:
+                {
+                    // The source is a parallelogram, so its pixels on a row are contiguous
+                    start = width;
+                    count = 0;
+                    for (int x = 0; x != width; ++x)
+                    {
+                        float const px = x0 + x + 0.5f, py = y + 0.5f;
+                        int const tx = std::floor(
+                            to_source.m[0][0] * px + to_source.m[0][1] * py + to_source.offset[0]);
+                        int const ty = std::floor(
+                            to_source.m[1][0] * px + to_source.m[1][1] * py + to_source.offset[1]);
+
+                        if (tx < 0 || ty < 0 || tx >= draw.source_width || ty >= draw.source_height)
+                        {
+                            if (count)
+                                break;
+                            continue;
+                        }
+
+                        if (!count)
+                            start = x;
+                        row[start + count++] =
+                            reinterpret_cast<uint32_t const*>(source_pixels + ty * source_stride)[tx];
+                    }
+                    src = row.data() + start;
+                    break;
+                }
+                }
+
+                if (!count)
+                    continue;
+
+                if (draw.swap_red_blue || draw.force_opaque)
+                {
+                    if (src != row.data() + start)
+                        std::copy(src, src + count, row.data() + start);
+                    src = row.data() + start;
+                    convert_row(row.data() + start, count, draw.swap_red_blue, draw.force_opaque);
+                }
+
+                if (draw.opaque)
+                    std::copy(src, src + count, dest + start);
+                else
+                    blend_row(dest + start, src, count, draw.alpha);
+            }
+        });
+}
+
+void mrs::Renderer::suspend()
+{
+}
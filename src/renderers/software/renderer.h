@@ -0,0 +1,84 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RENDERER_SOFTWARE_RENDERER_H_
+#define MIR_RENDERER_SOFTWARE_RENDERER_H_
+
+#include <mir/renderer/renderer.h>
+#include <mir/geometry/rectangle.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace mir
+{
+namespace graphics { class DisplayBuffer; }
+namespace renderer
+{
+namespace software
+{
+class RenderTarget;
+
+/**
+ * Composites renderables into a CPU-mapped display buffer.
+ *
+ * Renderables must be backed by buffers that are software::PixelSources in
+ * one of the 32bpp RGB formats. Sampling is nearest-neighbour, which is
+ * exact for the common case of unscaled, untransformed surfaces.
+ */
+class Renderer : public renderer::Renderer
+{
+public:
+    Renderer(graphics::DisplayBuffer& display_buffer);
+
+    void set_viewport(geometry::Rectangle const& rect) override;
+    void set_output_transform(glm::mat2 const&) override;
+    void render(graphics::RenderableList const&) const override;
+    void suspend() override;
+
+    /// An affine map from one 2D space to another: out = m * in + offset
+    struct Mapping
+    {
+        float m[2][2];
+        float offset[2];
+    };
+
+private:
+    struct Draw;
+
+    void update_output_mapping();
+    bool prepare(graphics::Renderable const& renderable, Draw& draw) const;
+    void draw(Draw const& draw, unsigned char* pixels) const;
+
+    RenderTarget* const render_target;
+    MirPixelFormat const target_format;
+    geometry::Size const target_size;
+    geometry::Stride const target_stride;
+
+    geometry::Rectangle viewport;
+    glm::mat2 output_transform;
+    Mapping output_mapping;          ///< scene coordinates to target pixels
+    geometry::Rectangle output_area; ///< where the viewport lands in the target
+
+    std::vector<uint32_t> mutable row;
+    std::vector<int> mutable columns;
+};
+
+}
+}
+}
+
+#endif /* MIR_RENDERER_SOFTWARE_RENDERER_H_ */
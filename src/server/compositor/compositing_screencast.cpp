@@ -29,13 +29,18 @@
 #include "mir/graphics/transformation.h"
 #include "mir/compositor/display_buffer_compositor.h"
 #include "mir/geometry/rectangles.h"
+#include "mir/scene/legacy_scene_change_notification.h"
 #include "mir/raii.h"
 
 #include <boost/throw_exception.hpp>
 
+#include <algorithm>
+#include <atomic>
+
 namespace mc = mir::compositor;
 namespace mf = mir::frontend;
 namespace mg = mir::graphics;
+namespace ms = mir::scene;
 namespace geom = mir::geometry;
 
 namespace
@@ -76,29 +81,47 @@ public:
         std::vector<std::shared_ptr<mg::Buffer>> const& buffers,
         geom::Rectangle const& capture_region,
         geom::Size const& capture_size,
-        MirMirrorMode mirror_mode)
+        MirMirrorMode mirror_mode,
+        std::chrono::nanoseconds min_capture_interval)
     : scene{scene},
       display_buffer{std::make_unique<ScreencastDisplayBuffer>(capture_region, capture_size, mirror_mode, free_queue, ready_queue, display)},
       display_buffer_compositor{db_compositor_factory.create_compositor_for(*display_buffer)},
       virtual_output{make_virtual_output(display, capture_region)},
       queue_size(capture_size),
-      mirror_mode(mirror_mode)
+      mirror_mode(mirror_mode),
+      capture_region{capture_region},
+      min_capture_interval{min_capture_interval},
+      observer{std::make_shared<ms::LegacySceneChangeNotification>(
+          [this] { damaged = true; },
+          [this](int, geom::Rectangle const& damage)
+          {
+              if (this->capture_region.overlaps(damage))
+                  damaged = true;
+          })}
     {
         for (auto buffer : buffers)
             free_queue.schedule(buffer);
 
         scene->register_compositor(this);
+        scene->set_compositor_area(this, capture_region);
+        scene->add_observer(observer);
         if (virtual_output)
             virtual_output->enable();
     }
     ~ScreencastSessionContext()
     {
+        scene->remove_observer(observer);
         scene->unregister_compositor(this);
     }
 
     std::shared_ptr<mg::Buffer> capture()
     {
         std::lock_guard<decltype(mutex)> lk(mutex);
+
+        // The client gets the frame it already has until there's something new
+        if (last_captured_buffer && !new_frame_due())
+            return last_captured_buffer;
+
         if (queue_size != display_buffer->renderbuffer_size())
             display_buffer->set_renderbuffer_size(queue_size);
 
@@ -107,7 +130,7 @@ public:
         if (last_captured_buffer)
             free_queue.schedule(last_captured_buffer);
 
-        display_buffer_compositor->composite(scene->scene_elements_for(this));
+        composite();
 
         last_captured_buffer = ready_queue.next_buffer();
         return last_captured_buffer;
@@ -116,6 +139,14 @@ public:
     void capture(std::shared_ptr<mg::Buffer> const& buffer)
     {
         std::lock_guard<decltype(mutex)> lk(mutex);
+
+        auto const holds_latest_frame = std::find(
+            buffers_with_latest_frame.begin(), buffers_with_latest_frame.end(), buffer->id()) !=
+            buffers_with_latest_frame.end();
+
+        if (holds_latest_frame && !new_frame_due())
+            return;
+
         if (buffer->size() != display_buffer->renderbuffer_size())
             display_buffer->set_renderbuffer_size(buffer->size());
        
@@ -138,15 +169,41 @@ public:
         for(auto i = 0u; i < scheduled; i++)
             free_queue.schedule(free_queue.next_buffer());
 
-        display_buffer_compositor->composite(scene->scene_elements_for(this));
+        // Rendering only because this buffer was behind leaves the others current
+        if (composite() || buffers_with_latest_frame.size() >= max_buffers_tracked)
+            buffers_with_latest_frame.clear();
         if (buffer != ready_queue.next_buffer())
             throw std::runtime_error("unable to capture to buffer");
+        buffers_with_latest_frame.push_back(buffer->id());
 
         display_buffer->set_transformation(mg::transformation(mirror_mode));
         display_buffer->commit();
     }
 
 private:
+    static size_t const max_buffers_tracked{8};
+
+    bool scene_changed() const
+    {
+        return damaged || scene->frames_pending(this) > 0;
+    }
+
+    /// Whether rendering again would show anything new, and we may render again already
+    bool new_frame_due() const
+    {
+        return scene_changed() && std::chrono::steady_clock::now() - last_composite >= min_capture_interval;
+    }
+
+    /// \returns whether the scene had changed since the previous frame
+    bool composite()
+    {
+        auto const changed = scene_changed();
+        damaged = false;
+        last_composite = std::chrono::steady_clock::now();
+        display_buffer_compositor->composite(scene->scene_elements_for(this));
+        return changed;
+    }
+
     std::mutex mutex;
     std::shared_ptr<Scene> const scene;
     QueueingSchedule free_queue;
@@ -158,6 +215,13 @@ private:
     std::shared_ptr<mg::Buffer> last_captured_buffer;
     geom::Size queue_size;
     MirMirrorMode mirror_mode;
+    geom::Rectangle const capture_region;
+    std::chrono::nanoseconds const min_capture_interval;
+
+    std::atomic<bool> damaged{true};
+    std::shared_ptr<ms::Observer> const observer;
+    std::chrono::steady_clock::time_point last_composite;
+    std::vector<mg::BufferID> buffers_with_latest_frame;
 };
 
 
@@ -165,11 +229,13 @@ mc::CompositingScreencast::CompositingScreencast(
     std::shared_ptr<Scene> const& scene,
     std::shared_ptr<mg::Display> const& display,
     std::shared_ptr<mg::GraphicBufferAllocator> const& buffer_allocator,
-    std::shared_ptr<DisplayBufferCompositorFactory> const& db_compositor_factory)
+    std::shared_ptr<DisplayBufferCompositorFactory> const& db_compositor_factory,
+    std::chrono::nanoseconds min_capture_interval)
     : scene{scene},
       display{display},
       buffer_allocator{buffer_allocator},
-      db_compositor_factory{db_compositor_factory}
+      db_compositor_factory{db_compositor_factory},
+      min_capture_interval{min_capture_interval}
 {
 }
 
@@ -240,7 +306,7 @@ mc::CompositingScreencast::create_session_context(
     MirMirrorMode mirror_mode)
 {
     return std::make_shared<detail::ScreencastSessionContext>(
-        scene, *display, *db_compositor_factory, buffers, rect, size, mirror_mode);
+        scene, *display, *db_compositor_factory, buffers, rect, size, mirror_mode, min_capture_interval);
 }
 
 void mc::CompositingScreencast::capture(
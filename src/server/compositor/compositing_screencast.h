@@ -21,6 +21,7 @@
 
 #include "mir/frontend/screencast.h"
 
+#include <chrono>
 #include <unordered_map>
 #include <mutex>
 
@@ -40,6 +41,13 @@ namespace detail { struct ScreencastSessionContext; }
 
 class DisplayBufferCompositorFactory;
 
+/**
+ * Captures by compositing the scene into each session's own buffers.
+ *
+ * A session only composites again when something within its region has
+ * changed since the last capture, and at most once per min_capture_interval;
+ * otherwise the client is given the frame it already has.
+ */
 class CompositingScreencast : public frontend::Screencast
 {
 public:
@@ -47,7 +55,8 @@ public:
         std::shared_ptr<Scene> const& scene,
         std::shared_ptr<graphics::Display> const& display,
         std::shared_ptr<graphics::GraphicBufferAllocator> const& buffer_allocator,
-        std::shared_ptr<DisplayBufferCompositorFactory> const& db_compositor_factory);
+        std::shared_ptr<DisplayBufferCompositorFactory> const& db_compositor_factory,
+        std::chrono::nanoseconds min_capture_interval);
 
     frontend::ScreencastSessionId create_session(
         geometry::Rectangle const& region,
@@ -73,6 +82,7 @@ private:
     std::shared_ptr<graphics::Display> const display;
     std::shared_ptr<graphics::GraphicBufferAllocator> const buffer_allocator;
     std::shared_ptr<DisplayBufferCompositorFactory> const db_compositor_factory;
+    std::chrono::nanoseconds const min_capture_interval;
 
     std::unordered_map<frontend::ScreencastSessionId,
                        std::shared_ptr<detail::ScreencastSessionContext>> session_contexts;
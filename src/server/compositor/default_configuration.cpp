@@ -23,17 +23,54 @@
 #include "default_display_buffer_compositor_factory.h"
 #include "multi_threaded_compositor.h"
 #include "gl/renderer_factory.h"
+#include "software/renderer_factory.h"
 #include "compositing_screencast.h"
 #include "mir/main_loop.h"
 
 #include "mir/frontend/screencast.h"
 #include "mir/options/configuration.h"
+#include "mir/graphics/display_buffer.h"
+#include "mir/renderer/renderer.h"
+#include "mir/renderer/gl/render_target.h"
+#include "mir/renderer/sw/render_target.h"
+#include "mir/log.h"
 
 #include <boost/throw_exception.hpp>
 
 namespace mc = mir::compositor;
 namespace ms = mir::scene;
 namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+
+namespace
+{
+/// Uses GL on outputs that support it and falls back to software rendering
+class AutoRendererFactory : public mir::renderer::RendererFactory
+{
+public:
+    AutoRendererFactory(std::string const& program_cache_dir, bool texture_atlas, bool layer_cache)
+        : gl{program_cache_dir, texture_atlas, layer_cache}
+    {
+    }
+
+    std::unique_ptr<mir::renderer::Renderer> create_renderer_for(mg::DisplayBuffer& display_buffer) override
+    {
+        auto const native = display_buffer.native_display_buffer();
+
+        if (!dynamic_cast<mir::renderer::gl::RenderTarget*>(native) &&
+            dynamic_cast<mir::renderer::software::RenderTarget*>(native))
+        {
+            return software.create_renderer_for(display_buffer);
+        }
+
+        return gl.create_renderer_for(display_buffer);
+    }
+
+private:
+    mir::renderer::gl::RendererFactory gl;
+    mir::renderer::software::RendererFactory software;
+};
+}
 
 std::shared_ptr<ms::BufferStreamFactory>
 mir::DefaultServerConfiguration::the_buffer_stream_factory()
@@ -86,9 +123,30 @@ mir::DefaultServerConfiguration::the_compositor()
 std::shared_ptr<mir::renderer::RendererFactory> mir::DefaultServerConfiguration::the_renderer_factory()
 {
     return renderer_factory(
-        []()
+        [this]() -> std::shared_ptr<mir::renderer::RendererFactory>
         {
-            return std::make_shared<mir::renderer::gl::RendererFactory>();
+            auto const renderer_choice = the_options()->get<std::string>(options::renderer_opt);
+            auto const program_cache_dir = the_options()->is_set(options::gl_program_cache_opt) ?
+                the_options()->get<std::string>(options::gl_program_cache_opt) : "";
+            auto const texture_atlas = the_options()->get<bool>(options::gl_texture_atlas_opt);
+            auto const layer_cache = the_options()->get<bool>(options::gl_layer_cache_opt);
+
+            if (renderer_choice == "gl")
+            {
+                mir::log_info("Using GL renderer");
+                return std::make_shared<mir::renderer::gl::RendererFactory>(program_cache_dir, texture_atlas, layer_cache);
+            }
+            else if (renderer_choice == "software")
+            {
+                mir::log_info("Using software renderer");
+                return std::make_shared<mir::renderer::software::RendererFactory>();
+            }
+            else if (renderer_choice == "auto")
+            {
+                return std::make_shared<AutoRendererFactory>(program_cache_dir, texture_atlas, layer_cache);
+            }
+
+            BOOST_THROW_EXCEPTION(std::runtime_error("Unknown renderer: " + renderer_choice));
         });
 }
 
@@ -97,11 +155,16 @@ std::shared_ptr<mf::Screencast> mir::DefaultServerConfiguration::the_screencast(
     return screencast(
         [this]()
         {
+            auto const max_rate = the_options()->get<int>(options::screencast_max_rate_opt);
+            auto const min_interval = max_rate > 0 ?
+                std::chrono::nanoseconds{std::chrono::seconds{1}} / max_rate :
+                std::chrono::nanoseconds::zero();
+
             return std::make_shared<mc::CompositingScreencast>(
                 the_scene(),
                 the_display(),
                 the_buffer_allocator(),
-                the_display_buffer_compositor_factory()
-                );
+                the_display_buffer_compositor_factory(),
+                min_interval);
         });
 }
@@ -101,7 +101,11 @@ public:
             [this,&compositors]
             {
                 for (auto& compositor : compositors)
-                    scene->register_compositor(std::get<1>(compositor).get());
+                {
+                    auto const comp_id = std::get<1>(compositor).get();
+                    scene->register_compositor(comp_id);
+                    scene->set_compositor_area(comp_id, std::get<0>(compositor)->view_area());
+                }
             },
             [this,&compositors]{
                 for (auto& compositor : compositors)
@@ -135,6 +139,12 @@ public:
                     not_posted_yet = false;
                     lock.unlock();
 
+                    /*
+                     * A group's buffers are composited one after another, so its frame
+                     * time is the sum of theirs. Each group has its own thread, and the
+                     * in-tree platforms put every output (or set of clones sharing one
+                     * buffer) in a group of its own, so outputs don't wait on each other.
+                     */
                     for (auto& tuple : compositors)
                     {
                         auto& compositor = std::get<1>(tuple);
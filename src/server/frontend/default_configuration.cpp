@@ -90,6 +90,7 @@ mir::DefaultServerConfiguration::the_connector()
             {
                 return std::make_shared<mf::BasicConnector>(
                     the_connection_creator(),
+                    the_options()->get<int>(options::ipc_thread_pool_opt),
                     the_connector_report());
             }
             else
@@ -97,6 +98,7 @@ mir::DefaultServerConfiguration::the_connector()
                 auto const result = std::make_shared<mf::PublishedSocketConnector>(
                     the_socket_file(),
                     the_connection_creator(),
+                    the_options()->get<int>(options::ipc_thread_pool_opt),
                     *the_emergency_cleanup(),
                     the_connector_report());
 
@@ -175,6 +177,7 @@ mir::DefaultServerConfiguration::the_prompt_connector()
                 return std::make_shared<mf::PublishedSocketConnector>(
                     the_socket_file() + "_trusted",
                     the_prompt_connection_creator(),
+                    the_options()->get<int>(options::ipc_thread_pool_opt),
                     *the_emergency_cleanup(),
                     the_connector_report());
             }
@@ -182,6 +185,7 @@ mir::DefaultServerConfiguration::the_prompt_connector()
             {
                 return std::make_shared<mf::BasicConnector>(
                     the_prompt_connection_creator(),
+                    the_options()->get<int>(options::ipc_thread_pool_opt),
                     the_connector_report());
             }
         });
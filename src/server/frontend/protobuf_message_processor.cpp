@@ -31,6 +31,15 @@ namespace mfd = mir::frontend::detail;
 
 namespace
 {
+template<size_t size>
+google::protobuf::ArenaOptions arena_options(std::array<char, size>& initial_block)
+{
+    google::protobuf::ArenaOptions options;
+    options.initial_block = initial_block.data();
+    options.initial_block_size = initial_block.size();
+    return options;
+}
+
 template<class Response>
 std::vector<mir::Fd> extract_fds_from(Response* response)
 {
@@ -49,7 +58,8 @@ mfd::ProtobufMessageProcessor::ProtobufMessageProcessor(
     std::shared_ptr<MessageProcessorReport> const& report) :
     sender(sender),
     display_server(display_server),
-    report(report)
+    report(report),
+    message_arena{arena_options(arena_initial_block)}
 {
 }
 
@@ -68,36 +78,17 @@ template<> struct result_ptr_t<mir::protobuf::SocketFD>     { typedef ::mir::pro
 template<> struct result_ptr_t<mir::protobuf::PlatformOperationMessage> { typedef ::mir::protobuf::PlatformOperationMessage* type; };
 
 template<class ParameterMessage>
-ParameterMessage parse_parameter(Invocation const& invocation)
+ParameterMessage* parse_parameter(google::protobuf::Arena* arena, Invocation const& invocation)
 {
-    ParameterMessage request;
-    if (!request.ParseFromString(invocation.parameters()))
+    auto const request = google::protobuf::Arena::CreateMessage<ParameterMessage>(arena);
+    if (!request->ParseFromString(invocation.parameters()))
         BOOST_THROW_EXCEPTION(std::runtime_error("Failed to parse message parameters!"));
     return request;
 }
 
-class CallbackClosure : public google::protobuf::Closure
-{
-public:
-    CallbackClosure(std::function<void()> const& callback)
-    : callback(callback)
-    {
-    }
-
-    void Run() override
-    {
-        callback();
-    }
-
- private:
-  CallbackClosure(CallbackClosure&) = delete;
-  void operator=(const CallbackClosure&) = delete;
-  std::function<void()> const callback;
-};
-
 template<typename RequestType, typename ResponseType>
 void invoke(
-    std::shared_ptr<ProtobufMessageProcessor> const& mp,
+    ProtobufMessageProcessor* mp,
     DisplayServer* server,
     void (mir::protobuf::DisplayServer::*function)(
         const RequestType* request,
@@ -106,25 +97,15 @@ void invoke(
     unsigned int invocation_id,
     RequestType* request)
 {
-    auto const result_message = std::make_shared<ResponseType>();
+    auto const result_message = google::protobuf::Arena::CreateMessage<ResponseType>(mp->arena());
 
-    std::weak_ptr<ProtobufMessageProcessor> weak_mp = mp;
-    auto const response_callback = [weak_mp, invocation_id, result_message]
-    {
-        auto message_processor = weak_mp.lock();
-        if (message_processor)
-        {
-            message_processor->send_response(invocation_id, result_message);
-        }
-    };
-
-    CallbackClosure callback{response_callback};
+    SendResponseClosure<ProtobufMessageProcessor, ResponseType> callback{mp, invocation_id, result_message};
 
     try
     {
         (server->*function)(
             request,
-            result_message.get(),
+            result_message,
             &callback);
     }
     catch (mir::cookie::SecurityCheckError const& /*err*/)
@@ -209,11 +190,11 @@ bool mfd::ProtobufMessageProcessor::dispatch(
         }
         else if ("submit_buffer" == invocation.method_name())
         {
-            auto request = parse_parameter<mir::protobuf::BufferRequest>(invocation);
-            request.mutable_buffer()->clear_fd();
+            auto const request = parse_parameter<mir::protobuf::BufferRequest>(arena(), invocation);
+            request->mutable_buffer()->clear_fd();
             for (auto& fd : side_channel_fds)
-                request.mutable_buffer()->add_fd(fd);
-            invoke(shared_from_this(), display_server.get(), &DisplayServer::submit_buffer, invocation.id(), &request);
+                request->mutable_buffer()->add_fd(fd);
+            invoke(this, display_server.get(), &DisplayServer::submit_buffer, invocation.id(), request);
         }
         else if ("allocate_buffers" == invocation.method_name())
         {
@@ -229,14 +210,14 @@ bool mfd::ProtobufMessageProcessor::dispatch(
         }
         else if ("platform_operation" == invocation.method_name())
         {
-            auto request = parse_parameter<mir::protobuf::PlatformOperationMessage>(invocation);
+            auto const request = parse_parameter<mir::protobuf::PlatformOperationMessage>(arena(), invocation);
 
-            request.clear_fd();
+            request->clear_fd();
             for (auto& fd : side_channel_fds)
-                request.add_fd(fd);
+                request->add_fd(fd);
 
-            invoke(shared_from_this(), display_server.get(), &DisplayServer::platform_operation,
-                   invocation.id(), &request);
+            invoke(this, display_server.get(), &DisplayServer::platform_operation,
+                   invocation.id(), request);
         }
         else if ("configure_display" == invocation.method_name())
         {
@@ -282,6 +263,10 @@ bool mfd::ProtobufMessageProcessor::dispatch(
         {
             invoke(this, display_server.get(), &DisplayServer::release_buffer_stream, invocation);
         }
+        else if ("create_buffer_ring" == invocation.method_name())
+        {
+            invoke(this, display_server.get(), &DisplayServer::create_buffer_ring, invocation);
+        }
         else if ("configure_cursor" == invocation.method_name())
         {
             invoke(this, display_server.get(), &protobuf::DisplayServer::configure_cursor, invocation);
@@ -371,6 +356,10 @@ bool mfd::ProtobufMessageProcessor::dispatch(
 
     report->completed_invocation(display_server.get(), invocation.id(), result);
 
+    // Every message of this invocation has been sent (the response closures
+    // are only valid for the duration of the call) so the arena can be reused
+    message_arena.Reset();
+
     return result;
 }
 
@@ -384,11 +373,6 @@ void mfd::ProtobufMessageProcessor::send_response(::google::protobuf::uint32 id,
     sender->send_response(id, response, {extract_fds_from(response)});
 }
 
-void mfd::ProtobufMessageProcessor::send_response(::google::protobuf::uint32 id, std::shared_ptr<protobuf::Void> response)
-{
-    send_response(id, response.get());
-}
-
 void mfd::ProtobufMessageProcessor::send_response(::google::protobuf::uint32 id, mir::protobuf::Connection* response)
 {
     if (response->has_platform())
@@ -432,7 +416,12 @@ void mfd::ProtobufMessageProcessor::send_response(::google::protobuf::uint32 id,
 
 void mfd::ProtobufMessageProcessor::send_response(
     ::google::protobuf::uint32 id,
-    std::shared_ptr<mir::protobuf::PlatformOperationMessage> response)
+    mir::protobuf::PlatformOperationMessage* response)
+{
+    sender->send_response(id, response, {extract_fds_from(response)});
+}
+
+google::protobuf::Arena* mfd::ProtobufMessageProcessor::arena()
 {
-    sender->send_response(id, response.get(), {extract_fds_from(response.get())});
+    return &message_arena;
 }
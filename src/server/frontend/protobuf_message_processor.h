@@ -23,7 +23,9 @@
 #include "mir/frontend/message_processor.h"
 #include "mir_protobuf.pb.h"
 #include <google/protobuf/stubs/common.h>
+#include <google/protobuf/arena.h>
 
+#include <array>
 #include <memory>
 
 namespace google { namespace protobuf { class MessageLite; } }
@@ -38,8 +40,7 @@ namespace detail
 class DisplayServer;
 class ProtobufMessageSender;
 
-class ProtobufMessageProcessor : public MessageProcessor,
-                                 public std::enable_shared_from_this<ProtobufMessageProcessor>
+class ProtobufMessageProcessor : public MessageProcessor
 {
 public:
     ProtobufMessageProcessor(
@@ -55,11 +56,15 @@ public:
     void send_response(google::protobuf::uint32 id, protobuf::Buffer* response);
     void send_response(google::protobuf::uint32 id, protobuf::Connection* response);
     void send_response(google::protobuf::uint32 id, protobuf::Surface* response);
-    void send_response(google::protobuf::uint32 id, std::shared_ptr<protobuf::Void> response);
     void send_response(google::protobuf::uint32 id, mir::protobuf::Screencast* response);
     void send_response(google::protobuf::uint32 id, mir::protobuf::BufferStream* response);
     void send_response(google::protobuf::uint32 id, mir::protobuf::SocketFD* response);
-    void send_response(google::protobuf::uint32 id, std::shared_ptr<protobuf::PlatformOperationMessage> response);
+    void send_response(google::protobuf::uint32 id, protobuf::PlatformOperationMessage* response);
+
+    /// Owns the request and response messages of the invocation being
+    /// dispatched. It is reset after each dispatch and starts from an embedded
+    /// block, so small requests such as submit_buffer don't touch the heap.
+    google::protobuf::Arena* arena();
 
 private:
     bool dispatch(Invocation const& invocation, std::vector<mir::Fd> const& side_channel_fds) override;
@@ -67,6 +72,9 @@ private:
     std::shared_ptr<ProtobufMessageSender> const sender;
     std::shared_ptr<DisplayServer> const display_server;
     std::shared_ptr<MessageProcessorReport> const report;
+
+    alignas(8) std::array<char, 4096> arena_initial_block;
+    google::protobuf::Arena message_arena;
 };
 }
 }
@@ -31,6 +31,7 @@
 #include <sys/socket.h>
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <fstream>
 
@@ -98,6 +99,14 @@ std::string remove_if_stale(std::string const& socket_name)
     return socket_name;
 }
 
+unsigned pool_size(int requested)
+{
+    if (requested > 0)
+        return requested;
+
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
 std::shared_ptr<boost::asio::local::stream_protocol::socket> make_socket_self_contained(
     std::shared_ptr<boost::asio::io_service> const &io_service,
     std::shared_ptr<boost::asio::local::stream_protocol::socket> const &socket)
@@ -126,9 +135,10 @@ std::shared_ptr<boost::asio::local::stream_protocol::socket> make_socket_self_co
 mf::PublishedSocketConnector::PublishedSocketConnector(
     const std::string& socket_file,
     std::shared_ptr<ConnectionCreator> const& connection_creator,
+    int thread_count,
     EmergencyCleanupRegistry& emergency_cleanup_registry,
     std::shared_ptr<ConnectorReport> const& report)
-:   BasicConnector(connection_creator, report),
+:   BasicConnector(connection_creator, thread_count, report),
     socket_file(remove_if_stale(socket_file)),
     acceptor(*io_service, socket_file)
 {
@@ -191,10 +201,12 @@ auto mir::frontend::PublishedSocketConnector::socket_name() const -> optional_va
 
 mf::BasicConnector::BasicConnector(
     std::shared_ptr<ConnectionCreator> const& connection_creator,
+    int thread_count,
     std::shared_ptr<ConnectorReport> const& report)
 :   io_service(std::make_shared<boost::asio::io_service>()),
     work(*io_service),
     report(report),
+    thread_count{pool_size(thread_count)},
     connection_creator{connection_creator}
 {
 }
@@ -218,7 +230,8 @@ void mf::BasicConnector::start()
         }
     };
 
-    io_service_thread = std::thread(run_io_service);
+    for (auto i = 0u; i != thread_count; ++i)
+        io_service_threads.emplace_back(run_io_service);
 }
 
 void mf::BasicConnector::stop()
@@ -226,9 +239,13 @@ void mf::BasicConnector::stop()
     /* Stop processing new requests */
     io_service->stop();
 
-    /* Wait for io processing thread to finish */
-    if (io_service_thread.joinable())
-        io_service_thread.join();
+    /* Wait for io processing threads to finish */
+    for (auto& thread : io_service_threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+    io_service_threads.clear();
 
     /* Prepare for a potential restart */
     io_service->reset();
@@ -25,6 +25,7 @@
 
 #include <thread>
 #include <string>
+#include <vector>
 #include <functional>
 
 namespace google
@@ -46,11 +47,16 @@ class ConnectorReport;
 class MirClientSession;
 
 /// provides a client-side socket fd for each connection
+///
+/// The io_service is run on a pool of \a thread_count threads (0 meaning
+/// one per CPU). Each connection's messenger serialises its own handlers,
+/// so requests from one client are still processed in order.
 class BasicConnector : public Connector
 {
 public:
     explicit BasicConnector(
         std::shared_ptr<ConnectionCreator> const& connection_creator,
+        int thread_count,
         std::shared_ptr<ConnectorReport> const& report);
     ~BasicConnector() noexcept;
     void start() override;
@@ -69,7 +75,8 @@ protected:
     std::shared_ptr<ConnectorReport> const report;
 
 private:
-    std::thread io_service_thread;
+    unsigned const thread_count;
+    std::vector<std::thread> io_service_threads;
     std::shared_ptr<ConnectionCreator> const connection_creator;
 };
 
@@ -80,6 +87,7 @@ public:
     explicit PublishedSocketConnector(
         const std::string& socket_file,
         std::shared_ptr<ConnectionCreator> const& connection_creator,
+        int thread_count,
         EmergencyCleanupRegistry& emergency_cleanup_registry,
         std::shared_ptr<ConnectorReport> const& report);
     ~PublishedSocketConnector() noexcept;
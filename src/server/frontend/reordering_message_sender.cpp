@@ -35,7 +35,8 @@ void mf::ReorderingMessageSender::send(
         std::lock_guard<decltype(message_lock)> lock{message_lock};
         if (corked)
         {
-            buffered_messages.emplace_back(Message {std::vector<char>(data, data + length), FdSets(fds)});
+            buffered_messages.emplace_back(Message{buffered_data.size(), length, fds});
+            buffered_data.insert(buffered_data.end(), data, data + length);
             return;
         }
     }
@@ -52,7 +53,10 @@ void mf::ReorderingMessageSender::uncork()
 
     for (auto const& message : buffered_messages)
     {
-        sink->send(message.data.data(), message.data.size(), message.fds);
+        sink->send(buffered_data.data() + message.offset, message.length, message.fds);
     }
-    buffered_messages.clear();
+
+    // We never cork again, so there's no point keeping the capacity around
+    std::vector<Message>{}.swap(buffered_messages);
+    std::vector<char>{}.swap(buffered_data);
 }
@@ -22,6 +22,7 @@
 #include "message_sender.h"
 
 #include <mutex>
+#include <vector>
 
 namespace mir
 {
@@ -49,11 +50,14 @@ public:
 private:
     struct Message
     {
-        std::vector<char> data;
+        size_t offset;
+        size_t length;
         FdSets fds;
     };
     std::mutex message_lock;
     bool corked;
+    /// Payloads of all buffered messages, back to back
+    std::vector<char> buffered_data;
     std::vector<Message> buffered_messages;
     std::shared_ptr<MessageSender> const sink;
 };
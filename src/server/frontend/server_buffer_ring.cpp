@@ -0,0 +1,156 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "server_buffer_ring.h"
+#include "protobuf_buffer_packer.h"
+
+#include "mir/frontend/buffer_ring.h"
+#include "mir/dispatch/multiplexing_dispatchable.h"
+#include "mir/dispatch/threaded_dispatcher.h"
+#include "mir/graphics/buffer.h"
+#include "mir/log.h"
+
+#include "mir_protobuf.pb.h"
+
+namespace mf = mir::frontend;
+namespace mfd = mir::frontend::detail;
+namespace mg = mir::graphics;
+namespace md = mir::dispatch;
+
+namespace
+{
+md::MultiplexingDispatchable& ring_dispatcher()
+{
+    // Started on first use: servers (and forking tests) that never create a
+    // ring don't get the extra thread.
+    static auto const dispatcher = std::make_shared<md::MultiplexingDispatchable>();
+    static md::ThreadedDispatcher const thread{"Mir/BufferRing", dispatcher};
+    return *dispatcher;
+}
+}
+
+auto mfd::ServerBufferRing::create(
+    std::function<void(graphics::BufferID)> const& submit,
+    std::shared_ptr<BufferSink> const& fallback,
+    std::shared_ptr<graphics::PlatformIpcOperations> const& ipc_operations)
+    -> std::shared_ptr<ServerBufferRing>
+{
+    std::shared_ptr<ServerBufferRing> const result{new ServerBufferRing{submit, fallback, ipc_operations}};
+
+    std::weak_ptr<ServerBufferRing> const weak_result{result};
+    ring_dispatcher().add_watch(
+        result->ring->incoming_event(),
+        [weak_result]
+        {
+            if (auto const live_ring = weak_result.lock())
+                live_ring->drain_submissions();
+        });
+
+    return result;
+}
+
+mfd::ServerBufferRing::ServerBufferRing(
+    std::function<void(graphics::BufferID)> const& submit,
+    std::shared_ptr<BufferSink> const& fallback,
+    std::shared_ptr<graphics::PlatformIpcOperations> const& ipc_operations) :
+    submit{submit},
+    fallback{fallback},
+    ipc_operations{ipc_operations},
+    ring{BufferRing::create()}
+{
+}
+
+mfd::ServerBufferRing::~ServerBufferRing()
+{
+    stop();
+}
+
+auto mfd::ServerBufferRing::client_fds() const -> std::vector<Fd>
+{
+    return ring->fds();
+}
+
+void mfd::ServerBufferRing::stop()
+{
+    std::lock_guard<decltype(submission_mutex)> lock{submission_mutex};
+
+    if (!stopped)
+    {
+        stopped = true;
+        ring_dispatcher().remove_watch(ring->incoming_event());
+    }
+}
+
+void mfd::ServerBufferRing::drain_submissions()
+{
+    std::lock_guard<decltype(submission_mutex)> lock{submission_mutex};
+
+    if (stopped)
+        return;
+
+    try
+    {
+        ring->drain([this](int32_t id) { submit(mg::BufferID{static_cast<uint32_t>(id)}); });
+
+        if (ring->is_broken())
+            BOOST_THROW_EXCEPTION(std::runtime_error("Inconsistent ring indices"));
+    }
+    catch (std::exception const& error)
+    {
+        // The client can still submit through the socket; it just loses the ring
+        mir::log_warning("Stopped reading client buffer ring (%s)", error.what());
+        stopped = true;
+        ring_dispatcher().remove_watch(ring->incoming_event());
+    }
+}
+
+bool mfd::ServerBufferRing::release_is_id_only(mg::Buffer& buffer) const
+{
+    mir::protobuf::Buffer update;
+    ProtobufBufferPacker packer{&update};
+    ipc_operations->pack_buffer(packer, buffer, mg::BufferIpcMsgType::update_msg);
+
+    return update.fd_size() == 0 && update.data_size() == 0 &&
+        !update.has_stride() && !update.has_flags() && !update.has_width() && !update.has_height();
+}
+
+void mfd::ServerBufferRing::update_buffer(mg::Buffer& buffer)
+{
+    if (release_is_id_only(buffer))
+    {
+        std::lock_guard<decltype(release_mutex)> lock{release_mutex};
+        if (ring->push(buffer.id().as_value()))
+            return;
+    }
+
+    fallback->update_buffer(buffer);
+}
+
+void mfd::ServerBufferRing::send_buffer(BufferStreamId id, mg::Buffer& buffer, mg::BufferIpcMsgType type)
+{
+    fallback->send_buffer(id, buffer, type);
+}
+
+void mfd::ServerBufferRing::add_buffer(mg::Buffer& buffer)
+{
+    fallback->add_buffer(buffer);
+}
+
+void mfd::ServerBufferRing::error_buffer(
+    geometry::Size req_size, MirPixelFormat req_format, std::string const& error_msg)
+{
+    fallback->error_buffer(req_size, req_format, error_msg);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_SERVER_BUFFER_RING_H_
+#define MIR_FRONTEND_SERVER_BUFFER_RING_H_
+
+#include "mir/frontend/buffer_sink.h"
+#include "mir/graphics/buffer_id.h"
+#include "mir/fd.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mir
+{
+namespace graphics { class PlatformIpcOperations; }
+namespace frontend
+{
+class BufferRing;
+
+namespace detail
+{
+/**
+ * The server end of a BufferRing for one buffer stream.
+ *
+ * Submissions are drained on a shared "Mir/BufferRing" thread and handed to
+ * \a submit. As a BufferSink it sends buffer releases through the ring when
+ * the platform has nothing but the id to send, and otherwise (and for all
+ * other buffer messages) through \a fallback.
+ */
+class ServerBufferRing : public BufferSink
+{
+public:
+    static auto create(
+        std::function<void(graphics::BufferID)> const& submit,
+        std::shared_ptr<BufferSink> const& fallback,
+        std::shared_ptr<graphics::PlatformIpcOperations> const& ipc_operations)
+        -> std::shared_ptr<ServerBufferRing>;
+
+    ~ServerBufferRing();
+
+    /// The fds the client needs to map the ring
+    auto client_fds() const -> std::vector<Fd>;
+
+    /// Stop reading submissions. Once this returns \a submit won't be called again.
+    void stop();
+
+    void send_buffer(BufferStreamId id, graphics::Buffer& buffer, graphics::BufferIpcMsgType) override;
+    void add_buffer(graphics::Buffer&) override;
+    void error_buffer(geometry::Size req_size, MirPixelFormat req_format, std::string const& error_msg) override;
+    void update_buffer(graphics::Buffer&) override;
+
+private:
+    ServerBufferRing(
+        std::function<void(graphics::BufferID)> const& submit,
+        std::shared_ptr<BufferSink> const& fallback,
+        std::shared_ptr<graphics::PlatformIpcOperations> const& ipc_operations);
+
+    void drain_submissions();
+    bool release_is_id_only(graphics::Buffer& buffer) const;
+
+    std::function<void(graphics::BufferID)> const submit;
+    std::shared_ptr<BufferSink> const fallback;
+    std::shared_ptr<graphics::PlatformIpcOperations> const ipc_operations;
+    std::unique_ptr<BufferRing> const ring;
+
+    std::mutex submission_mutex;
+    bool stopped{false};
+
+    std::mutex release_mutex;
+};
+}
+}
+}
+
+#endif /* MIR_FRONTEND_SERVER_BUFFER_RING_H_ */
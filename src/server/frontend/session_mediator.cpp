@@ -19,6 +19,7 @@
 #include "session_mediator.h"
 #include "reordering_message_sender.h"
 #include "event_sink_factory.h"
+#include "server_buffer_ring.h"
 
 #include "mir/frontend/session_mediator_observer.h"
 #include "mir/frontend/shell.h"
@@ -147,6 +148,9 @@ mf::SessionMediator::~SessionMediator() noexcept
         shell->close_session(mir_client_session);
     }
     destroy_screencast_sessions();
+
+    for (auto const& ring : buffer_rings)
+        ring.second->stop();
 }
 
 void mf::SessionMediator::client_pid(int pid)
@@ -460,11 +464,18 @@ void mf::SessionMediator::submit_buffer(
     auto stream = mir_client_session->buffer_stream(stream_id);
 
     mfd::ProtobufBufferPacker request_msg{const_cast<mir::protobuf::Buffer*>(&request->buffer())};
-    auto b = buffer_cache.at(buffer_id);
+    auto b = [&]
+        {
+            std::lock_guard<decltype(buffer_cache_mutex)> lock{buffer_cache_mutex};
+            return buffer_cache.at(buffer_id);
+        }();
     ipc_operations->unpack_buffer(request_msg, *b);
 
     stream->submit_buffer(std::make_shared<AutoSendBuffer>(b, executor, event_sink));
 
+    if (auto const scene_session = weak_scene_session.lock())
+        anr_detector->activity_received(scene_session.get());
+
     done->Run();
 }
 
@@ -544,7 +555,10 @@ void mf::SessionMediator::allocate_buffers(
             }
 
             // TODO: Throw if insert fails (duplicate ID)?
-            buffer_cache.insert(std::make_pair(buffer->id(), buffer));
+            {
+                std::lock_guard<decltype(buffer_cache_mutex)> lock{buffer_cache_mutex};
+                buffer_cache.insert(std::make_pair(buffer->id(), buffer));
+            }
             event_sink->add_buffer(*buffer);
         }
         catch (std::exception const& err)
@@ -594,9 +608,12 @@ void mf::SessionMediator::release_buffers(
             }
         }
     }
-    for (auto const& buffer_id : to_release)
     {
-        buffer_cache.erase(buffer_id);
+        std::lock_guard<decltype(buffer_cache_mutex)> lock{buffer_cache_mutex};
+        for (auto const& buffer_id : to_release)
+        {
+            buffer_cache.erase(buffer_id);
+        }
     }
    done->Run();
 }
@@ -991,7 +1008,11 @@ void mf::SessionMediator::screencast_to_buffer(
     google::protobuf::Closure* done)
 {
     ScreencastSessionId const screencast_session_id{request->id().value()};
-    auto buffer = buffer_cache.at(mg::BufferID{request->buffer_id()});
+    auto const buffer = [&]
+        {
+            std::lock_guard<decltype(buffer_cache_mutex)> lock{buffer_cache_mutex};
+            return buffer_cache.at(mg::BufferID{request->buffer_id()});
+        }();
     screencast->capture(screencast_session_id, buffer);
     done->Run();
 }
@@ -1041,18 +1062,77 @@ void mf::SessionMediator::release_buffer_stream(
 
     auto const id = BufferStreamId(request->value());
 
+    auto const ring = buffer_rings.find(id);
+    if (ring != buffer_rings.end())
+    {
+        ring->second->stop();
+        buffer_rings.erase(ring);
+    }
+
     mir_client_session->destroy_buffer_stream(id);
 
-    auto const associated_range = stream_associated_buffers.equal_range(id) ;
-    for (auto match = associated_range.first; match != associated_range.second; ++match)
     {
-        buffer_cache.erase(match->second);
+        std::lock_guard<decltype(buffer_cache_mutex)> lock{buffer_cache_mutex};
+        auto const associated_range = stream_associated_buffers.equal_range(id) ;
+        for (auto match = associated_range.first; match != associated_range.second; ++match)
+        {
+            buffer_cache.erase(match->second);
+        }
     }
     stream_associated_buffers.erase(id);
 
     done->Run();
 }
 
+void mf::SessionMediator::create_buffer_ring(
+    mir::protobuf::BufferStreamId const* request,
+    mir::protobuf::SocketFD* response,
+    google::protobuf::Closure* done)
+{
+    auto const mir_client_session = weak_mir_client_session.lock();
+
+    if (mir_client_session.get() == nullptr)
+        BOOST_THROW_EXCEPTION(std::logic_error("Invalid application session"));
+
+    auto const stream_id = BufferStreamId(request->value());
+    auto const stream = mir_client_session->buffer_stream(stream_id);
+
+    if (buffer_rings.find(stream_id) != buffer_rings.end())
+        BOOST_THROW_EXCEPTION(std::logic_error("Buffer stream already has a ring"));
+
+    // The ring is the release sink for the buffers it submits, so that
+    // releases can come back the same way.
+    auto const ring_sink = std::make_shared<std::weak_ptr<mfd::ServerBufferRing>>();
+    auto const ring = mfd::ServerBufferRing::create(
+        [this, stream, ring_sink](mg::BufferID buffer_id)
+        {
+            auto const buffer = [&]
+                {
+                    std::lock_guard<decltype(buffer_cache_mutex)> lock{buffer_cache_mutex};
+                    return buffer_cache.at(buffer_id);
+                }();
+
+            std::shared_ptr<mf::BufferSink> sink = ring_sink->lock();
+            if (!sink)
+                sink = event_sink;
+
+            stream->submit_buffer(std::make_shared<AutoSendBuffer>(buffer, executor, sink));
+        },
+        event_sink,
+        ipc_operations);
+    *ring_sink = ring;
+
+    buffer_rings[stream_id] = ring;
+
+    for (auto const& fd : ring->client_fds())
+    {
+        response->add_fd(fd);
+        resource_cache->save_fd(response, fd);
+    }
+
+    done->Run();
+}
+
 
 auto mf::SessionMediator::prompt_session_connect_handler(detail::PromptSessionId prompt_session_id) const
 -> std::function<void(std::shared_ptr<scene::Session> const&)>
@@ -85,6 +85,8 @@ class BufferMap;
 
 namespace detail
 {
+class ServerBufferRing;
+
 typedef IntWrapper<struct PromptSessionTag> PromptSessionId;
 
 struct PromptSessionStore
@@ -213,6 +215,10 @@ public:
         mir::protobuf::BufferStreamId const* request,
         mir::protobuf::Void* response,
         google::protobuf::Closure* done) override;
+    void create_buffer_ring(
+        mir::protobuf::BufferStreamId const* request,
+        mir::protobuf::SocketFD* response,
+        google::protobuf::Closure* done) override;
     void configure_cursor(
         mir::protobuf::CursorSetting const* request,
         mir::protobuf::Void* response,
@@ -305,6 +311,8 @@ private:
     std::shared_ptr<cookie::Authority> const cookie_authority;
     std::shared_ptr<InputConfigurationChanger> const input_changer;
     std::vector<mir::ExtensionDescription> const extensions;
+    // Guards buffer_cache: buffer rings submit from their own thread
+    std::mutex buffer_cache_mutex;
     std::unordered_map<graphics::BufferID, std::shared_ptr<graphics::Buffer>> buffer_cache;
     std::unordered_multimap<BufferStreamId, graphics::BufferID> stream_associated_buffers;
     std::shared_ptr<graphics::GraphicBufferAllocator> const allocator;
@@ -317,6 +325,7 @@ private:
     detail::PromptSessionStore prompt_sessions;
 
     std::map<frontend::SurfaceId, frontend::BufferStreamId> legacy_default_stream_map;
+    std::map<BufferStreamId, std::shared_ptr<detail::ServerBufferRing>> buffer_rings;
 };
 
 }
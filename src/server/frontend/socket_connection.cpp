@@ -24,8 +24,6 @@
 #include "mir/protobuf/protocol_version.h"
 #include "mir/log.h"
 
-#include "mir_protobuf_wire.pb.h"
-
 #include <boost/signals2.hpp>
 #include <boost/throw_exception.hpp>
 
@@ -73,19 +71,20 @@ void mfd::SocketConnection::on_read_size(const boost::system::error_code& error)
 
     unsigned char const high_byte = header[0];
     unsigned char const low_byte = header[1];
-    size_t const body_size = (high_byte << 8) + low_byte;
+    body_size = (high_byte << 8) + low_byte;
 
-    body.resize(body_size);
+    if (body.size() < body_size)
+        body.resize(body_size);
 
     if (message_receiver->available_bytes() >= body_size)
     {
-        on_new_message(message_receiver->receive_msg(ba::buffer(body)));
+        on_new_message(message_receiver->receive_msg(ba::buffer(body.data(), body_size)));
     }
     else
     {
         auto callback = std::bind(&mfd::SocketConnection::on_new_message,
                                   this, std::placeholders::_1);
-        message_receiver->async_receive_msg(callback, ba::buffer(body));
+        message_receiver->async_receive_msg(callback, ba::buffer(body.data(), body_size));
     }
 }
 
@@ -97,8 +96,7 @@ try
         BOOST_THROW_EXCEPTION(std::runtime_error(error.message()));
     }
 
-    mir::protobuf::wire::Invocation invocation;
-    invocation.ParseFromArray(body.data(), body.size());
+    invocation.ParseFromArray(body.data(), body_size);
 
     int const v = invocation.has_protocol_version() ?
                   invocation.protocol_version() :
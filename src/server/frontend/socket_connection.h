@@ -22,6 +22,8 @@
 
 #include "mir/frontend/connections.h"
 
+#include "mir_protobuf_wire.pb.h"
+
 #include <boost/asio.hpp>
 
 #include <sys/types.h>
@@ -62,7 +64,12 @@ private:
 
     static size_t const header_size = 2;
     char header[header_size];
+
+    // Both are reused from message to message: the body only ever grows and
+    // parsing into the same Invocation keeps its string storage.
     std::vector<char> body;
+    size_t body_size = 0;
+    mir::protobuf::wire::Invocation invocation;
 
     int client_pid = 0;
 };
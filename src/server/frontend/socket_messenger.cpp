@@ -17,15 +17,16 @@
  */
 
 #include "socket_messenger.h"
-#include "mir/frontend/client_constants.h"
-#include "mir/variable_length_array.h"
 #include "mir/fd_socket_transmission.h"
 #include "mir/raii.h"
 
 #include <boost/throw_exception.hpp>
+#include <boost/version.hpp>
 
 #include <errno.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <stdexcept>
 
@@ -34,9 +35,22 @@ namespace mfd = mf::detail;
 namespace bs = boost::system;
 namespace ba = boost::asio;
 
+namespace
+{
+ba::io_service& io_service_of(ba::local::stream_protocol::socket& socket)
+{
+#if BOOST_VERSION >= 107000
+    return static_cast<ba::io_service&>(socket.get_executor().context());
+#else
+    return socket.get_io_service();
+#endif
+}
+}
+
 mfd::SocketMessenger::SocketMessenger(std::shared_ptr<ba::local::stream_protocol::socket> const& socket)
     : socket(socket),
-      socket_fd{IntOwnedFd{socket->native_handle()}}
+      socket_fd{IntOwnedFd{socket->native_handle()}},
+      strand{io_service_of(*socket)}
 {
     // Make the socket non-blocking to avoid hanging the server when a client
     // is unresponsive. Also increase the send buffer size to 64KiB to allow
@@ -74,11 +88,15 @@ mf::SessionCredentials mfd::SocketMessenger::client_creds()
 void mfd::SocketMessenger::send(char const* data, size_t length, FdSets const& fd_set)
 {
     static size_t const header_size{2};
-    mir::VariableLengthArray<mf::serialization_buffer_size> whole_message{header_size + length};
+    unsigned char const header[header_size] = {
+        static_cast<unsigned char>((length >> 8) & 0xff),
+        static_cast<unsigned char>((length >> 0) & 0xff)};
 
-    whole_message.data()[0] = static_cast<unsigned char>((length >> 8) & 0xff);
-    whole_message.data()[1] = static_cast<unsigned char>((length >> 0) & 0xff);
-    std::copy(data, data + length, whole_message.data() + header_size);
+    // Gather the header and payload straight from where they are, rather
+    // than copying them into one buffer first.
+    iovec message[] = {
+        {const_cast<unsigned char*>(header), header_size},
+        {const_cast<char*>(data), length}};
 
     std::unique_lock<std::mutex> lg(message_lock);
 
@@ -87,12 +105,46 @@ void mfd::SocketMessenger::send(char const* data, size_t length, FdSets const& f
     // function has completed (if it would be executed asynchronously.
     // NOTE: we rely on this synchronous behavior as per the comment in
     // mf::SessionMediator::create_surface
-    ba::write(*socket, ba::buffer(whole_message.data(), whole_message.size()));
+    send_all(message, 2);
 
+    // The client reads each fd set with its own recvmsg() after the message,
+    // so the sets can't share a sendmsg() with the payload or each other.
     for (auto const& fds : fd_set)
         mir::send_fds(socket_fd, fds);
 }
 
+void mfd::SocketMessenger::send_all(iovec* iov, size_t iovlen)
+{
+    msghdr header{};
+
+    while (iovlen > 0)
+    {
+        header.msg_iov = iov;
+        header.msg_iovlen = iovlen;
+
+        auto sent = sendmsg(socket_fd, &header, MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            BOOST_THROW_EXCEPTION((bs::system_error{errno, bs::system_category(), "Failed to send message"}));
+        }
+
+        // Skip past whatever made it into the socket on a short write
+        while (iovlen > 0 && static_cast<size_t>(sent) >= iov->iov_len)
+        {
+            sent -= iov->iov_len;
+            ++iov;
+            --iovlen;
+        }
+        if (iovlen > 0)
+        {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + sent;
+            iov->iov_len -= sent;
+        }
+    }
+}
+
 void mfd::SocketMessenger::async_receive_msg(
     MirReadHandler const& handler,
     ba::mutable_buffers_1 const& buffer)
@@ -101,7 +153,7 @@ void mfd::SocketMessenger::async_receive_msg(
          *socket,
          buffer,
          boost::asio::transfer_exactly(ba::buffer_size(buffer)),
-         handler);
+         strand.wrap(handler));
 }
 
 bs::error_code mfd::SocketMessenger::receive_msg(
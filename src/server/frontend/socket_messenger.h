@@ -23,6 +23,8 @@
 #include "mir/frontend/session_credentials.h"
 #include <mutex>
 
+struct iovec;
+
 namespace mir
 {
 namespace frontend
@@ -44,6 +46,7 @@ public:
     void receive_fds(std::vector<Fd>& fds) override;
 
 private:
+    void send_all(iovec* iov, size_t iovlen);
     void set_passcred(int opt);
     void update_session_creds();
     SessionCredentials creator_creds() const;
@@ -51,6 +54,10 @@ private:
     std::shared_ptr<boost::asio::local::stream_protocol::socket> socket;
     mir::Fd socket_fd;
 
+    /// The connector may run the io_service on several threads; this keeps
+    /// the handlers for this client running one at a time, in order.
+    boost::asio::io_service::strand strand;
+
     std::mutex message_lock;
     SessionCredentials session_creds{0, 0, 0};
 };
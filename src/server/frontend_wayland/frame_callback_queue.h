@@ -0,0 +1,90 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_FRAME_CALLBACK_QUEUE_H_
+#define MIR_FRONTEND_FRAME_CALLBACK_QUEUE_H_
+
+#include <vector>
+
+namespace mir
+{
+namespace frontend
+{
+/**
+ * The frame callbacks a surface has yet to send.
+ *
+ * Callbacks committed with a buffer are due once that buffer is consumed.
+ * Callbacks committed without one are due straight away, unless the surface
+ * is not exposed (nothing of it is being composited), in which case they are
+ * withheld until it is exposed again or a buffer is consumed. As before
+ * withholding was added, a commit without a buffer on an exposed surface
+ * makes everything queued due.
+ */
+template<typename Callback>
+class FrameCallbackQueue
+{
+public:
+    using Callbacks = std::vector<Callback>;
+
+    bool exposed() const { return exposed_; }
+
+    /// Queue callbacks committed along with a buffer
+    void add_with_buffer(Callbacks const& callbacks)
+    {
+        append(awaiting_buffer, callbacks);
+    }
+
+    /// \return the callbacks due now that \a callbacks were committed without a buffer
+    auto add_without_buffer(Callbacks const& callbacks) -> Callbacks
+    {
+        append(awaiting_exposure, callbacks);
+        return exposed_ ? take_all() : Callbacks{};
+    }
+
+    /// \return the callbacks due now that a buffer has been consumed (or removed)
+    auto take_all() -> Callbacks
+    {
+        Callbacks due;
+        due.swap(awaiting_buffer);
+        append(due, awaiting_exposure);
+        awaiting_exposure.clear();
+        return due;
+    }
+
+    /// \return the callbacks due now that the surface is \a exposed (or not)
+    auto set_exposed(bool exposed) -> Callbacks
+    {
+        Callbacks due;
+        if (exposed && !exposed_)
+            due.swap(awaiting_exposure);
+        exposed_ = exposed;
+        return due;
+    }
+
+private:
+    static void append(Callbacks& to, Callbacks const& from)
+    {
+        to.insert(end(to), begin(from), end(from));
+    }
+
+    Callbacks awaiting_buffer;
+    Callbacks awaiting_exposure;
+    bool exposed_{true};
+};
+}
+}
+
+#endif // MIR_FRONTEND_FRAME_CALLBACK_QUEUE_H_
@@ -0,0 +1,114 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_POINTER_EVENT_COALESCER_H_
+#define MIR_FRONTEND_POINTER_EVENT_COALESCER_H_
+
+#include "mir/geometry/point.h"
+#include "mir/geometry/displacement.h"
+
+#include <chrono>
+#include <experimental/optional>
+
+namespace mir
+{
+namespace frontend
+{
+/**
+ * Holds back pointer motion and scrolling so a client is sent one motion
+ * and one set of axis events (then a frame) per flush, instead of one per
+ * input event.
+ *
+ * Motion is absolute, so only the latest position is kept. Scrolling is
+ * relative, so the deltas are summed. Anything else must not overtake what
+ * is held back, so it goes through send_after_held() (or follows a flush()).
+ *
+ * Sink provides send_motion(ms, Point), send_axis(ms, Displacement) and
+ * frame(). When disabled, motion and scrolling go straight to the sink.
+ */
+template<typename Sink>
+class PointerEventCoalescer
+{
+public:
+    PointerEventCoalescer(Sink& sink, bool enabled) : sink{sink}, enabled{enabled} {}
+
+    void motion(std::chrono::milliseconds const& ms, geometry::Point const& position)
+    {
+        if (!enabled)
+            return sink.send_motion(ms, position);
+
+        held_or_new(ms).position = position;
+    }
+
+    void axis(std::chrono::milliseconds const& ms, geometry::Displacement const& scroll)
+    {
+        if (!enabled)
+            return sink.send_axis(ms, scroll);
+
+        auto& motion = held_or_new(ms);
+        motion.scroll = motion.scroll + scroll;
+    }
+
+    bool holding() const { return static_cast<bool>(held); }
+
+    /// Sends whatever is held back, followed by a frame
+    void flush()
+    {
+        if (!held)
+            return;
+
+        auto const motion = held.value();
+        held = std::experimental::nullopt;
+
+        if (motion.position)
+            sink.send_motion(motion.time, motion.position.value());
+        if (motion.scroll != geometry::Displacement{})
+            sink.send_axis(motion.time, motion.scroll);
+        sink.frame();
+    }
+
+    /// Calls \a send (for a button, enter, leave...) once whatever is held back has been sent
+    template<typename Send>
+    void send_after_held(Send const& send)
+    {
+        flush();
+        send();
+    }
+
+private:
+    struct Motion
+    {
+        std::chrono::milliseconds time;
+        std::experimental::optional<geometry::Point> position;
+        geometry::Displacement scroll;
+    };
+
+    Motion& held_or_new(std::chrono::milliseconds const& ms)
+    {
+        if (!held)
+            held = Motion{ms, {}, {}};
+        held.value().time = ms;
+        return held.value();
+    }
+
+    Sink& sink;
+    bool const enabled;
+    std::experimental::optional<Motion> held;
+};
+}
+}
+
+#endif // MIR_FRONTEND_POINTER_EVENT_COALESCER_H_
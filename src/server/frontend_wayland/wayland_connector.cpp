@@ -239,10 +239,12 @@ public:
     WlCompositor(
         struct wl_display* display,
         std::shared_ptr<mir::Executor> const& executor,
-        std::shared_ptr<mg::WaylandAllocator> const& allocator)
+        std::shared_ptr<mg::WaylandAllocator> const& allocator,
+        std::shared_ptr<ms::ApplicationNotRespondingDetector> const& anr_detector)
         : Global(display, Version<4>()),
           allocator{allocator},
-          executor{executor}
+          executor{executor},
+          anr_detector{anr_detector}
     {
     }
 
@@ -251,6 +253,7 @@ public:
 private:
     std::shared_ptr<mg::WaylandAllocator> const allocator;
     std::shared_ptr<mir::Executor> const executor;
+    std::shared_ptr<ms::ApplicationNotRespondingDetector> const anr_detector;
     std::map<std::pair<wl_client*, uint32_t>, std::vector<std::function<void(WlSurface*)>>> surface_callbacks;
 
     class Instance : wayland::Compositor
@@ -290,7 +293,7 @@ void WlCompositor::on_surface_created(wl_client* client, uint32_t id, std::funct
 
 void WlCompositor::Instance::create_surface(wl_resource* new_surface)
 {
-    auto const surface = new WlSurface{new_surface, compositor->executor, compositor->allocator};
+    auto const surface = new WlSurface{new_surface, compositor->executor, compositor->allocator, compositor->anr_detector};
     auto const key = std::make_pair(wl_resource_get_client(new_surface), wl_resource_get_id(new_surface));
     auto const callbacks = compositor->surface_callbacks.find(key);
     if (callbacks != compositor->surface_callbacks.end())
@@ -659,9 +662,12 @@ mf::WaylandConnector::WaylandConnector(
     std::shared_ptr<mi::Seat> const& seat,
     std::shared_ptr<mg::GraphicBufferAllocator> const& allocator,
     std::shared_ptr<mf::SessionAuthorizer> const& session_authorizer,
+    std::shared_ptr<ms::ApplicationNotRespondingDetector> const& anr_detector,
     bool arw_socket,
     std::unique_ptr<WaylandExtensions> extensions_,
-    WaylandProtocolExtensionFilter const& extension_filter)
+    WaylandProtocolExtensionFilter const& extension_filter,
+    std::chrono::milliseconds pointer_coalescing_interval,
+    PointerCoalescingFilter const& pointer_coalescing_filter)
     : display{wl_display_create(), &cleanup_display},
       pause_signal{eventfd(0, EFD_CLOEXEC | EFD_SEMAPHORE)},
       executor{std::make_shared<WaylandExecutor>(wl_display_get_event_loop(display.get()))},
@@ -708,9 +714,21 @@ mf::WaylandConnector::WaylandConnector(
     compositor_global = std::make_unique<mf::WlCompositor>(
         display.get(),
         executor,
-        this->allocator);
+        this->allocator,
+        anr_detector);
     subcompositor_global = std::make_unique<mf::WlSubcompositor>(display.get());
-    seat_global = std::make_unique<mf::WlSeat>(display.get(), input_hub, seat, executor);
+    seat_global = std::make_unique<mf::WlSeat>(
+        display.get(),
+        input_hub,
+        seat,
+        executor,
+        [pointer_coalescing_interval, pointer_coalescing_filter](wl_client* client)
+        {
+            if (pointer_coalescing_interval.count() > 0 && pointer_coalescing_filter(get_session(client)))
+                return pointer_coalescing_interval;
+            else
+                return std::chrono::milliseconds::zero();
+        });
     output_manager = std::make_unique<mf::OutputManager>(
         display.get(),
         display_config,
@@ -26,6 +26,7 @@
 #include <wayland-server-core.h>
 #include <unordered_map>
 #include <thread>
+#include <chrono>
 #include <vector>
 #include <mir/server_configuration.h>
 
@@ -53,6 +54,7 @@ class Shell;
 }
 namespace scene
 {
+class ApplicationNotRespondingDetector;
 class Surface;
 }
 namespace frontend
@@ -94,6 +96,7 @@ class WaylandConnector : public Connector
 {
 public:
     using WaylandProtocolExtensionFilter = std::function<bool(std::shared_ptr<scene::Session> const&, char const*)>;
+    using PointerCoalescingFilter = std::function<bool(std::shared_ptr<scene::Session> const&)>;
 
     WaylandConnector(
         std::shared_ptr<shell::Shell> const& shell,
@@ -102,9 +105,12 @@ public:
         std::shared_ptr<input::Seat> const& seat,
         std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator,
         std::shared_ptr<SessionAuthorizer> const& session_authorizer,
+        std::shared_ptr<scene::ApplicationNotRespondingDetector> const& anr_detector,
         bool arw_socket,
         std::unique_ptr<WaylandExtensions> extensions,
-        WaylandProtocolExtensionFilter const& extension_filter);
+        WaylandProtocolExtensionFilter const& extension_filter,
+        std::chrono::milliseconds pointer_coalescing_interval,
+        PointerCoalescingFilter const& pointer_coalescing_filter);
 
     ~WaylandConnector() override;
 
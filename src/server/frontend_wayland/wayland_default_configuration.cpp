@@ -158,9 +158,12 @@ std::shared_ptr<mf::Connector>
                 the_seat(),
                 the_buffer_allocator(),
                 the_session_authorizer(),
+                the_application_not_responding_detector(),
                 arw_socket,
                 configure_wayland_extensions(wayland_extensions, options->is_set(mo::x11_display_opt), wayland_extension_hooks),
-                wayland_extension_filter);
+                wayland_extension_filter,
+                std::chrono::milliseconds{options->get<int>(mo::coalesce_pointer_events_opt)},
+                wayland_pointer_coalescing_filter);
         });
 }
 
@@ -178,6 +181,12 @@ void mir::DefaultServerConfiguration::set_wayland_extension_filter(WaylandProtoc
     wayland_extension_filter = extension_filter;
 }
 
+void mir::DefaultServerConfiguration::set_wayland_pointer_coalescing_filter(
+    WaylandPointerCoalescingFilter const& filter)
+{
+    wayland_pointer_coalescing_filter = filter;
+}
+
 void mir::DefaultServerConfiguration::set_enabled_wayland_extensions(std::vector<std::string> const& extensions)
 {
     enabled_wayland_extensions = extensions;
@@ -99,12 +99,14 @@ void mf::WaylandInputDispatcher::handle_input_event(MirInputEvent const* event)
     switch (mir_input_event_get_type(event))
     {
     case mir_input_event_type_key:
+        flush_coalesced_pointer_events();
         handle_keyboard_event(ms, mir_input_event_get_keyboard_event(event));
         break;
     case mir_input_event_type_pointer:
         handle_pointer_event(ms, mir_input_event_get_pointer_event(event));
         break;
     case mir_input_event_type_touch:
+        flush_coalesced_pointer_events();
         handle_touch_event(ms, mir_input_event_get_touch_event(event));
         break;
     default:
@@ -112,6 +114,15 @@ void mf::WaylandInputDispatcher::handle_input_event(MirInputEvent const* event)
     }
 }
 
+void mf::WaylandInputDispatcher::flush_coalesced_pointer_events()
+{
+    // Events held back by pointer coalescing must not be overtaken by other input
+    seat->for_each_listener(client, [](WlPointer* pointer)
+        {
+            pointer->flush_coalesced();
+        });
+}
+
 void mf::WaylandInputDispatcher::handle_keyboard_event(std::chrono::milliseconds const& ms, MirKeyboardEvent const* event)
 {
     MirKeyboardAction const action = mir_keyboard_event_action(event);
@@ -19,6 +19,7 @@
 
 #include "wayland_surface_observer.h"
 #include "wl_seat.h"
+#include "wl_surface.h"
 #include "wayland_utils.h"
 #include "window_wl_surface_role.h"
 #include "wayland_input_dispatcher.h"
@@ -39,6 +40,7 @@ mf::WaylandSurfaceObserver::WaylandSurfaceObserver(
     WlSurface* surface,
     WindowWlSurfaceRole* window)
     : seat{seat},
+      surface{surface},
       window{window},
       input_dispatcher{std::make_unique<WaylandInputDispatcher>(seat, surface)},
       window_size{geometry::Size{0,0}},
@@ -69,6 +71,15 @@ void mf::WaylandSurfaceObserver::attrib_changed(ms::Surface const*, MirWindowAtt
             {
                 current_state = static_cast<MirWindowState>(value);
                 window->handle_state_change(current_state);
+                update_exposure();
+            });
+        break;
+
+    case mir_window_attrib_visibility:
+        run_on_wayland_thread_unless_destroyed([this, value]()
+            {
+                current_visibility = static_cast<MirWindowVisibility>(value);
+                update_exposure();
             });
         break;
 
@@ -137,6 +148,15 @@ void mf::WaylandSurfaceObserver::input_consumed(ms::Surface const*, MirEvent con
         });
 }
 
+void mf::WaylandSurfaceObserver::update_exposure()
+{
+    auto const hidden =
+        current_state == mir_window_state_minimized ||
+        current_state == mir_window_state_hidden;
+
+    surface->set_exposed(current_visibility == mir_window_visibility_exposed && !hidden);
+}
+
 auto mf::WaylandSurfaceObserver::latest_timestamp() const -> std::chrono::nanoseconds
 {
     return input_dispatcher->latest_timestamp();
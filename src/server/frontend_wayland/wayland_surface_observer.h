@@ -82,14 +82,17 @@ public:
 
 private:
     WlSeat* const seat; // only used by run_on_wayland_thread_unless_destroyed()
+    WlSurface* const surface;
     WindowWlSurfaceRole* const window;
     std::unique_ptr<WaylandInputDispatcher> const input_dispatcher;
 
     geometry::Size window_size;
     std::experimental::optional<geometry::Size> requested_size;
     MirWindowState current_state{mir_window_state_unknown};
+    MirWindowVisibility current_visibility{mir_window_visibility_exposed};
     std::shared_ptr<bool> const destroyed;
 
+    void update_exposure();
     void run_on_wayland_thread_unless_destroyed(std::function<void()>&& work);
 };
 }
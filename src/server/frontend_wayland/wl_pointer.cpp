@@ -117,16 +117,21 @@ struct NullCursor : mf::WlPointer::Cursor
 
 mf::WlPointer::WlPointer(
     wl_resource* new_resource,
-    std::function<void(WlPointer*)> const& on_destroy)
+    std::function<void(WlPointer*)> const& on_destroy,
+    std::chrono::milliseconds coalescing_interval)
     : Pointer(new_resource, Version<6>()),
       display{wl_client_get_display(client)},
       on_destroy{on_destroy},
+      coalescing_interval{coalescing_interval},
+      coalescer{*this, coalescing_interval.count() != 0},
       cursor{std::make_unique<NullCursor>()}
 {
 }
 
 mf::WlPointer::~WlPointer()
 {
+    if (coalescing_timer)
+        wl_event_source_remove(coalescing_timer);
     if (surface_under_cursor)
         surface_under_cursor.value()->remove_destroy_listener(this);
     on_destroy(this);
@@ -138,11 +143,14 @@ void mf::WlPointer::enter(WlSurface* parent_surface, geom::Point const& position
     auto const final = parent_surface->transform_point(position_on_parent);
 
     cursor->apply_to(final.surface);
-    send_enter_event(
-        serial,
-        final.surface->raw_resource(),
-        final.position.x.as_int(),
-        final.position.y.as_int());
+    coalescer.send_after_held([&]
+        {
+            send_enter_event(
+                serial,
+                final.surface->raw_resource(),
+                final.position.x.as_int(),
+                final.position.y.as_int());
+        });
     can_send_frame = true;
     final.surface->add_destroy_listener(
         this,
@@ -159,9 +167,12 @@ void mf::WlPointer::leave()
         return;
     surface_under_cursor.value()->remove_destroy_listener(this);
     auto const serial = wl_display_next_serial(display);
-    send_leave_event(
-        serial,
-        surface_under_cursor.value()->raw_resource());
+    coalescer.send_after_held([&]
+        {
+            send_leave_event(
+                serial,
+                surface_under_cursor.value()->raw_resource());
+        });
     can_send_frame = true;
     surface_under_cursor = std::experimental::nullopt;
 }
@@ -171,7 +182,7 @@ void mf::WlPointer::button(std::chrono::milliseconds const& ms, uint32_t button,
     auto const serial = wl_display_next_serial(display);
     auto const state = pressed ? ButtonState::pressed : ButtonState::released;
 
-    send_button_event(serial, ms.count(), button, state);
+    coalescer.send_after_held([&] { send_button_event(serial, ms.count(), button, state); });
     can_send_frame = true;
 }
 
@@ -184,11 +195,7 @@ void mf::WlPointer::motion(
 
     if (surface_under_cursor && final.surface == surface_under_cursor.value())
     {
-        send_motion_event(
-            ms.count(),
-            final.position.x.as_int(),
-            final.position.y.as_int());
-        can_send_frame = true;
+        coalescer.motion(ms, final.position);
     }
     else
     {
@@ -198,6 +205,65 @@ void mf::WlPointer::motion(
 }
 
 void mf::WlPointer::axis(std::chrono::milliseconds const& ms, geometry::Displacement const& scroll)
+{
+    coalescer.axis(ms, scroll);
+}
+
+void mf::WlPointer::frame()
+{
+    if (coalescer.holding() && !coalescing_deadline_armed)
+    {
+        // Held back until the deadline, or until something that must not overtake it arrives
+        if (!coalescing_timer)
+        {
+            coalescing_timer = wl_event_loop_add_timer(
+                wl_display_get_event_loop(display),
+                &coalescing_deadline,
+                this);
+        }
+        if (coalescing_timer)
+        {
+            wl_event_source_timer_update(coalescing_timer, coalescing_interval.count());
+            coalescing_deadline_armed = true;
+        }
+        else
+        {
+            flush_coalesced();
+        }
+    }
+    else if (!coalescer.holding() && coalescing_deadline_armed)
+    {
+        // Everything held back has been sent, so the deadline has nothing left to do
+        wl_event_source_timer_update(coalescing_timer, 0);
+        coalescing_deadline_armed = false;
+    }
+
+    if (can_send_frame && version_supports_frame())
+        send_frame_event();
+    can_send_frame = false;
+}
+
+void mf::WlPointer::flush_coalesced()
+{
+    coalescer.flush();
+}
+
+int mf::WlPointer::coalescing_deadline(void* data)
+{
+    static_cast<WlPointer*>(data)->flush_coalesced();
+    return 0;
+}
+
+void mf::WlPointer::send_motion(std::chrono::milliseconds const& ms, geom::Point const& position)
+{
+    send_motion_event(
+        ms.count(),
+        position.x.as_int(),
+        position.y.as_int());
+    can_send_frame = true;
+}
+
+void mf::WlPointer::send_axis(std::chrono::milliseconds const& ms, geom::Displacement const& scroll)
 {
     if (scroll.dx != geom::DeltaX{})
     {
@@ -218,13 +284,6 @@ void mf::WlPointer::axis(std::chrono::milliseconds const& ms, geometry::Displace
     }
 }
 
-void mf::WlPointer::frame()
-{
-    if (can_send_frame && version_supports_frame())
-        send_frame_event();
-    can_send_frame = false;
-}
-
 namespace
 {
 struct WlSurfaceCursor : mf::WlPointer::Cursor
@@ -21,6 +21,7 @@
 
 
 #include "wayland_wrapper.h"
+#include "pointer_event_coalescer.h"
 
 #include "mir/geometry/point.h"
 #include "mir/geometry/displacement.h"
@@ -46,9 +47,12 @@ class WlPointer : public wayland::Pointer
 {
 public:
 
+    /// \param coalescing_interval if non-zero, motion and axis events are held back for up to
+    ///                            this long and merged, so the client sees one frame per interval
     WlPointer(
         wl_resource* new_resource,
-        std::function<void(WlPointer*)> const& on_destroy);
+        std::function<void(WlPointer*)> const& on_destroy,
+        std::chrono::milliseconds coalescing_interval);
 
     ~WlPointer();
 
@@ -66,6 +70,9 @@ public:
     void axis(std::chrono::milliseconds const& ms, geometry::Displacement const& scroll);
     void frame();
 
+    /// Sends any motion and axis events held back by coalescing
+    void flush_coalesced();
+
     struct Cursor;
 
 private:
@@ -75,6 +82,16 @@ private:
     bool can_send_frame{false};
     std::experimental::optional<WlSurface*> surface_under_cursor;
 
+    friend class PointerEventCoalescer<WlPointer>;
+    std::chrono::milliseconds const coalescing_interval;
+    PointerEventCoalescer<WlPointer> coalescer;
+    wl_event_source* coalescing_timer{nullptr};
+    bool coalescing_deadline_armed{false};
+
+    void send_motion(std::chrono::milliseconds const& ms, geometry::Point const& position);
+    void send_axis(std::chrono::milliseconds const& ms, geometry::Displacement const& scroll);
+    static int coalescing_deadline(void* data);
+
     /// Wayland request handlers
     ///@{
     void set_cursor(
@@ -158,7 +158,8 @@ mf::WlSeat::WlSeat(
     wl_display* display,
     std::shared_ptr<mi::InputDeviceHub> const& input_hub,
     std::shared_ptr<mi::Seat> const& seat,
-    std::shared_ptr<mir::Executor> const& executor)
+    std::shared_ptr<mir::Executor> const& executor,
+    std::function<std::chrono::milliseconds(wl_client*)> const& pointer_coalescing_interval_for)
     :   Global(display, Version<6>()),
         keymap{std::make_unique<input::Keymap>()},
         config_observer{
@@ -173,7 +174,8 @@ mf::WlSeat::WlSeat(
         touch_listeners{std::make_shared<ListenerList<WlTouch>>()},
         input_hub{input_hub},
         seat{seat},
-        executor{executor}
+        executor{executor},
+        pointer_coalescing_interval_for{pointer_coalescing_interval_for}
 {
     input_hub->add_observer(config_observer);
     add_focus_listener(&focus);
@@ -243,7 +245,8 @@ void mf::WlSeat::Instance::get_pointer(wl_resource* new_pointer)
             [listeners = seat->pointer_listeners, client = client](WlPointer* listener)
             {
                 listeners->unregister_listener(client, listener);
-            }});
+            },
+            seat->pointer_coalescing_interval_for(client)});
 }
 
 void mf::WlSeat::Instance::get_keyboard(wl_resource* new_keyboard)
@@ -24,6 +24,7 @@
 #include <unordered_map>
 #include <vector>
 #include <functional>
+#include <chrono>
 
 // from "mir_toolkit/events/event.h"
 struct MirInputEvent;
@@ -54,7 +55,8 @@ public:
         wl_display* display,
         std::shared_ptr<mir::input::InputDeviceHub> const& input_hub,
         std::shared_ptr<mir::input::Seat> const& seat,
-        std::shared_ptr<mir::Executor> const& executor);
+        std::shared_ptr<mir::Executor> const& executor,
+        std::function<std::chrono::milliseconds(wl_client*)> const& pointer_coalescing_interval_for);
 
     ~WlSeat();
 
@@ -116,6 +118,9 @@ private:
 
     std::shared_ptr<mir::Executor> const executor;
 
+    /// How long pointer motion may be held back for each client (zero for never)
+    std::function<std::chrono::milliseconds(wl_client*)> const pointer_coalescing_interval_for;
+
     void bind(wl_resource* new_wl_seat) override;
 
 };
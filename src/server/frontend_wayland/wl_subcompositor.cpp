@@ -80,6 +80,7 @@ mf::WlSubsurface::WlSubsurface(wl_resource* new_subsurface, WlSurface* surface,
 {
     surface->set_role(this);
     surface->pending_invalidate_surface_data();
+    surface->set_exposed(parent_surface->exposed());
 }
 
 mf::WlSubsurface::~WlSubsurface()
@@ -116,6 +117,11 @@ void mf::WlSubsurface::parent_has_committed()
     }
 }
 
+void mf::WlSubsurface::parent_exposure_changed(bool exposed)
+{
+    surface->set_exposed(exposed);
+}
+
 mf::WlSurface::Position mf::WlSubsurface::transform_point(geom::Point point)
 {
     return surface->transform_point(point);
@@ -63,6 +63,7 @@ public:
     auto scene_surface() const -> std::experimental::optional<std::shared_ptr<scene::Surface>> override;
 
     void parent_has_committed();
+    void parent_exposure_changed(bool exposed);
 
     WlSurface::Position transform_point(geometry::Point point);
 
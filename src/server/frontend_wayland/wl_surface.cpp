@@ -30,6 +30,7 @@
 #include "wayland_frontend.tp.h"
 
 #include "mir/graphics/buffer_properties.h"
+#include "mir/scene/application_not_responding_detector.h"
 #include "mir/scene/session.h"
 #include "mir/frontend/wayland.h"
 #include "mir/compositor/buffer_stream.h"
@@ -81,12 +82,14 @@ bool mf::WlSurfaceState::surface_data_needs_refresh() const
 mf::WlSurface::WlSurface(
     wl_resource* new_resource,
     std::shared_ptr<Executor> const& executor,
-    std::shared_ptr<graphics::WaylandAllocator> const& allocator)
+    std::shared_ptr<graphics::WaylandAllocator> const& allocator,
+    std::shared_ptr<scene::ApplicationNotRespondingDetector> const& anr_detector)
     : Surface(new_resource, Version<4>()),
         session{get_session(client)},
         stream{session->create_buffer_stream({{}, mir_pixel_format_invalid, graphics::BufferUsage::undefined})},
         allocator{allocator},
         executor{executor},
+        anr_detector{anr_detector},
         null_role{this},
         role{&null_role},
         destroyed{std::make_shared<bool>(false)}
@@ -150,6 +153,8 @@ void mf::WlSurface::set_role(WlSurfaceRole* role_)
 void mf::WlSurface::clear_role()
 {
     role = &null_role;
+    // Without a role we get no visibility information, so don't hold on to callbacks
+    set_exposed(true);
 }
 
 void mf::WlSurface::set_pending_offset(std::experimental::optional<geom::Displacement> const& offset)
@@ -218,15 +223,27 @@ void mf::WlSurface::remove_destroy_listener(void const* key)
     destroy_listeners.erase(key);
 }
 
+void mf::WlSurface::set_exposed(bool exposed)
+{
+    if (exposed == frame_callbacks.exposed())
+        return;
+
+    // Only the callbacks withheld while hidden; any waiting on a buffer still wait for it to be consumed
+    send_frame_callbacks(frame_callbacks.set_exposed(exposed));
+
+    for (WlSubsurface* child : children)
+        child->parent_exposure_changed(exposed);
+}
+
 mf::WlSurface* mf::WlSurface::from(wl_resource* resource)
 {
     void* raw_surface = wl_resource_get_user_data(resource);
     return static_cast<WlSurface*>(static_cast<wayland::Surface*>(raw_surface));
 }
 
-void mf::WlSurface::send_frame_callbacks()
+void mf::WlSurface::send_frame_callbacks(std::vector<std::shared_ptr<WlSurfaceState::Callback>> const& callbacks)
 {
-    for (auto const& frame : frame_callbacks)
+    for (auto const& frame : callbacks)
     {
         if (!*frame->destroyed)
         {
@@ -235,7 +252,6 @@ void mf::WlSurface::send_frame_callbacks()
             frame->destroy_wayland_object();
         }
     }
-    frame_callbacks.clear();
 }
 
 void mf::WlSurface::destroy()
@@ -302,10 +318,11 @@ void mf::WlSurface::set_input_region(std::experimental::optional<wl_resource*> c
 
 void mf::WlSurface::commit(WlSurfaceState const& state)
 {
-    // We're going to lose the value of state, so copy the frame_callbacks first. We have to maintain a list of
+    // We're going to lose the value of state, so queue the frame_callbacks first. We have to maintain a queue of
     // callbacks in wl_surface because if a client commits multiple times before the first buffer is handled, all the
     // callbacks should be sent at once.
-    frame_callbacks.insert(end(frame_callbacks), begin(state.frame_callbacks), end(state.frame_callbacks));
+    if (state.buffer)
+        frame_callbacks.add_with_buffer(state.frame_callbacks);
 
     if (state.offset)
         offset_ = state.offset.value();
@@ -321,7 +338,7 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
         {
             // TODO: unmap surface, and unmap all subsurfaces
             buffer_size_ = std::experimental::nullopt;
-            send_frame_callbacks();
+            send_frame_callbacks(frame_callbacks.take_all());
         }
         else
         {
@@ -331,7 +348,7 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
                         destroyed,
                         [this]()
                         {
-                            send_frame_callbacks();
+                            send_frame_callbacks(frame_callbacks.take_all());
                         }));
                 };
 
@@ -377,11 +394,16 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
             }
             buffer_size_ = mir_buffer->size();
             stream->submit_buffer(mir_buffer);
+
+            // Wayland clients don't answer Mir's pings, but a client posting frames is evidently alive
+            anr_detector->activity_received(session.get());
         }
     }
     else
     {
-        send_frame_callbacks();
+        // If nothing of this surface is being composited there is no frame for the client to draw. Sending the
+        // callbacks then would just have the client spin rendering frames nobody sees, so they're held until exposed.
+        send_frame_callbacks(frame_callbacks.add_without_buffer(state.frame_callbacks));
     }
 
     for (WlSubsurface* child: children)
@@ -22,6 +22,7 @@
 #include "wayland_wrapper.h"
 
 #include "wl_surface_role.h"
+#include "frame_callback_queue.h"
 
 #include "mir/geometry/displacement.h"
 #include "mir/geometry/size.h"
@@ -40,6 +41,7 @@ class WaylandAllocator;
 }
 namespace scene
 {
+class ApplicationNotRespondingDetector;
 class Session;
 }
 namespace shell
@@ -118,7 +120,8 @@ public:
 
     WlSurface(wl_resource* new_resource,
               std::shared_ptr<mir::Executor> const& executor,
-              std::shared_ptr<mir::graphics::WaylandAllocator> const& allocator);
+              std::shared_ptr<mir::graphics::WaylandAllocator> const& allocator,
+              std::shared_ptr<scene::ApplicationNotRespondingDetector> const& anr_detector);
 
     ~WlSurface();
 
@@ -130,6 +133,7 @@ public:
     Position transform_point(geometry::Point point);
     wl_resource* raw_resource() const { return resource; }
     auto scene_surface() const -> std::experimental::optional<std::shared_ptr<scene::Surface>>;
+    bool exposed() const { return frame_callbacks.exposed(); }
 
     void set_role(WlSurfaceRole* role_);
     void clear_role();
@@ -144,6 +148,10 @@ public:
     void add_destroy_listener(void const* key, std::function<void()> listener);
     void remove_destroy_listener(void const* key);
 
+    /// While a surface is not exposed (occluded, off every output or minimized) frame callbacks that are not
+    /// tied to a consumed buffer are withheld until it is exposed again. Propagates to subsurfaces.
+    void set_exposed(bool exposed);
+
     std::shared_ptr<scene::Session> const session;
     std::shared_ptr<compositor::BufferStream> const stream;
 
@@ -152,6 +160,7 @@ public:
 private:
     std::shared_ptr<mir::graphics::WaylandAllocator> const allocator;
     std::shared_ptr<mir::Executor> const executor;
+    std::shared_ptr<scene::ApplicationNotRespondingDetector> const anr_detector;
 
     NullWlSurfaceRole null_role;
     WlSurfaceRole* role;
@@ -160,12 +169,12 @@ private:
     WlSurfaceState pending;
     geometry::Displacement offset_;
     std::experimental::optional<geometry::Size> buffer_size_;
-    std::vector<std::shared_ptr<WlSurfaceState::Callback>> frame_callbacks;
+    FrameCallbackQueue<std::shared_ptr<WlSurfaceState::Callback>> frame_callbacks;
     std::experimental::optional<std::vector<mir::geometry::Rectangle>> input_shape;
     std::map<void const*, std::function<void()>> destroy_listeners;
     std::shared_ptr<bool> const destroyed;
 
-    void send_frame_callbacks();
+    static void send_frame_callbacks(std::vector<std::shared_ptr<WlSurfaceState::Callback>> const& callbacks);
 
     void destroy() override;
     void attach(std::experimental::optional<wl_resource*> const& buffer, int32_t x, int32_t y) override;
@@ -38,6 +38,8 @@ namespace geom = mir::geometry;
 
 namespace
 {
+size_t const max_configures_in_flight{16};
+
 /// See ICCCM 4.1.3.1 (https://tronche.com/gui/x/icccm/sec-4.html)
 enum class WmState: uint32_t
 {
@@ -350,6 +352,25 @@ void mf::XWaylandSurface::configure_request(xcb_configure_request_event_t* event
             event->value_mask & XCB_CONFIG_WINDOW_HEIGHT ? geom::Height{event->height} : old_size.height,
         };
 
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+
+            // A client agreeing to geometry we sent (or are about to send) is not asking for anything. Passing
+            // it to the shell would drag the window back to where it was a few frames ago mid-resize.
+            geom::Rectangle const requested{new_position, new_size};
+            auto const matches_pending =
+                pending_configure.top_left.value_or(old_position) == new_position &&
+                pending_configure.size.value_or(old_size) == new_size &&
+                (pending_configure.top_left || pending_configure.size);
+
+            if (matches_pending ||
+                std::find(configures_in_flight.begin(), configures_in_flight.end(), requested) !=
+                    configures_in_flight.end())
+            {
+                return;
+            }
+        }
+
         shell::SurfaceSpecification mods;
 
         if (old_position != new_position)
@@ -396,6 +417,48 @@ void mf::XWaylandSurface::configure_notify(xcb_configure_notify_event_t* event)
     cached.override_redirect = event->override_redirect;
     cached.top_left = geom::Point{event->x, event->y},
     cached.size = geom::Size{event->width, event->height};
+
+    // The server applies configures in order, so everything before the one this acknowledges is done with
+    auto const acknowledged = std::find(
+        configures_in_flight.begin(),
+        configures_in_flight.end(),
+        geom::Rectangle{cached.top_left, cached.size});
+    if (acknowledged != configures_in_flight.end())
+        configures_in_flight.erase(configures_in_flight.begin(), acknowledged + 1);
+}
+
+void mf::XWaylandSurface::send_pending_configure()
+{
+    std::experimental::optional<geom::Point> top_left;
+    std::experimental::optional<geom::Size> size;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        top_left = pending_configure.top_left;
+        size = pending_configure.size;
+        pending_configure.top_left = std::experimental::nullopt;
+        pending_configure.size = std::experimental::nullopt;
+
+        if (!top_left && !size)
+            return;
+
+        auto const previous = configures_in_flight.empty() ?
+            geom::Rectangle{cached.top_left, cached.size} :
+            configures_in_flight.back();
+        configures_in_flight.push_back({top_left.value_or(previous.top_left), size.value_or(previous.size)});
+
+        // A client that never acknowledges shouldn't make this grow without limit
+        if (configures_in_flight.size() > max_configures_in_flight)
+            configures_in_flight.pop_front();
+    }
+
+    connection->configure_window(
+        window,
+        top_left,
+        size,
+        std::experimental::nullopt,
+        std::experimental::nullopt);
 }
 
 void mf::XWaylandSurface::net_wm_state_client_message(uint32_t const (&data)[5])
@@ -736,13 +799,11 @@ void mf::XWaylandSurface::scene_surface_state_set(MirWindowState new_state)
 
 void mf::XWaylandSurface::scene_surface_resized(geometry::Size const& new_size)
 {
-    connection->configure_window(
-        window,
-        std::experimental::nullopt,
-        new_size,
-        std::experimental::nullopt,
-        std::experimental::nullopt);
-    connection->flush();
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        pending_configure.size = new_size;
+    }
+    xwm->schedule_configure(window);
 }
 
 void mf::XWaylandSurface::scene_surface_moved_to(geometry::Point const& new_top_left)
@@ -753,13 +814,11 @@ void mf::XWaylandSurface::scene_surface_moved_to(geometry::Point const& new_top_
         scene_surface = weak_scene_surface.lock();
     }
     auto const content_offset = scene_surface ? scene_surface->content_offset() : geom::Displacement{};
-    connection->configure_window(
-        window,
-        new_top_left + content_offset,
-        std::experimental::nullopt,
-        std::experimental::nullopt,
-        std::experimental::nullopt);
-    connection->flush();
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        pending_configure.top_left = new_top_left + content_offset;
+    }
+    xwm->schedule_configure(window);
 }
 
 void mf::XWaylandSurface::scene_surface_close_requested()
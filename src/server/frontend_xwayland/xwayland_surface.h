@@ -28,6 +28,7 @@
 
 #include <mutex>
 #include <chrono>
+#include <deque>
 #include <set>
 
 namespace mir
@@ -66,6 +67,8 @@ public:
     void property_notify(xcb_atom_t property);
     void attach_wl_surface(WlSurface* wl_surface); ///< Should only be called on the Wayland thread
     void move_resize(uint32_t detail);
+    /// Sends the geometry accumulated since the last batch; the WM flushes afterwards
+    void send_pending_configure();
 
 private:
     /// contains more information than just a MirWindowState
@@ -148,6 +151,16 @@ private:
         std::set<xcb_atom_t> supported_wm_protocols;
     } cached;
 
+    /// Scene geometry changes not yet sent to the X server (in X coordinates)
+    struct
+    {
+        std::experimental::optional<geometry::Point> top_left;
+        std::experimental::optional<geometry::Size> size;
+    } pending_configure;
+
+    /// Geometry we have sent to the X server and not yet seen a ConfigureNotify for, oldest first
+    std::deque<geometry::Rectangle> configures_in_flight;
+
     /// Set in set_wl_surface and cleared when a scene surface is created from it
     std::experimental::optional<std::shared_ptr<XWaylandSurfaceObserver>> surface_observer;
     std::weak_ptr<scene::Session> weak_session;
@@ -29,9 +29,12 @@
 #include "mir/fd.h"
 #include "mir/terminate_with_current_exception.h"
 
+#include <algorithm>
 #include <cstring>
 #include <poll.h>
+#include <system_error>
 #include <sys/socket.h>
+#include <sys/timerfd.h>
 #include <unistd.h>
 #include <boost/throw_exception.hpp>
 
@@ -75,13 +78,28 @@ static const struct cursor_alternatives cursors[] = {
 
 namespace mf = mir::frontend;
 
+namespace
+{
+/// About one compositor frame at 60Hz; the WM has no view of the real frame clock
+std::chrono::nanoseconds const configure_interval{std::chrono::milliseconds{16}};
+
+auto create_configure_timer() -> mir::Fd
+{
+    mir::Fd timer{timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK)};
+    if (timer < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create configure timer"}));
+    return timer;
+}
+}
+
 mf::XWaylandWM::XWaylandWM(std::shared_ptr<WaylandConnector> wayland_connector, wl_client* wayland_client, int fd)
     : wm_fd{fd},
       connection{std::make_shared<XCBConnection>(fd)},
       wayland_connector(wayland_connector),
       dispatcher{std::make_shared<mir::dispatch::MultiplexingDispatchable>()},
       wayland_client{wayland_client},
-      wm_shell{std::static_pointer_cast<XWaylandWMShell>(wayland_connector->get_extension("x11-support"))}
+      wm_shell{std::static_pointer_cast<XWaylandWMShell>(wayland_connector->get_extension("x11-support"))},
+      configure_timer{create_configure_timer()}
 {
     if (xcb_connection_has_error(*connection))
     {
@@ -94,6 +112,10 @@ mf::XWaylandWM::XWaylandWM(std::shared_ptr<WaylandConnector> wayland_connector,
         std::make_shared<mir::dispatch::ReadableFd>(mir::Fd{mir::IntOwnedFd{wm_fd}}, [this]() { handle_events(); });
     dispatcher->add_watch(wm_dispatcher);
 
+    configure_dispatcher =
+        std::make_shared<mir::dispatch::ReadableFd>(configure_timer, [this]() { send_scheduled_configures(); });
+    dispatcher->add_watch(configure_dispatcher);
+
     event_thread = std::make_unique<mir::dispatch::ThreadedDispatcher>(
         "Mir/X11 WM Reader", dispatcher, []() { mir::terminate_with_current_exception(); });
 
@@ -159,6 +181,7 @@ mf::XWaylandWM::~XWaylandWM()
 
     if (event_thread)
     {
+        dispatcher->remove_watch(configure_dispatcher);
         dispatcher->remove_watch(wm_dispatcher);
         event_thread.reset();
     }
@@ -343,6 +366,54 @@ void mf::XWaylandWM::run_on_wayland_thread(std::function<void()>&& work)
     wayland_connector->run_on_wayland_display([work = move(work)](auto){ work(); });
 }
 
+void mf::XWaylandWM::schedule_configure(xcb_window_t xcb_window)
+{
+    std::lock_guard<std::mutex> lock{configure_mutex};
+
+    windows_to_configure.insert(xcb_window);
+
+    if (configure_timer_armed)
+        return;
+
+    auto const now = std::chrono::steady_clock::now();
+    // A zero timeout would disarm the timer, so a batch that is already due waits 1ns
+    auto const delay = std::max(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(last_configure_batch + configure_interval - now),
+        std::chrono::nanoseconds{1});
+
+    itimerspec timeout{};
+    timeout.it_value.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(delay).count();
+    timeout.it_value.tv_nsec = (delay % std::chrono::seconds{1}).count();
+
+    if (timerfd_settime(configure_timer, 0, &timeout, nullptr) < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to arm configure timer"}));
+
+    configure_timer_armed = true;
+}
+
+void mf::XWaylandWM::send_scheduled_configures()
+{
+    uint64_t expirations;
+    if (read(configure_timer, &expirations, sizeof expirations) < 0 && errno == EAGAIN)
+        return;
+
+    std::set<xcb_window_t> windows;
+    {
+        std::lock_guard<std::mutex> lock{configure_mutex};
+        windows.swap(windows_to_configure);
+        configure_timer_armed = false;
+        last_configure_batch = std::chrono::steady_clock::now();
+    }
+
+    for (auto const window : windows)
+    {
+        if (auto const surface = get_wm_surface(window))
+            surface.value()->send_pending_configure();
+    }
+
+    connection->flush();
+}
+
 /* Events */
 void mf::XWaylandWM::handle_events()
 {
@@ -23,7 +23,9 @@
 #include "wayland_connector.h"
 #include "xcb_connection.h"
 
+#include <chrono>
 #include <map>
+#include <set>
 #include <thread>
 #include <experimental/optional>
 #include <mutex>
@@ -69,6 +71,10 @@ public:
     void set_focus(xcb_window_t xcb_window, bool should_be_focused);
     void run_on_wayland_thread(std::function<void()>&& work);
 
+    /// Has the surface for xcb_window send its pending geometry with the next batch of configures
+    /// Batches go out at most once per configure_interval, each with a single flush
+    void schedule_configure(xcb_window_t xcb_window);
+
 private:
     enum CursorType
     {
@@ -111,6 +117,8 @@ private:
     void handle_destroy_notify(xcb_destroy_notify_event_t *event);
     void handle_focus_in(xcb_focus_in_event_t* event);
 
+    void send_scheduled_configures();
+
     std::mutex mutex;
 
     // Cursor
@@ -134,6 +142,14 @@ private:
     xcb_render_pictforminfo_t xcb_format_rgb, xcb_format_rgba;
     const xcb_query_extension_reply_t *xfixes;
     std::unique_ptr<dispatch::ThreadedDispatcher> event_thread;
+
+    std::mutex configure_mutex;
+    mir::Fd const configure_timer;
+    std::shared_ptr<dispatch::ReadableFd> configure_dispatcher;
+    std::set<xcb_window_t> windows_to_configure;
+    bool configure_timer_armed{false};
+    std::chrono::steady_clock::time_point last_configure_batch;
+
     xcb_visualid_t xcb_visual_id;
     xcb_colormap_t xcb_colormap;
 };
@@ -35,35 +35,28 @@ class AlarmImpl : public mir::time::Alarm
 {
 public:
     AlarmImpl(
-        GMainContext* main_context,
+        mir::detail::AlarmQueue& queue,
         std::shared_ptr<mir::time::Clock> const& clock,
         std::unique_ptr<mir::LockableCallback>&& callback,
         std::function<void()> const& exception_handler)
-        : main_context{g_main_context_ref(main_context)},
-          clock{clock},
+        : clock{clock},
           state_{State::cancelled},
-          exception_handler{exception_handler},
-          wrapped_callback{std::make_shared<mir::LockableCallbackWrapper>(
-              std::move(callback), [this] { state_ = State::triggered; })}
+          timer{
+              queue,
+              std::make_shared<mir::LockableCallbackWrapper>(
+                  std::move(callback), [this] { state_ = State::triggered; }),
+              exception_handler}
     {
     }
 
-    ~AlarmImpl() override
-    {
-        gsource.ensure_no_further_dispatch();
-        g_main_context_unref(main_context);
-    }
-
     bool cancel() override
     {
         std::lock_guard<std::mutex> lock{alarm_mutex};
 
-        gsource.ensure_no_further_dispatch();
+        timer.cancel();
         if (state_ ==  State::pending)
-        {
-            gsource = mir::detail::GSourceHandle{};
             state_ = State::cancelled;
-        }
+
         return state_ == State::cancelled;
     }
 
@@ -84,24 +77,16 @@ public:
 
         auto old_state = state_;
         state_ = State::pending;
-        gsource = mir::detail::add_timer_gsource(
-            main_context,
-            clock,
-            wrapped_callback,
-            exception_handler,
-            time_point);
+        timer.schedule(time_point);
 
         return old_state == State::pending;
     }
 
 private:
     mutable std::mutex alarm_mutex;
-    GMainContext* main_context;
     std::shared_ptr<mir::time::Clock> const clock;
     State state_;
-    std::function<void()> exception_handler;
-    std::shared_ptr<mir::LockableCallback> wrapped_callback;
-    mir::detail::GSourceHandle gsource;
+    mir::detail::AlarmQueue::Timer timer;
 };
 
 }
@@ -131,6 +116,8 @@ mir::GLibMainLoop::GLibMainLoop(
       running_{false},
       fd_sources{main_context},
       signal_sources{fd_sources},
+      server_actions{main_context},
+      alarms{main_context, clock},
       before_iteration_hook{[]{}}
 {
 }
@@ -256,12 +243,7 @@ void mir::GLibMainLoop::enqueue(void const* owner, ServerAction const& action)
             catch (...) { handle_exception(std::current_exception()); }
         };
 
-    detail::add_server_action_gsource(main_context, owner,
-        action_with_exception_handling,
-        [this] (void const* owner)
-        {
-            return should_process_actions_for(owner);
-        });
+    server_actions.enqueue(owner, action_with_exception_handling);
 }
 
 
@@ -309,30 +291,12 @@ void mir::GLibMainLoop::enqueue_with_guaranteed_execution(mir::ServerAction cons
 
 void mir::GLibMainLoop::pause_processing_for(void const* owner)
 {
-    std::lock_guard<std::mutex> lock{do_not_process_mutex};
-
-    auto const iter = std::find(do_not_process.begin(), do_not_process.end(), owner);
-    if (iter == do_not_process.end())
-        do_not_process.push_back(owner);
+    server_actions.pause(owner);
 }
 
 void mir::GLibMainLoop::resume_processing_for(void const* owner)
 {
-    std::lock_guard<std::mutex> lock{do_not_process_mutex};
-
-    auto const new_end = std::remove(do_not_process.begin(), do_not_process.end(), owner);
-    do_not_process.erase(new_end, do_not_process.end());
-
-    // Wake up the context to reprocess all sources
-    g_main_context_wakeup(main_context);
-}
-
-bool mir::GLibMainLoop::should_process_actions_for(void const* owner)
-{
-    std::lock_guard<std::mutex> lock{do_not_process_mutex};
-
-    auto const iter = std::find(do_not_process.begin(), do_not_process.end(), owner);
-    return iter == do_not_process.end();
+    server_actions.resume(owner);
 }
 
 std::unique_ptr<mir::time::Alarm> mir::GLibMainLoop::create_alarm(
@@ -351,7 +315,7 @@ std::unique_ptr<mir::time::Alarm> mir::GLibMainLoop::create_alarm(
         };
 
     return std::make_unique<AlarmImpl>(
-        main_context, clock, std::move(callback), exception_hander);
+        alarms, clock, std::move(callback), exception_hander);
 }
 
 void mir::GLibMainLoop::reprocess_all_sources()
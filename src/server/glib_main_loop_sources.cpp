@@ -20,11 +20,14 @@
 #include "mir/glib_main_loop_sources.h"
 #include "mir/lockable_callback.h"
 #include "mir/raii.h"
+#include "mir/time/timer_wheel.h"
 
 #include <algorithm>
 #include <atomic>
+#include <deque>
 #include <system_error>
 #include <sstream>
+#include <unordered_set>
 
 #include <csignal>
 #include <unistd.h>
@@ -253,118 +256,396 @@ void md::add_server_action_gsource(
     g_source_attach(gsource, main_context);
 }
 
-md::GSourceHandle md::add_timer_gsource(
-    GMainContext* main_context,
-    std::shared_ptr<time::Clock> const& clock,
-    std::shared_ptr<LockableCallback> const& handler,
-    std::function<void()> const& exception_handler,
-    time::Timestamp target_time)
+/**************
+ * AlarmQueue *
+ **************/
+
+struct md::AlarmQueue::Entry : time::TimerWheel::Timer, std::enable_shared_from_this<Entry>
 {
-    struct TimerContext
+    Entry(std::shared_ptr<LockableCallback> const& handler,
+          std::function<void()> const& exception_handler)
+        : handler{handler}, exception_handler{exception_handler}
     {
-        TimerContext(std::shared_ptr<time::Clock> const& clock,
-                     std::shared_ptr<LockableCallback> const& handler,
-                     std::function<void()> const& exception_handler,
-                     time::Timestamp target_time)
-            : clock{clock}, handler{handler}, exception_handler{exception_handler},
-              target_time{target_time}, enabled{true}
-        {
-        }
-        std::shared_ptr<time::Clock> clock;
-        std::shared_ptr<LockableCallback> handler;
-        std::function<void()> exception_handler;
-        time::Timestamp target_time;
-        std::recursive_mutex mutex;
-        bool enabled;
-    };
+    }
+
+    std::shared_ptr<LockableCallback> const handler;
+    std::function<void()> const exception_handler;
+
+    // Held while dispatching, so cancelling can wait for a dispatch to finish
+    std::recursive_mutex dispatch_mutex;
+
+    // Guarded by State::mutex; changes whenever the alarm is (re)scheduled or
+    // cancelled, so a stale expiry collected for dispatch is ignored
+    unsigned int generation{0};
+};
 
-    struct TimerGSource
+struct md::AlarmQueue::State
+{
+    State(GMainContext* main_context, std::shared_ptr<time::Clock> const& clock)
+        : main_context{main_context}, clock{clock}, wheel{clock->now(), std::chrono::milliseconds{1}}
     {
-        GSource gsource;
-        TimerContext ctx;
-        bool ctx_constructed;
+    }
 
-        static gboolean prepare(GSource* source, gint *timeout)
-        {
-            auto const& ctx = reinterpret_cast<TimerGSource*>(source)->ctx;
+    std::mutex mutex;
+    GMainContext* main_context;
+    std::shared_ptr<time::Clock> const clock;
+    time::TimerWheel wheel;
 
-            auto const now = ctx.clock->now();
-            bool const ready = (now >= ctx.target_time);
-            if (ready)
-                *timeout = -1;
-            else
-                *timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    ctx.clock->min_wait_until(ctx.target_time)).count();
+    // When the main loop last decided to wake for us
+    time::Timestamp sleeping_until{time::Timestamp::max()};
 
-            return ready;
-        }
+    bool is_current(Entry const& entry, unsigned int generation)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        return entry.generation == generation;
+    }
 
-        static gboolean check(GSource* source)
+    bool is_due()
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        return wheel.next_deadline() <= clock->now();
+    }
+
+    void dispatch()
+    {
+        std::vector<time::TimerWheel::Timer*> expired;
+        std::vector<std::pair<std::shared_ptr<Entry>, unsigned int>> due;
         {
-            auto const& ctx = reinterpret_cast<TimerGSource*>(source)->ctx;
+            std::lock_guard<std::mutex> lock{mutex};
+            wheel.expire(clock->now(), expired);
 
-            auto const now = ctx.clock->now();
-            bool const ready = (now >= ctx.target_time);
-            return ready;
+            // Entries are only freed after being cancelled under this lock,
+            // so anything still on the wheel can be kept alive from here
+            for (auto const timer : expired)
+            {
+                auto const entry = static_cast<Entry*>(timer);
+                due.emplace_back(entry->shared_from_this(), entry->generation);
+            }
         }
 
-        static gboolean dispatch(GSource* source, GSourceFunc, gpointer)
+        for (auto const& alarm : due)
         {
-            auto& ctx = reinterpret_cast<TimerGSource*>(source)->ctx;
+            auto& entry = *alarm.first;
+            if (!is_current(entry, alarm.second))
+                continue;
+
             try
             {
                 // Attempt to preserve locking order during callback dispatching
                 // so we acquire the caller's lock before our own.
-                auto& handler = *ctx.handler;
+                auto& handler = *entry.handler;
                 std::lock_guard<LockableCallback> handler_lock{handler};
-                std::lock_guard<decltype(ctx.mutex)> lock{ctx.mutex};
-                if (ctx.enabled)
+                std::lock_guard<std::recursive_mutex> lock{entry.dispatch_mutex};
+                if (is_current(entry, alarm.second))
                     handler();
             }
             catch(...)
             {
-                ctx.exception_handler();
+                entry.exception_handler();
             }
-
-            return FALSE;
         }
+    }
+};
 
-        static void finalize(GSource* source)
+struct md::AlarmQueue::AlarmGSource
+{
+    GSource gsource;
+    std::shared_ptr<State> state;
+
+    static gboolean prepare(GSource* source, gint *timeout)
+    {
+        auto& state = *reinterpret_cast<AlarmGSource*>(source)->state;
+        std::lock_guard<std::mutex> lock{state.mutex};
+
+        auto const deadline = state.wheel.next_deadline();
+        if (deadline <= state.clock->now())
         {
-            auto const timer_gsource = reinterpret_cast<TimerGSource*>(source);
-            if (timer_gsource->ctx_constructed)
-                timer_gsource->ctx.~TimerContext();
+            *timeout = -1;
+            return TRUE;
         }
 
-        static void disable(GSource* source)
+        state.sleeping_until = deadline;
+
+        if (deadline == time::Timestamp::max())
         {
-            auto& ctx = reinterpret_cast<TimerGSource*>(source)->ctx;
-            std::lock_guard<decltype(ctx.mutex)> lock{ctx.mutex};
-            ctx.enabled = false;
+            *timeout = -1;
+        }
+        else
+        {
+            // Round up: waking before the deadline would only mean going round again
+            auto const wait = state.clock->min_wait_until(deadline);
+            auto const wait_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                wait + std::chrono::milliseconds{1} - time::Duration{1}).count();
+            *timeout = static_cast<gint>(std::min<decltype(wait_ms)>(wait_ms, G_MAXINT));
         }
-    };
 
+        return FALSE;
+    }
+
+    static gboolean check(GSource* source)
+    {
+        return reinterpret_cast<AlarmGSource*>(source)->state->is_due();
+    }
+
+    static gboolean dispatch(GSource* source, GSourceFunc, gpointer)
+    {
+        reinterpret_cast<AlarmGSource*>(source)->state->dispatch();
+        return G_SOURCE_CONTINUE;
+    }
+
+    static void finalize(GSource* source)
+    {
+        reinterpret_cast<AlarmGSource*>(source)->state.~shared_ptr();
+    }
+};
+
+md::AlarmQueue::AlarmQueue(GMainContext* main_context, std::shared_ptr<time::Clock> const& clock) :
+    state{std::make_shared<State>(main_context, clock)}
+{
     static GSourceFuncs gsource_funcs{
-        TimerGSource::prepare,
-        TimerGSource::check,
-        TimerGSource::dispatch,
-        TimerGSource::finalize,
+        AlarmGSource::prepare,
+        AlarmGSource::check,
+        AlarmGSource::dispatch,
+        AlarmGSource::finalize,
         nullptr,
         nullptr
     };
 
-    GSourceHandle gsource{
-        g_source_new(&gsource_funcs, sizeof(TimerGSource)),
-        [](GSource* gsource) { TimerGSource::disable(gsource); }};
-    auto const timer_gsource = reinterpret_cast<TimerGSource*>(static_cast<GSource*>(gsource));
+    auto const source = g_source_new(&gsource_funcs, sizeof(AlarmGSource));
+    new (&reinterpret_cast<AlarmGSource*>(source)->state) std::shared_ptr<State>{state};
+
+    gsource = GSourceHandle{source, [](GSource*) {}};
+    g_source_attach(gsource, main_context);
+}
+
+md::AlarmQueue::~AlarmQueue()
+{
+    // Alarms may outlive us, but the context they would wake may not
+    std::lock_guard<std::mutex> lock{state->mutex};
+    state->main_context = nullptr;
+}
+
+md::AlarmQueue::Timer::Timer(
+    AlarmQueue& queue,
+    std::shared_ptr<LockableCallback> const& handler,
+    std::function<void()> const& exception_handler) :
+    state{queue.state},
+    entry{std::make_shared<Entry>(handler, exception_handler)}
+{
+}
+
+md::AlarmQueue::Timer::~Timer()
+{
+    cancel();
+}
+
+void md::AlarmQueue::Timer::schedule(time::Timestamp time)
+{
+    std::lock_guard<std::mutex> lock{state->mutex};
+
+    ++entry->generation;
+    state->wheel.schedule(*entry, time);
+
+    if (time < state->sleeping_until && state->main_context)
+    {
+        state->sleeping_until = time;
+        g_main_context_wakeup(state->main_context);
+    }
+}
+
+void md::AlarmQueue::Timer::cancel()
+{
+    std::lock_guard<std::recursive_mutex> dispatching{entry->dispatch_mutex};
+    std::lock_guard<std::mutex> lock{state->mutex};
+
+    ++entry->generation;
+    state->wheel.cancel(*entry);
+}
+
+/*********************
+ * ServerActionQueue *
+ *********************/
+
+struct md::ServerActionQueue::Action
+{
+    void const* const owner;
+    std::function<void()> const action;
+    Action* next;
+};
+
+struct md::ServerActionQueue::State
+{
+    std::atomic<Action*> incoming{nullptr};
+
+    // Only touched by the thread dispatching the main context
+    std::deque<Action*> pending;
+
+    std::mutex paused_mutex;
+    std::unordered_set<void const*> paused;
+    std::atomic<bool> any_paused{false};
+
+    void take_incoming()
+    {
+        // The stack is newest first; reverse it onto the end of pending
+        Action* oldest_first{nullptr};
+        for (auto action = incoming.exchange(nullptr); action;)
+        {
+            auto const next = action->next;
+            action->next = oldest_first;
+            oldest_first = action;
+            action = next;
+        }
+
+        for (auto action = oldest_first; action; action = action->next)
+            pending.push_back(action);
+    }
+
+    auto paused_owners() -> std::unordered_set<void const*>
+    {
+        if (!any_paused)
+            return {};
+
+        std::lock_guard<std::mutex> lock{paused_mutex};
+        return paused;
+    }
+
+    bool has_runnable_action()
+    {
+        take_incoming();
+
+        if (pending.empty())
+            return false;
+
+        auto const paused_now = paused_owners();
+        return std::any_of(pending.begin(), pending.end(),
+            [&](Action const* action) { return !paused_now.count(action->owner); });
+    }
+
+    void dispatch()
+    {
+        take_incoming();
 
-    timer_gsource->ctx_constructed = false;
-    new (&timer_gsource->ctx) TimerContext{clock, handler, exception_handler, target_time};
-    timer_gsource->ctx_constructed = true;
+        // Pausing takes effect from the next dispatch, as it did when each
+        // action had its own source checked before any were dispatched.
+        auto const paused_now = paused_owners();
+        std::deque<Action*> batch;
+        batch.swap(pending);
+
+        // Anything enqueued by these actions waits for the next iteration
+        while (!batch.empty())
+        {
+            auto const action = batch.front();
+            batch.pop_front();
+
+            if (paused_now.count(action->owner))
+            {
+                pending.push_back(action);
+                continue;
+            }
+
+            try
+            {
+                action->action();
+            }
+            catch (...)
+            {
+                pending.insert(pending.end(), batch.begin(), batch.end());
+                delete action;
+                throw;
+            }
+
+            delete action;
+        }
+    }
+};
 
+struct md::ServerActionQueue::ActionGSource
+{
+    GSource gsource;
+    State* state;
+
+    static gboolean prepare(GSource* source, gint *timeout)
+    {
+        *timeout = -1;
+        return reinterpret_cast<ActionGSource*>(source)->state->has_runnable_action();
+    }
+
+    static gboolean check(GSource* source)
+    {
+        return reinterpret_cast<ActionGSource*>(source)->state->has_runnable_action();
+    }
+
+    static gboolean dispatch(GSource* source, GSourceFunc, gpointer)
+    {
+        reinterpret_cast<ActionGSource*>(source)->state->dispatch();
+        return G_SOURCE_CONTINUE;
+    }
+
+    static void finalize(GSource* source)
+    {
+        // Any actions still queued may refer to code that has since been
+        // unloaded, so (as for add_server_action_gsource()) we leak them
+        // rather than risk running their destructors.
+        delete reinterpret_cast<ActionGSource*>(source)->state;
+    }
+};
+
+md::ServerActionQueue::ServerActionQueue(GMainContext* main_context) :
+    main_context{main_context},
+    state{new State}
+{
+    static GSourceFuncs gsource_funcs{
+        ActionGSource::prepare,
+        ActionGSource::check,
+        ActionGSource::dispatch,
+        ActionGSource::finalize,
+        nullptr,
+        nullptr
+    };
+
+    auto const source = g_source_new(&gsource_funcs, sizeof(ActionGSource));
+    reinterpret_cast<ActionGSource*>(source)->state = state;
+
+    gsource = GSourceHandle{source, [](GSource*) {}};
     g_source_attach(gsource, main_context);
+}
 
-    return gsource;
+md::ServerActionQueue::~ServerActionQueue() = default;
+
+void md::ServerActionQueue::enqueue(void const* owner, std::function<void()> const& action)
+{
+    auto const queued = new Action{owner, action, nullptr};
+
+    auto head = state->incoming.load();
+    do
+    {
+        queued->next = head;
+    }
+    while (!state->incoming.compare_exchange_weak(head, queued));
+
+    // The main loop takes the whole stack at once, so only the first action
+    // since it last did so needs to wake it
+    if (!head)
+        g_main_context_wakeup(main_context);
+}
+
+void md::ServerActionQueue::pause(void const* owner)
+{
+    std::lock_guard<std::mutex> lock{state->paused_mutex};
+    state->paused.insert(owner);
+    state->any_paused = true;
+}
+
+void md::ServerActionQueue::resume(void const* owner)
+{
+    {
+        std::lock_guard<std::mutex> lock{state->paused_mutex};
+        state->paused.erase(owner);
+        state->any_paused = !state->paused.empty();
+    }
+
+    // Wake up the context to reprocess the held actions
+    g_main_context_wakeup(main_context);
 }
 
 /*************
@@ -25,6 +25,7 @@
 #include "mir/renderer/gl/egl_platform.h"
 #include "null_cursor.h"
 #include "offscreen/display.h"
+#include "offscreen/software_display.h"
 #include "software_cursor.h"
 #include "platform_probe.h"
 
@@ -184,20 +185,27 @@ mir::DefaultServerConfiguration::the_display()
         {
             if (the_options()->is_set(options::offscreen_opt))
             {
-                if (auto egl_access = dynamic_cast<mir::renderer::gl::EGLPlatform*>(
-                    the_graphics_platform()->native_rendering_platform()))
+                auto const frame_socket = the_options()->is_set(options::offscreen_frame_socket) ?
+                    the_options()->get<std::string>(options::offscreen_frame_socket) :
+                    std::string{};
+
+                auto const egl_access = dynamic_cast<mir::renderer::gl::EGLPlatform*>(
+                    the_graphics_platform()->native_rendering_platform());
+
+                // Without EGL (or when asked to) composite offscreen outputs in software
+                if (!egl_access ||
+                    the_options()->get<std::string>(options::renderer_opt) == "software")
                 {
-                    return std::make_shared<mg::offscreen::Display>(
-                        egl_access->egl_native_display(),
+                    return std::make_shared<mg::offscreen::SoftwareDisplay>(
                         the_display_configuration_policy(),
-                        the_display_report());
-                }
-                else
-                {
-                    BOOST_THROW_EXCEPTION(std::runtime_error(
-                        "underlying rendering platform does not support EGL access."\
-                        " Could not create offscreen display"));
+                        frame_socket);
                 }
+
+                return std::make_shared<mg::offscreen::Display>(
+                    egl_access->egl_native_display(),
+                    the_display_configuration_policy(),
+                    the_display_report(),
+                    frame_socket);
             }
 
             return the_graphics_platform()->create_display(
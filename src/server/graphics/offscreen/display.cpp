@@ -18,6 +18,7 @@
 
 #include "display.h"
 #include "display_buffer.h"
+#include "frame_exporter.h"
 #include "mir/graphics/display_configuration_policy.h"
 #include "mir/graphics/egl_error.h"
 #include "mir/graphics/virtual_output.h"
@@ -97,10 +98,12 @@ mgo::detail::DisplaySyncGroup::recommended_sleep() const
 mgo::Display::Display(
     EGLNativeDisplayType egl_native_display,
     std::shared_ptr<DisplayConfigurationPolicy> const& initial_conf_policy,
-    std::shared_ptr<DisplayReport> const&)
+    std::shared_ptr<DisplayReport> const&,
+    std::string const& frame_export_socket)
     : egl_display{create_and_initialize_display(egl_native_display)},
       egl_context_shared{egl_display, EGL_NO_CONTEXT},
-      current_display_configuration{geom::Size{1024,768}}
+      current_display_configuration{geom::Size{1024,768}},
+      frame_export_socket{frame_export_socket}
 {
     /*
      * Make the shared context current. This needs to be done before we configure()
@@ -145,15 +148,29 @@ void mgo::Display::configure(mg::DisplayConfiguration const& conf)
 
     display_sync_groups.clear();
 
+    unsigned exported_outputs{0};
+
     conf.for_each_output(
-        [this] (DisplayConfigurationOutput const& output)
+        [this, &exported_outputs] (DisplayConfigurationOutput const& output)
         {
             if (output.connected && output.preferred_mode_index < output.modes.size())
             {
+                /* The first output is exported on the socket as named, any others on "<socket>.<n>" */
+                std::unique_ptr<FrameExporter> exporter;
+                if (!frame_export_socket.empty())
+                {
+                    auto const path = exported_outputs ?
+                        frame_export_socket + "." + std::to_string(exported_outputs) :
+                        frame_export_socket;
+                    exporter = std::make_unique<FrameExporter>(path, output.extents().size);
+                    ++exported_outputs;
+                }
+
                 eglBindAPI(MIR_SERVER_EGL_OPENGL_API);
                 auto raw_db = new mgo::DisplayBuffer{
                     SurfacelessEGLContext{egl_display, egl_context_shared},
-                    output.extents()};
+                    output.extents(),
+                    std::move(exporter)};
 
                 display_sync_groups.emplace_back(
                     new mgo::detail::DisplaySyncGroup(std::unique_ptr<mg::DisplayBuffer>(raw_db)));
@@ -25,6 +25,7 @@
 #include "mir/renderer/gl/context_source.h"
 
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include <EGL/egl.h>
@@ -79,7 +80,8 @@ class Display : public graphics::Display,
 public:
     Display(EGLNativeDisplayType egl_native_display,
             std::shared_ptr<DisplayConfigurationPolicy> const& initial_conf_policy,
-            std::shared_ptr<DisplayReport> const& listener);
+            std::shared_ptr<DisplayReport> const& listener,
+            std::string const& frame_export_socket);
     ~Display() noexcept;
 
     void for_each_display_sync_group(std::function<void(DisplaySyncGroup&)> const& f) override;
@@ -113,6 +115,7 @@ private:
     mutable std::mutex configuration_mutex;
     DisplayConfiguration current_display_configuration;
     std::vector<std::unique_ptr<DisplaySyncGroup>> display_sync_groups;
+    std::string const frame_export_socket;
 };
 
 }
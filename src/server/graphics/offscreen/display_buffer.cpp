@@ -17,6 +17,7 @@
  */
 
 #include "display_buffer.h"
+#include "frame_exporter.h"
 #include "mir/graphics/gl_extensions_base.h"
 #include "mir/raii.h"
 
@@ -124,6 +125,18 @@ mgo::DisplayBuffer::DisplayBuffer(SurfacelessEGLContext egl_context,
 {
 }
 
+mgo::DisplayBuffer::DisplayBuffer(SurfacelessEGLContext egl_context,
+                                  geom::Rectangle const& area,
+                                  std::unique_ptr<FrameExporter> exporter)
+    : egl_context{std::move(egl_context)},
+      fbo{area.size},
+      area(area),
+      exporter{std::move(exporter)}
+{
+}
+
+mgo::DisplayBuffer::~DisplayBuffer() = default;
+
 geom::Rectangle mgo::DisplayBuffer::view_area() const
 {
     return area;
@@ -147,6 +160,20 @@ void mgo::DisplayBuffer::release_current()
 
 void mgo::DisplayBuffer::swap_buffers()
 {
+    if (auto const pixels = exporter ? exporter->begin_frame() : nullptr)
+    {
+        /*
+         * glReadPixels() waits for rendering just as glFinish() would; all
+         * further processing of the frame happens on the exporter's thread.
+         */
+        fbo.bind();
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, area.size.width.as_int(), area.size.height.as_int(),
+                     GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        exporter->end_frame();
+        return;
+    }
+
     glFinish();
 }
 
@@ -28,12 +28,15 @@
 
 #include <EGL/egl.h>
 
+#include <memory>
+
 namespace mir
 {
 namespace graphics
 {
 namespace offscreen
 {
+class FrameExporter;
 
 namespace detail
 {
@@ -64,6 +67,11 @@ class DisplayBuffer : public graphics::DisplayBuffer,
 public:
     DisplayBuffer(SurfacelessEGLContext egl_context,
                   geometry::Rectangle const& area);
+    /// Also hands every swapped frame to \a exporter
+    DisplayBuffer(SurfacelessEGLContext egl_context,
+                  geometry::Rectangle const& area,
+                  std::unique_ptr<FrameExporter> exporter);
+    ~DisplayBuffer();
 
     geometry::Rectangle view_area() const override;
     bool overlay(RenderableList const& renderlist) override;
@@ -77,6 +85,7 @@ private:
     SurfacelessEGLContext const egl_context;
     detail::GLFramebufferObject const fbo;
     geometry::Rectangle const area;
+    std::unique_ptr<FrameExporter> const exporter;
 };
 
 }
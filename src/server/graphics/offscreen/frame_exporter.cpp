@@ -0,0 +1,399 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "frame_exporter.h"
+#include "mir/thread_name.h"
+#include "mir_toolkit/common.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <linux/memfd.h>
+#include <unistd.h>
+
+namespace mgo = mir::graphics::offscreen;
+namespace geom = mir::geometry;
+
+namespace
+{
+uint64_t round_up(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+mir::Fd create_shm(uint64_t size)
+{
+    mir::Fd shm{static_cast<int>(syscall(SYS_memfd_create, "mir-offscreen-frames", MFD_CLOEXEC))};
+    if (shm < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create frame export buffers"}));
+    if (ftruncate(shm, size) < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to size frame export buffers"}));
+    return shm;
+}
+
+unsigned char* map_shm(mir::Fd const& shm, uint64_t size)
+{
+    auto const mapping = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_SHARED, shm, 0);
+    if (mapping == MAP_FAILED)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to map frame export buffers"}));
+    return static_cast<unsigned char*>(mapping);
+}
+
+mir::Fd create_listener(std::string const& path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof address.sun_path)
+        BOOST_THROW_EXCEPTION(std::invalid_argument{"Frame export socket path too long: " + path});
+    strncpy(address.sun_path, path.c_str(), sizeof address.sun_path - 1);
+
+    mir::Fd listener{socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)};
+    if (listener < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create frame export socket"}));
+
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof address) < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to bind frame export socket " + path}));
+    if (listen(listener, 1) < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to listen on frame export socket"}));
+
+    return listener;
+}
+
+mir::Fd create_eventfd()
+{
+    mir::Fd fd{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)};
+    if (fd < 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create eventfd"}));
+    return fd;
+}
+
+bool send_with_fd(int socket, void const* data, size_t size, int fd)
+{
+    iovec iov{const_cast<void*>(data), size};
+    char control[CMSG_SPACE(sizeof(int))] = {};
+
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof control;
+
+    auto const cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+    return sendmsg(socket, &message, MSG_NOSIGNAL) == static_cast<ssize_t>(size);
+}
+}
+
+mgo::FrameExporter::FrameExporter(std::string const& socket_path, geom::Size const& size, unsigned slots) :
+    socket_path{socket_path},
+    size{size},
+    stride_{static_cast<uint32_t>(size.width.as_uint32_t() * 4)},
+    header_size{static_cast<uint32_t>(round_up(sizeof(frame_export::FrameHeader), 64))},
+    slot_size{round_up(header_size + uint64_t{stride_} * size.height.as_uint32_t(), sysconf(_SC_PAGESIZE))},
+    slot_count{slots},
+    shm{create_shm(slot_size * slot_count)},
+    listener{create_listener(socket_path)},
+    wakeup{create_eventfd()},
+    mapping{map_shm(shm, slot_size * slot_count)},
+    slots(slot_count, SlotState::free),
+    filling_slot{0},
+    row(stride_)
+{
+    thread = std::thread{[this] { run(); }};
+}
+
+mgo::FrameExporter::~FrameExporter()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        running = false;
+    }
+    eventfd_write(wakeup, 1);
+    thread.join();
+
+    munmap(mapping, slot_size * slot_count);
+    unlink(socket_path.c_str());
+}
+
+auto mgo::FrameExporter::begin_frame() -> unsigned char*
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (consumer < 0)
+        return nullptr;
+
+    for (unsigned i = 0; i != slot_count; ++i)
+    {
+        if (slots[i] == SlotState::free)
+        {
+            slots[i] = SlotState::filling;
+            filling_slot = i;
+            return slot_pixels(i);
+        }
+    }
+
+    return nullptr;
+}
+
+void mgo::FrameExporter::end_frame(RowOrder order)
+{
+    auto const now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        slots[filling_slot] = SlotState::exporting;
+        pending.push_back({filling_slot, now, order});
+    }
+    eventfd_write(wakeup, 1);
+}
+
+void mgo::FrameExporter::run()
+{
+    mir::set_thread_name("Mir/FrameExport");
+
+    for (;;)
+    {
+        pollfd fds[] = {{wakeup, POLLIN, 0}, {listener, POLLIN, 0}, {consumer, POLLIN, 0}};
+        nfds_t const count = consumer < 0 ? 2 : 3;
+
+        if (poll(fds, count, -1) < 0)
+            continue;
+
+        // Releases first: both of the steps below can replace the consumer
+        if (count == 3 && fds[2].revents)
+            receive_releases();
+
+        if (fds[0].revents & POLLIN)
+        {
+            eventfd_t ignored;
+            eventfd_read(wakeup, &ignored);
+
+            std::deque<Pending> frames;
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                if (!running)
+                    return;
+                frames.swap(pending);
+            }
+
+            for (auto const& frame : frames)
+                export_frame(frame);
+        }
+
+        if (fds[1].revents & POLLIN)
+            accept_consumer();
+    }
+}
+
+void mgo::FrameExporter::accept_consumer()
+{
+    Fd fd{accept4(listener, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK)};
+    if (fd < 0)
+        return;
+
+    frame_export::Setup const setup{
+        frame_export::magic,
+        frame_export::version,
+        size.width.as_uint32_t(),
+        size.height.as_uint32_t(),
+        stride_,
+        mir_pixel_format_abgr_8888,
+        slot_count,
+        header_size,
+        slot_size};
+
+    std::lock_guard<std::mutex> lock{mutex};
+
+    // The newest consumer wins: there is only one set of slots to hand out
+    if (consumer >= 0)
+        drop_consumer();
+
+    if (send_with_fd(fd, &setup, sizeof setup, shm))
+        consumer = fd;
+}
+
+void mgo::FrameExporter::receive_releases()
+{
+    uint32_t released[16];
+
+    for (;;)
+    {
+        auto const received = recv(consumer, released, sizeof released, 0);
+
+        if (received > 0)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            for (auto i = 0u; i != received / sizeof released[0]; ++i)
+            {
+                // Untrusted: only a slot the consumer actually holds can be freed
+                if (released[i] < slot_count && slots[released[i]] == SlotState::held)
+                    slots[released[i]] = SlotState::free;
+            }
+        }
+        else if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return;
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            drop_consumer();
+            return;
+        }
+    }
+}
+
+void mgo::FrameExporter::export_frame(Pending const& frame)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (consumer < 0)
+        {
+            slots[frame.slot] = SlotState::free;
+            return;
+        }
+    }
+
+    auto const pixels = slot_pixels(frame.slot);
+    int const width = size.width.as_int();
+    int const height = size.height.as_int();
+    size_t const row_bytes = width * 4;
+
+    // glReadPixels() fills rows bottom to top
+    for (int top = 0, bottom = height - 1; frame.order == RowOrder::bottom_first && top < bottom; ++top, --bottom)
+    {
+        auto const top_row = pixels + top * stride_;
+        auto const bottom_row = pixels + bottom * stride_;
+        memcpy(row.data(), top_row, row_bytes);
+        memcpy(top_row, bottom_row, row_bytes);
+        memcpy(bottom_row, row.data(), row_bytes);
+    }
+
+    int first_row = 0, last_row = height - 1, first_column = 0, last_column = width - 1;
+
+    if (have_previous_frame)
+    {
+        first_row = height;
+        last_row = -1;
+        first_column = width;
+        last_column = -1;
+
+        for (int y = 0; y != height; ++y)
+        {
+            auto const now = pixels + y * stride_;
+            auto const then = previous_frame.data() + y * stride_;
+
+            if (memcmp(now, then, row_bytes) == 0)
+                continue;
+
+            first_row = std::min(first_row, y);
+            last_row = y;
+
+            for (int x = 0; x < first_column; ++x)
+            {
+                if (memcmp(now + 4*x, then + 4*x, 4) != 0)
+                {
+                    first_column = x;
+                    break;
+                }
+            }
+            for (int x = width - 1; x > last_column; --x)
+            {
+                if (memcmp(now + 4*x, then + 4*x, 4) != 0)
+                {
+                    last_column = x;
+                    break;
+                }
+            }
+        }
+    }
+
+    previous_frame.assign(pixels, pixels + stride_ * height);
+    have_previous_frame = true;
+
+    auto const header = slot_header(frame.slot);
+    header->sequence = sequence++;
+    header->timestamp_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(frame.timestamp.time_since_epoch()).count();
+    header->damage_x = last_row < 0 ? 0 : first_column;
+    header->damage_y = last_row < 0 ? 0 : first_row;
+    header->damage_width = last_row < 0 ? 0 : last_column - first_column + 1;
+    header->damage_height = last_row < 0 ? 0 : last_row - first_row + 1;
+
+    frame_export::FrameReady const ready{frame.slot};
+
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (consumer < 0)
+    {
+        slots[frame.slot] = SlotState::free;
+    }
+    else if (send(consumer, &ready, sizeof ready, MSG_NOSIGNAL) == sizeof ready)
+    {
+        slots[frame.slot] = SlotState::held;
+    }
+    else if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+        // The consumer is behind; it never sees this frame, so the next one is all damage
+        slots[frame.slot] = SlotState::free;
+        have_previous_frame = false;
+    }
+    else
+    {
+        slots[frame.slot] = SlotState::free;
+        drop_consumer();
+    }
+}
+
+// Called with mutex held
+void mgo::FrameExporter::drop_consumer()
+{
+    consumer = Fd{};
+    for (auto& slot : slots)
+    {
+        if (slot == SlotState::held)
+            slot = SlotState::free;
+    }
+    have_previous_frame = false;
+}
+
+auto mgo::FrameExporter::slot_header(unsigned slot) const -> frame_export::FrameHeader*
+{
+    return reinterpret_cast<frame_export::FrameHeader*>(mapping + slot * slot_size);
+}
+
+auto mgo::FrameExporter::slot_pixels(unsigned slot) const -> unsigned char*
+{
+    return mapping + slot * slot_size + header_size;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_OFFSCREEN_FRAME_EXPORTER_H_
+#define MIR_GRAPHICS_OFFSCREEN_FRAME_EXPORTER_H_
+
+#include "mir/fd.h"
+#include "mir/geometry/size.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mir
+{
+namespace graphics
+{
+namespace offscreen
+{
+/**
+ * What a frame consumer sees on the export socket.
+ *
+ * The socket is SOCK_SEQPACKET. On connecting, the consumer receives a Setup
+ * with the memfd holding every slot attached. Each composited frame is then
+ * announced by a FrameReady naming the slot it is in; the slot stays the
+ * consumer's until it sends the slot index (a uint32_t) back.
+ */
+namespace frame_export
+{
+uint32_t const magic{0x4d495246}; // "MIRF"
+uint32_t const version{1};
+
+struct Setup
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    uint32_t pixel_format;      ///< A MirPixelFormat, rows top to bottom
+    uint32_t slot_count;
+    uint32_t header_size;       ///< Offset of the pixels within a slot
+    uint64_t slot_size;         ///< Slot n starts at n * slot_size
+};
+
+/// At the start of each slot
+struct FrameHeader
+{
+    uint64_t sequence;
+    int64_t timestamp_ns;       ///< CLOCK_MONOTONIC, when the frame was swapped
+    int32_t damage_x;           ///< Damage against the previous frame sent to this consumer
+    int32_t damage_y;
+    int32_t damage_width;
+    int32_t damage_height;
+};
+
+struct FrameReady
+{
+    uint32_t slot;
+};
+}
+
+/**
+ * Hands composited frames of an offscreen display buffer to a local consumer.
+ *
+ * The compositor only reads pixels into a free slot; flipping them, working
+ * out damage and talking to the consumer happen on the exporter's own thread.
+ * When nobody is connected, or the consumer is holding every slot, frames are
+ * dropped rather than holding up compositing.
+ */
+class FrameExporter
+{
+public:
+    FrameExporter(std::string const& socket_path, geometry::Size const& size, unsigned slots = 3);
+    ~FrameExporter();
+
+    /// How the rows of a frame were written to its slot
+    enum class RowOrder { bottom_first, top_first };
+
+    /**
+     * Claim a slot for the frame about to be swapped.
+     * \return where to glReadPixels() the frame as GL_RGBA/GL_UNSIGNED_BYTE
+     *         (or write RGBA rows top first, see end_frame()), or nullptr if
+     *         this frame should not be exported
+     */
+    auto begin_frame() -> unsigned char*;
+
+    /// Queue the frame claimed by begin_frame() for export
+    void end_frame(RowOrder order = RowOrder::bottom_first);
+
+    auto stride() const -> uint32_t { return stride_; }
+
+private:
+    FrameExporter(FrameExporter const&) = delete;
+    FrameExporter& operator=(FrameExporter const&) = delete;
+
+    enum class SlotState { free, filling, exporting, held };
+
+    struct Pending
+    {
+        unsigned slot;
+        std::chrono::steady_clock::time_point timestamp;
+        RowOrder order;
+    };
+
+    void run();
+    void accept_consumer();
+    void receive_releases();
+    void export_frame(Pending const& frame);
+    void drop_consumer();
+    auto slot_header(unsigned slot) const -> frame_export::FrameHeader*;
+    auto slot_pixels(unsigned slot) const -> unsigned char*;
+
+    std::string const socket_path;
+    geometry::Size const size;
+    uint32_t const stride_;
+    uint32_t const header_size;
+    uint64_t const slot_size;
+    unsigned const slot_count;
+
+    Fd const shm;
+    Fd const listener;
+    Fd const wakeup;
+    unsigned char* const mapping;
+
+    std::mutex mutex;
+    Fd consumer;
+    std::vector<SlotState> slots;
+    std::deque<Pending> pending;
+    unsigned filling_slot;
+    bool running{true};
+
+    // Only touched by the export thread
+    std::vector<unsigned char> previous_frame;
+    std::vector<unsigned char> row;
+    bool have_previous_frame{false};
+    uint64_t sequence{0};
+
+    std::thread thread;
+};
+}
+}
+}
+
+#endif /* MIR_GRAPHICS_OFFSCREEN_FRAME_EXPORTER_H_ */
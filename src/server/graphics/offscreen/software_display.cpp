@@ -0,0 +1,143 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "software_display.h"
+#include "software_display_buffer.h"
+#include "display.h"
+#include "frame_exporter.h"
+#include "mir/graphics/display_configuration_policy.h"
+#include "mir/graphics/virtual_output.h"
+
+#include <boost/throw_exception.hpp>
+#include <stdexcept>
+
+namespace mg = mir::graphics;
+namespace mgo = mg::offscreen;
+namespace geom = mir::geometry;
+
+mgo::SoftwareDisplay::SoftwareDisplay(
+    std::shared_ptr<DisplayConfigurationPolicy> const& initial_conf_policy,
+    std::string const& frame_export_socket)
+    : current_display_configuration{geom::Size{1024,768}},
+      frame_export_socket{frame_export_socket}
+{
+    initial_conf_policy->apply_to(current_display_configuration);
+
+    configure(current_display_configuration);
+}
+
+mgo::SoftwareDisplay::~SoftwareDisplay() noexcept
+{
+}
+
+void mgo::SoftwareDisplay::for_each_display_sync_group(
+    std::function<void(mg::DisplaySyncGroup&)> const& f)
+{
+    std::lock_guard<std::mutex> lock{configuration_mutex};
+
+    for (auto& dg_ptr : display_sync_groups)
+        f(*dg_ptr);
+}
+
+std::unique_ptr<mg::DisplayConfiguration> mgo::SoftwareDisplay::configuration() const
+{
+    std::lock_guard<std::mutex> lock{configuration_mutex};
+    return std::make_unique<mgo::DisplayConfiguration>(
+        current_display_configuration);
+}
+
+void mgo::SoftwareDisplay::configure(mg::DisplayConfiguration const& conf)
+{
+    if (!conf.valid())
+    {
+        BOOST_THROW_EXCEPTION(
+            std::logic_error("Invalid or inconsistent display configuration"));
+    }
+
+    std::lock_guard<std::mutex> lock{configuration_mutex};
+
+    display_sync_groups.clear();
+
+    unsigned exported_outputs{0};
+
+    conf.for_each_output(
+        [this, &exported_outputs] (DisplayConfigurationOutput const& output)
+        {
+            if (output.connected && output.preferred_mode_index < output.modes.size())
+            {
+                /* The first output is exported on the socket as named, any others on "<socket>.<n>" */
+                std::unique_ptr<FrameExporter> exporter;
+                if (!frame_export_socket.empty())
+                {
+                    auto const path = exported_outputs ?
+                        frame_export_socket + "." + std::to_string(exported_outputs) :
+                        frame_export_socket;
+                    exporter = std::make_unique<FrameExporter>(path, output.extents().size);
+                    ++exported_outputs;
+                }
+
+                display_sync_groups.emplace_back(
+                    new mgo::detail::DisplaySyncGroup(
+                        std::make_unique<mgo::SoftwareDisplayBuffer>(output.extents(), std::move(exporter))));
+            }
+        });
+}
+
+void mgo::SoftwareDisplay::register_configuration_change_handler(
+    EventHandlerRegister&,
+    DisplayConfigurationChangeHandler const&)
+{
+}
+
+void mgo::SoftwareDisplay::register_pause_resume_handlers(
+    EventHandlerRegister&,
+    DisplayPauseHandler const&,
+    DisplayResumeHandler const&)
+{
+}
+
+void mgo::SoftwareDisplay::pause()
+{
+}
+
+void mgo::SoftwareDisplay::resume()
+{
+}
+
+std::shared_ptr<mg::Cursor> mgo::SoftwareDisplay::create_hardware_cursor()
+{
+    return {};
+}
+
+mg::NativeDisplay* mgo::SoftwareDisplay::native_display()
+{
+    return this;
+}
+
+mg::Frame mgo::SoftwareDisplay::last_frame_on(unsigned) const
+{
+    return {};
+}
+
+std::unique_ptr<mg::VirtualOutput> mgo::SoftwareDisplay::create_virtual_output(int /*width*/, int /*height*/)
+{
+    return nullptr;
+}
+
+bool mgo::SoftwareDisplay::apply_if_configuration_preserves_display_buffers(mg::DisplayConfiguration const&)
+{
+    return false;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_OFFSCREEN_SOFTWARE_DISPLAY_H_
+#define MIR_GRAPHICS_OFFSCREEN_SOFTWARE_DISPLAY_H_
+
+#include "mir/graphics/display.h"
+#include "display_configuration.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mir
+{
+namespace graphics
+{
+
+class DisplayConfigurationPolicy;
+
+namespace offscreen
+{
+/**
+ * An offscreen display whose outputs are composited by the software
+ * renderer into plain memory. Unlike offscreen::Display it needs no EGL,
+ * so it works on hosts without a GPU.
+ *
+ * It is not a renderer::gl::ContextSource, so nothing that needs a GL
+ * context (e.g. GL screencasting) is available.
+ */
+class SoftwareDisplay : public graphics::Display,
+                        public graphics::NativeDisplay
+{
+public:
+    SoftwareDisplay(std::shared_ptr<DisplayConfigurationPolicy> const& initial_conf_policy,
+                    std::string const& frame_export_socket);
+    ~SoftwareDisplay() noexcept;
+
+    void for_each_display_sync_group(std::function<void(DisplaySyncGroup&)> const& f) override;
+
+    std::unique_ptr<graphics::DisplayConfiguration> configuration() const override;
+    void configure(graphics::DisplayConfiguration const& conf) override;
+
+    void register_configuration_change_handler(
+        EventHandlerRegister& handlers,
+        DisplayConfigurationChangeHandler const& conf_change_handler) override;
+
+    void register_pause_resume_handlers(
+        EventHandlerRegister& handlers,
+        DisplayPauseHandler const& pause_handler,
+        DisplayResumeHandler const& resume_handler) override;
+
+    void pause() override;
+    void resume() override;
+
+    std::shared_ptr<Cursor> create_hardware_cursor() override;
+    std::unique_ptr<VirtualOutput> create_virtual_output(int width, int height) override;
+
+    NativeDisplay* native_display() override;
+    Frame last_frame_on(unsigned output_id) const override;
+
+    bool apply_if_configuration_preserves_display_buffers(graphics::DisplayConfiguration const& conf) override;
+
+private:
+    mutable std::mutex configuration_mutex;
+    DisplayConfiguration current_display_configuration;
+    std::vector<std::unique_ptr<DisplaySyncGroup>> display_sync_groups;
+    std::string const frame_export_socket;
+};
+
+}
+}
+}
+
+#endif /* MIR_GRAPHICS_OFFSCREEN_SOFTWARE_DISPLAY_H_ */
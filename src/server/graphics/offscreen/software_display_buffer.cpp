@@ -0,0 +1,98 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "software_display_buffer.h"
+#include "frame_exporter.h"
+
+#include <cstring>
+
+namespace mg = mir::graphics;
+namespace mgo = mg::offscreen;
+namespace geom = mir::geometry;
+
+namespace
+{
+/// Matches what the frame exporter hands out
+MirPixelFormat const format{mir_pixel_format_abgr_8888};
+}
+
+mgo::SoftwareDisplayBuffer::SoftwareDisplayBuffer(geom::Rectangle const& area)
+    : SoftwareDisplayBuffer{area, nullptr}
+{
+}
+
+mgo::SoftwareDisplayBuffer::SoftwareDisplayBuffer(
+    geom::Rectangle const& area,
+    std::unique_ptr<FrameExporter> exporter)
+    : area{area},
+      exporter{std::move(exporter)},
+      pixels(area.size.width.as_int() * area.size.height.as_int() * MIR_BYTES_PER_PIXEL(format))
+{
+}
+
+mgo::SoftwareDisplayBuffer::~SoftwareDisplayBuffer() = default;
+
+geom::Rectangle mgo::SoftwareDisplayBuffer::view_area() const
+{
+    return area;
+}
+
+bool mgo::SoftwareDisplayBuffer::overlay(RenderableList const&)
+{
+    return false;
+}
+
+glm::mat2 mgo::SoftwareDisplayBuffer::transformation() const
+{
+    return glm::mat2(1);
+}
+
+mg::NativeDisplayBuffer* mgo::SoftwareDisplayBuffer::native_display_buffer()
+{
+    return this;
+}
+
+MirPixelFormat mgo::SoftwareDisplayBuffer::pixel_format() const
+{
+    return format;
+}
+
+geom::Size mgo::SoftwareDisplayBuffer::size() const
+{
+    return area.size;
+}
+
+geom::Stride mgo::SoftwareDisplayBuffer::stride() const
+{
+    return geom::Stride{area.size.width.as_int() * MIR_BYTES_PER_PIXEL(format)};
+}
+
+void mgo::SoftwareDisplayBuffer::write(std::function<void(unsigned char* pixels)> const& do_with_pixels)
+{
+    do_with_pixels(pixels.data());
+}
+
+void mgo::SoftwareDisplayBuffer::swap_buffers()
+{
+    if (auto const slot = exporter ? exporter->begin_frame() : nullptr)
+    {
+        auto const row_bytes = stride().as_int();
+        for (int y = 0; y != area.size.height.as_int(); ++y)
+            memcpy(slot + y * exporter->stride(), pixels.data() + y * row_bytes, row_bytes);
+
+        exporter->end_frame(FrameExporter::RowOrder::top_first);
+    }
+}
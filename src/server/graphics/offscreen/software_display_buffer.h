@@ -0,0 +1,70 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_OFFSCREEN_SOFTWARE_DISPLAY_BUFFER_H_
+#define MIR_GRAPHICS_OFFSCREEN_SOFTWARE_DISPLAY_BUFFER_H_
+
+#include "mir/graphics/display_buffer.h"
+#include "mir/geometry/rectangle.h"
+#include "mir/renderer/sw/render_target.h"
+
+#include <memory>
+#include <vector>
+
+namespace mir
+{
+namespace graphics
+{
+namespace offscreen
+{
+class FrameExporter;
+
+/**
+ * An offscreen display buffer in plain memory, for the software renderer
+ * when there is no GPU (or it isn't wanted).
+ */
+class SoftwareDisplayBuffer : public graphics::DisplayBuffer,
+                              public graphics::NativeDisplayBuffer,
+                              public renderer::software::RenderTarget
+{
+public:
+    explicit SoftwareDisplayBuffer(geometry::Rectangle const& area);
+    /// Also hands every swapped frame to \a exporter
+    SoftwareDisplayBuffer(geometry::Rectangle const& area, std::unique_ptr<FrameExporter> exporter);
+    ~SoftwareDisplayBuffer();
+
+    geometry::Rectangle view_area() const override;
+    bool overlay(RenderableList const& renderlist) override;
+    glm::mat2 transformation() const override;
+    NativeDisplayBuffer* native_display_buffer() override;
+
+    MirPixelFormat pixel_format() const override;
+    geometry::Size size() const override;
+    geometry::Stride stride() const override;
+    void write(std::function<void(unsigned char* pixels)> const& do_with_pixels) override;
+    void swap_buffers() override;
+
+private:
+    geometry::Rectangle const area;
+    std::unique_ptr<FrameExporter> const exporter;
+    std::vector<unsigned char> pixels;
+};
+
+}
+}
+}
+
+#endif /* MIR_GRAPHICS_OFFSCREEN_SOFTWARE_DISPLAY_BUFFER_H_ */
@@ -17,11 +17,30 @@
  */
 
 #include "mir/log.h"
+#include "mir/libname.h"
+#include "mir/raii.h"
+#include "mir/console_services.h"
 #include "mir/graphics/platform.h"
+#include "mir/options/configuration.h"
 #include "platform_probe.h"
 
 #include <boost/throw_exception.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <sstream>
+
+#include <dirent.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+namespace mo = mir::options;
+
 auto mir::graphics::probe_module(
     mir::SharedLibrary& module,
     mir::options::ProgramOption const& options,
@@ -89,23 +108,272 @@ auto mir::graphics::probe_module(
 }
 
 
+namespace
+{
+auto module_path(mir::SharedLibrary const& module) -> std::string
+{
+    // Every graphics module has a probe; any symbol in it will do
+    try
+    {
+        return mir::detail::libname_impl(module.load_function<void*>("probe_graphics_platform"));
+    }
+    catch (std::runtime_error const&)
+    {
+        return {};
+    }
+}
+
+auto read_file(std::string const& filename) -> std::string
+{
+    std::ifstream in{filename};
+    std::string contents;
+    std::getline(in, contents);
+    return contents;
+}
+
+/*
+ * Everything that would change the outcome of probing: which modules there
+ * are (and whether they've been rebuilt), which DRM devices are present, and
+ * what the nested platforms would connect to.
+ */
+auto probe_cache_key(
+    std::vector<std::shared_ptr<mir::SharedLibrary>> const& modules,
+    mir::options::ProgramOption const& options) -> std::string
+{
+    std::ostringstream key;
+
+    for (auto const& module : modules)
+    {
+        auto const path = module_path(*module);
+        struct stat info;
+        if (!path.empty() && stat(path.c_str(), &info) == 0)
+            key << path << ':' << info.st_mtime << ':' << info.st_size << '\n';
+    }
+
+    std::vector<std::string> cards;
+    if (auto const drm = opendir("/sys/class/drm"))
+    {
+        while (auto const entry = readdir(drm))
+        {
+            std::string const name{entry->d_name};
+            // Skip the connectors (card0-HDMI-A-1, etc)
+            if (name.compare(0, 4, "card") == 0 && name.find('-') == std::string::npos)
+                cards.push_back(name);
+        }
+        closedir(drm);
+    }
+    std::sort(begin(cards), end(cards));
+
+    for (auto const& card : cards)
+    {
+        auto const sys_path = "/sys/class/drm/" + card;
+        char device_path[PATH_MAX];
+        key << card << ':' << (realpath(sys_path.c_str(), device_path) ? device_path : "")
+            << ':' << read_file(sys_path + "/device/vendor")
+            << ':' << read_file(sys_path + "/device/device") << '\n';
+    }
+
+    for (auto const env : {"DISPLAY", "WAYLAND_DISPLAY"})
+    {
+        auto const value = getenv(env);
+        key << env << '=' << (value ? value : "") << '\n';
+    }
+
+    for (auto const option : {"host-socket", "wayland-host"})
+    {
+        if (options.is_set(option))
+            key << option << '=' << options.get<std::string>(option) << '\n';
+    }
+
+    std::ostringstream hashed;
+    hashed << std::hex << std::hash<std::string>{}(key.str());
+    return hashed.str();
+}
+
+struct CachedProbe
+{
+    std::string module_path;
+    unsigned int priority;
+};
+
+auto read_probe_cache(std::string const& filename, std::string const& key) -> std::unique_ptr<CachedProbe>
+{
+    std::ifstream in{filename};
+    std::string cached_key;
+    auto result = std::make_unique<CachedProbe>();
+
+    if (std::getline(in, cached_key) && cached_key == key &&
+        std::getline(in, result->module_path) && in >> result->priority)
+    {
+        return result;
+    }
+
+    return {};
+}
+
+void write_probe_cache(std::string const& filename, std::string const& key, CachedProbe const& probe)
+{
+    // Write and rename, so a concurrently starting server never sees half a file
+    auto const temporary = filename + ".new";
+    {
+        std::ofstream out{temporary, std::ios::trunc};
+        out << key << '\n' << probe.module_path << '\n' << probe.priority << '\n';
+        if (!out)
+        {
+            mir::log_debug("Failed to write platform probe cache %s", temporary.c_str());
+            return;
+        }
+    }
+
+    if (rename(temporary.c_str(), filename.c_str()) != 0)
+    {
+        mir::log_debug("Failed to update platform probe cache %s", filename.c_str());
+        std::remove(temporary.c_str());
+    }
+}
+
+/*
+ * ConsoleServices isn't thread-safe, and a probe that uses it is about to
+ * open and initialise a device. So the first call a probe makes through this
+ * waits for any other such probe to finish, and it keeps the console to
+ * itself until it is finished too. Probes that never touch the console (those
+ * connecting to a host server, say) still run alongside each other.
+ */
+class ProbeConsoleServices : public mir::ConsoleServices
+{
+public:
+    ProbeConsoleServices(std::shared_ptr<ConsoleServices> const& console, std::mutex& console_mutex)
+        : console{console},
+          held{console_mutex, std::defer_lock}
+    {
+    }
+
+    void register_switch_handlers(
+        mir::graphics::EventHandlerRegister& handlers,
+        std::function<bool()> const& switch_away,
+        std::function<bool()> const& switch_back) override
+    {
+        hold();
+        console->register_switch_handlers(handlers, switch_away, switch_back);
+    }
+
+    void restore() override
+    {
+        hold();
+        console->restore();
+    }
+
+    auto create_vt_switcher() -> std::unique_ptr<mir::VTSwitcher> override
+    {
+        hold();
+        return console->create_vt_switcher();
+    }
+
+    auto acquire_device(int major, int minor, std::unique_ptr<mir::Device::Observer> observer)
+        -> std::future<std::unique_ptr<mir::Device>> override
+    {
+        hold();
+        return console->acquire_device(major, minor, std::move(observer));
+    }
+
+    /// Called on the probing thread once the probe has returned
+    void probe_finished()
+    {
+        if (held.owns_lock())
+            held.unlock();
+        finished = true;
+    }
+
+private:
+    void hold()
+    {
+        // Once the probe is over (should it have kept us) the console is no longer ours to hold
+        if (!finished && !held.owns_lock())
+            held.lock();
+    }
+
+    std::shared_ptr<ConsoleServices> const console;
+    std::unique_lock<std::mutex> held;
+    std::atomic<bool> finished{false};
+};
+}
+
 std::shared_ptr<mir::SharedLibrary>
 mir::graphics::module_for_device(
     std::vector<std::shared_ptr<SharedLibrary>> const& modules,
     mir::options::ProgramOption const& options,
     std::shared_ptr<ConsoleServices> const& console)
 {
+    // ProgramOption is only read (and fully parsed already), so the probes may share it
+    std::mutex console_mutex;
+
+    return select_module(
+        modules,
+        options,
+        [&options, &console, &console_mutex](SharedLibrary& module)
+        {
+            auto const probe_console = console ?
+                std::make_shared<ProbeConsoleServices>(console, console_mutex) : nullptr;
+            auto const release_console = mir::raii::deleter_for(
+                probe_console.get(),
+                [](ProbeConsoleServices* console) { console->probe_finished(); });
+
+            return probe_module(module, options, probe_console);
+        });
+}
+
+std::shared_ptr<mir::SharedLibrary>
+mir::graphics::select_module(
+    std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+    mir::options::ProgramOption const& options,
+    std::function<PlatformPriority(SharedLibrary& module)> const& probe)
+{
+    auto const cache_file =
+        options.is_set(mo::platform_probe_cache) ? options.get<std::string>(mo::platform_probe_cache) : "";
+    auto const cache_key = cache_file.empty() ? "" : probe_cache_key(modules, options);
+
+    // Nothing relevant has changed since we last probed, so the module we
+    // chose then should still be the best; check that it still says so.
+    if (auto const cached = cache_file.empty() ? nullptr : read_probe_cache(cache_file, cache_key))
+    {
+        for (auto const& module : modules)
+        {
+            if (module_path(*module) != cached->module_path)
+                continue;
+
+            try
+            {
+                if (probe(*module) == cached->priority)
+                    return module;
+            }
+            catch (std::runtime_error const&)
+            {
+            }
+            break;
+        }
+    }
+
+    // Each probe can involve udev, DRM, EGL or a host server, so run them all at once.
+    std::vector<std::future<PlatformPriority>> probes;
+    probes.reserve(modules.size());
+    for (auto const& module : modules)
+    {
+        probes.push_back(std::async(
+            std::launch::async,
+            [module, &probe] { return probe(*module); }));
+    }
+
     mir::graphics::PlatformPriority best_priority_so_far = mir::graphics::unsupported;
     std::shared_ptr<mir::SharedLibrary> best_module_so_far;
-    for (auto& module : modules)
+    for (auto i = 0u; i != modules.size(); ++i)
     {
         try
         {
-            auto module_priority = probe_module(*module, options, console);
+            auto module_priority = probes[i].get();
             if (module_priority > best_priority_so_far)
             {
                 best_priority_so_far = module_priority;
-                best_module_so_far = module;
+                best_module_so_far = modules[i];
             }
         }
         catch (std::runtime_error const&)
@@ -114,6 +382,9 @@ mir::graphics::module_for_device(
     }
     if (best_priority_so_far > mir::graphics::unsupported)
     {
+        if (!cache_file.empty())
+            write_probe_cache(cache_file, cache_key, {module_path(*best_module_so_far), static_cast<unsigned int>(best_priority_so_far)});
+
         return best_module_so_far;
     }
     BOOST_THROW_EXCEPTION((std::runtime_error{"Failed to find platform for current system"}));
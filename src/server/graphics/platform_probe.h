@@ -19,6 +19,7 @@
 #ifndef MIR_GRAPHICS_PLATFORM_PROBE_H_
 #define MIR_GRAPHICS_PLATFORM_PROBE_H_
 
+#include <functional>
 #include <vector>
 #include <memory>
 #include "mir/shared_library.h"
@@ -43,6 +44,12 @@ std::shared_ptr<SharedLibrary> module_for_device(
     options::ProgramOption const& options,
     std::shared_ptr<ConsoleServices> const& console);
 
+/// The workings of module_for_device(); \a probe may be called from several threads at once
+std::shared_ptr<SharedLibrary> select_module(
+    std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+    options::ProgramOption const& options,
+    std::function<PlatformPriority(SharedLibrary& module)> const& probe);
+
 }
 }
 
@@ -43,6 +43,11 @@ void ms::ApplicationNotRespondingDetectorWrapper::pong_received(scene::Session c
     wrapped->pong_received(received_for);
 }
 
+void ms::ApplicationNotRespondingDetectorWrapper::activity_received(scene::Session const* session)
+{
+    wrapped->activity_received(session);
+}
+
 void ms::ApplicationNotRespondingDetectorWrapper::register_observer(std::shared_ptr<Observer> const& observer)
 {
     wrapped->register_observer(observer);
@@ -48,14 +48,12 @@ class SurfaceSceneElement : public mc::SceneElement
 {
 public:
     SurfaceSceneElement(
-        std::string name,
         std::shared_ptr<mg::Renderable> const& renderable,
         std::shared_ptr<ms::RenderingTracker> const& tracker,
         mc::CompositorID id)
         : renderable_{renderable},
           tracker{tracker},
-          cid{id},
-          surface_name(name)
+          cid{id}
     {
     }
 
@@ -78,7 +76,6 @@ private:
     std::shared_ptr<mg::Renderable> const renderable_;
     std::shared_ptr<ms::RenderingTracker> const tracker;
     mc::CompositorID cid;
-    std::string const surface_name;
 };
 
 //note: something different than a 2D/HWC overlay
@@ -128,11 +125,33 @@ private:
     ms::SurfaceStack* stack;
 };
 
+bool could_appear_in(mg::Renderable const& renderable, geom::Rectangle const& area)
+{
+    static glm::mat4 const identity(1);
+
+    if (renderable.transformation() != identity)
+        return true;  // Weirdly transformed. Leave it to the compositor.
+
+    auto position = renderable.screen_position();
+    if (auto const clip_area = renderable.clip_area())
+        position = position.intersection_with(clip_area.value());
+
+    return position.overlaps(area);
+}
 }
 
+struct ms::SurfaceStack::StackSnapshot
+{
+    /// All surfaces, bottom to top across the depth layers
+    std::vector<SurfaceEntry> surfaces;
+    std::vector<std::shared_ptr<mg::Renderable>> overlays;
+    std::map<mc::CompositorID, geom::Rectangle> compositor_areas;
+};
+
 ms::SurfaceStack::SurfaceStack(
     std::shared_ptr<SceneReport> const& report) :
     report{report},
+    stack_snapshot{std::make_shared<StackSnapshot>()},
     scene_changed{false},
     surface_observer{std::make_shared<SurfaceDepthLayerObserver>(this)}
 {
@@ -152,59 +171,91 @@ ms::SurfaceStack::~SurfaceStack() noexcept(true)
 
 mc::SceneElementSequence ms::SurfaceStack::scene_elements_for(mc::CompositorID id)
 {
-    RecursiveReadLock lg(guard);
+    auto const snapshot = std::atomic_load(&stack_snapshot);
+    auto const area = snapshot->compositor_areas.find(id);
+    bool const partitioned = area != snapshot->compositor_areas.end();
 
     scene_changed = false;
     mc::SceneElementSequence elements;
-    for (auto const& layer : surface_layers)
+    std::vector<SurfaceEntry> members;
+    elements.reserve(snapshot->surfaces.size() + snapshot->overlays.size());
+    for (auto const& entry : snapshot->surfaces)
     {
-        for (auto const& surface : layer)
+        if (entry.surface->visible())
         {
-            if (surface->visible())
+            auto const renderables = entry.surface->generate_renderables(id);
+            bool member = !partitioned;
+            for (auto& renderable : renderables)
+            {
+                // Don't hand the compositor what can't appear in its display buffers
+                if (partitioned && !could_appear_in(*renderable, area->second))
+                    continue;
+
+                member = true;
+                elements.emplace_back(
+                    std::make_shared<SurfaceSceneElement>(
+                        renderable,
+                        entry.tracker,
+                        id));
+            }
+
+            if (partitioned)
             {
-                for (auto& renderable : surface->generate_renderables(id))
-                {
-                    elements.emplace_back(
-                        std::make_shared<SurfaceSceneElement>(
-                            surface->name(),
-                            renderable,
-                            rendering_trackers[surface.get()],
-                            id));
-                }
+                if (member)
+                    members.push_back(entry);
+                else if (!renderables.empty())
+                    entry.tracker->occluded_in(id);  // As the compositor would have found
             }
         }
     }
-    for (auto const& renderable : overlays)
+    for (auto const& renderable : snapshot->overlays)
     {
         elements.emplace_back(std::make_shared<OverlaySceneElement>(renderable));
     }
+
+    if (partitioned)
+    {
+        std::lock_guard<std::mutex> lock{compositor_surfaces_mutex};
+        compositor_surfaces[id] = std::move(members);
+    }
+
     return elements;
 }
 
 int ms::SurfaceStack::frames_pending(mc::CompositorID id) const
 {
-    RecursiveReadLock lg(guard);
+    auto const snapshot = std::atomic_load(&stack_snapshot);
 
     int result = scene_changed ? 1 : 0;
-    for (auto const& layer : surface_layers)
-    {
-        for (auto const& surface : layer)
+    auto const count_frames_ready = [&result, id](SurfaceEntry const& entry)
         {
-            if (surface->visible())
+            if (entry.surface->visible() && entry.tracker->is_exposed_in(id))
             {
-                auto const tracker = rendering_trackers.find(surface.get());
-                if (tracker != rendering_trackers.end() && tracker->second->is_exposed_in(id))
-                {
-                    // Note that we ask the surface and not a Renderable.
-                    // This is because we don't want to waste time and resources
-                    // on a snapshot till we're sure we need it...
-                    int ready = surface->buffers_ready_for_compositor(id);
-                    if (ready > result)
-                        result = ready;
-                }
+                // Note that we ask the surface and not a Renderable.
+                // This is because we don't want to waste time and resources
+                // on a snapshot till we're sure we need it...
+                int ready = entry.surface->buffers_ready_for_compositor(id);
+                if (ready > result)
+                    result = ready;
             }
+        };
+
+    if (snapshot->compositor_areas.count(id))
+    {
+        // Surfaces outside the compositor's area schedule compositing (with damage) when they move into it
+        std::lock_guard<std::mutex> lock{compositor_surfaces_mutex};
+        auto const surfaces = compositor_surfaces.find(id);
+        if (surfaces != compositor_surfaces.end())
+        {
+            for (auto const& entry : surfaces->second)
+                count_frames_ready(entry);
         }
     }
+    else
+    {
+        for (auto const& entry : snapshot->surfaces)
+            count_frames_ready(entry);
+    }
     return result;
 }
 
@@ -222,16 +273,32 @@ void ms::SurfaceStack::unregister_compositor(mc::CompositorID cid)
     RecursiveWriteLock lg(guard);
 
     registered_compositors.erase(cid);
+    if (compositor_areas.erase(cid))
+    {
+        publish_stack_snapshot(lg);
+
+        std::lock_guard<std::mutex> lock{compositor_surfaces_mutex};
+        compositor_surfaces.erase(cid);
+    }
 
     update_rendering_tracker_compositors();
 }
 
+void ms::SurfaceStack::set_compositor_area(mc::CompositorID cid, geom::Rectangle const& area)
+{
+    RecursiveWriteLock lg(guard);
+
+    compositor_areas[cid] = area;
+    publish_stack_snapshot(lg);
+}
+
 void ms::SurfaceStack::add_input_visualization(
     std::shared_ptr<mg::Renderable> const& overlay)
 {
     {
         RecursiveWriteLock lg(guard);
         overlays.push_back(overlay);
+        publish_stack_snapshot(lg);
     }
     emit_scene_changed();
 }
@@ -248,6 +315,7 @@ void ms::SurfaceStack::remove_input_visualization(
             BOOST_THROW_EXCEPTION(std::runtime_error("Attempt to remove an overlay which was never added or which has been previously removed"));
         }
         overlays.erase(p);
+        publish_stack_snapshot(lg);
     }
     
     emit_scene_changed();
@@ -270,6 +338,7 @@ void ms::SurfaceStack::add_surface(
         RecursiveWriteLock lg(guard);
         insert_surface_at_top_of_depth_layer(surface);
         create_rendering_tracker_for(surface);
+        publish_stack_snapshot(lg);
         surface->add_observer(surface_observer);
     }
     surface->set_reception_mode(input_mode);
@@ -294,6 +363,7 @@ void ms::SurfaceStack::remove_surface(std::weak_ptr<Surface> const& surface)
             {
                 layer.erase(surface);
                 rendering_trackers.erase(keep_alive.get());
+                publish_stack_snapshot(lg);
                 keep_alive->remove_observer(surface_observer);
                 found_surface = true;
                 break;
@@ -375,6 +445,7 @@ void ms::SurfaceStack::raise(Surface const* surface)
                 std::shared_ptr<Surface> surface_shared = *p;
                 layer.erase(p);
                 insert_surface_at_top_of_depth_layer(surface_shared);
+                publish_stack_snapshot(ul);
                 surfaces_reordered = true;
                 break;
             }
@@ -421,6 +492,9 @@ void ms::SurfaceStack::raise(SurfaceSet const& ss)
             if (old_layer != layer)
                 surfaces_reordered = true;
         }
+
+        if (surfaces_reordered)
+            publish_stack_snapshot(ul);
     }
 
     if (surfaces_reordered)
@@ -452,6 +526,25 @@ void ms::SurfaceStack::insert_surface_at_top_of_depth_layer(std::shared_ptr<Surf
     surface_layers[depth_index].push_back(surface);
 }
 
+void ms::SurfaceStack::publish_stack_snapshot(RecursiveWriteLock const&)
+{
+    auto const snapshot = std::make_shared<StackSnapshot>();
+
+    for (auto const& layer : surface_layers)
+    {
+        for (auto const& surface : layer)
+        {
+            auto const tracker = rendering_trackers.find(surface.get());
+            if (tracker != rendering_trackers.end())
+                snapshot->surfaces.push_back({surface, tracker->second});
+        }
+    }
+    snapshot->overlays = overlays;
+    snapshot->compositor_areas = compositor_areas;
+
+    std::atomic_store(&stack_snapshot, std::shared_ptr<StackSnapshot const>{snapshot});
+}
+
 void ms::SurfaceStack::add_observer(std::shared_ptr<ms::Observer> const& observer)
 {
     observers.add(observer);
@@ -82,6 +82,7 @@ public:
     int frames_pending(compositor::CompositorID) const override;
     void register_compositor(compositor::CompositorID id) override;
     void unregister_compositor(compositor::CompositorID id) override;
+    void set_compositor_area(compositor::CompositorID id, geometry::Rectangle const& area) override;
 
     // From Scene
     void for_each(std::function<void(std::shared_ptr<input::Surface> const&)> const& callback) override;
@@ -113,6 +114,7 @@ private:
     void create_rendering_tracker_for(std::shared_ptr<Surface> const&);
     void update_rendering_tracker_compositors();
     void insert_surface_at_top_of_depth_layer(std::shared_ptr<Surface> const& surface);
+    void publish_stack_snapshot(RecursiveWriteLock const&);
 
     RecursiveReadWriteMutex mutable guard;
 
@@ -130,6 +132,26 @@ private:
     std::set<compositor::CompositorID> registered_compositors;
     
     std::vector<std::shared_ptr<graphics::Renderable>> overlays;
+    std::map<compositor::CompositorID, geometry::Rectangle> compositor_areas;
+
+    struct SurfaceEntry
+    {
+        std::shared_ptr<Surface> surface;
+        std::shared_ptr<RenderingTracker> tracker;
+    };
+
+    /**
+     * An immutable copy of the stack (and the rendering tracker for each surface) for the compositor threads
+     *
+     * It is rebuilt under the write lock whenever the stack changes and published with std::atomic_store(), so
+     * scene_elements_for() and frames_pending() can walk it without taking the guard.
+     */
+    struct StackSnapshot;
+    std::shared_ptr<StackSnapshot const> stack_snapshot;
+
+    /// For each compositor with an area, the surfaces it was last given elements for
+    std::mutex mutable compositor_surfaces_mutex;
+    std::map<compositor::CompositorID, std::vector<SurfaceEntry>> compositor_surfaces;
 
     Observers observers;
     std::atomic<bool> scene_changed;
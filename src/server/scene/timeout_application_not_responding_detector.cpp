@@ -21,6 +21,8 @@
 
 #include "mir/time/alarm_factory.h"
 
+#include <atomic>
+
 namespace ms = mir::scene;
 namespace mt = mir::time;
 
@@ -29,12 +31,15 @@ struct ms::TimeoutApplicationNotRespondingDetector::ANRContext
     ANRContext(std::function<void()> const& pinger)
         : pinger{pinger},
           replied_since_last_ping{true},
+          active_since_last_check{false},
           flagged_as_unresponsive{false}
     {
     }
 
     std::function<void()> const pinger;
+    std::unique_ptr<mt::Alarm> alarm;
     bool replied_since_last_ping;
+    std::atomic<bool> active_since_last_check;  ///< Set with session_mutex only held shared
     bool flagged_as_unresponsive;
 };
 
@@ -53,8 +58,8 @@ void ms::TimeoutApplicationNotRespondingDetector::ANRObservers::session_now_resp
 ms::TimeoutApplicationNotRespondingDetector::TimeoutApplicationNotRespondingDetector(
     mt::AlarmFactory& alarms,
     std::chrono::milliseconds period)
-    : period{period},
-      alarm{alarms.create_alarm(std::bind(&TimeoutApplicationNotRespondingDetector::handle_ping_cycle, this))}
+    : alarms{alarms},
+      period{period}
 {
 }
 
@@ -65,32 +70,47 @@ ms::TimeoutApplicationNotRespondingDetector::~TimeoutApplicationNotRespondingDet
 void ms::TimeoutApplicationNotRespondingDetector::register_session(
     scene::Session const* session, std::function<void()> const& pinger)
 {
-    bool alarm_needs_schedule;
-    {
-        std::lock_guard<std::mutex> lock{session_mutex};
-        sessions[dynamic_cast<Session const*>(session)] = std::make_unique<ANRContext>(pinger);
-        alarm_needs_schedule = alarm->state() != mt::Alarm::State::pending;
-    }
-    if (alarm_needs_schedule)
+    // Each session is pinged on its own alarm, a period after it registered or
+    // was last pinged, so sessions don't all come due at once.
+    auto context = std::make_unique<ANRContext>(pinger);
+    auto const context_ptr = context.get();
+    context->alarm = alarms.create_alarm(
+        [this, session, context_ptr]() { handle_ping_due(session, context_ptr); });
+
+    // Destroyed outside the lock, as destroying an alarm waits for its
+    // callback and the callback takes session_mutex
+    std::unique_ptr<ANRContext> replaced;
     {
-        alarm->reschedule_in(period);
+        std::lock_guard<std::shared_timed_mutex> lock{session_mutex};
+        auto& entry = sessions[dynamic_cast<Session const*>(session)];
+        replaced = std::move(entry);
+        entry = std::move(context);
+        entry->alarm->reschedule_in(period);
     }
 }
 
 void ms::TimeoutApplicationNotRespondingDetector::unregister_session(
     scene::Session const* session)
 {
-    std::lock_guard<std::mutex> lock{session_mutex};
-    sessions.erase(dynamic_cast<Session const*>(session));
+    // Destroyed outside the lock, as for register_session()
+    std::unique_ptr<ANRContext> removed;
+    {
+        std::lock_guard<std::shared_timed_mutex> lock{session_mutex};
+        auto const i = sessions.find(dynamic_cast<Session const*>(session));
+        if (i == sessions.end())
+            return;
+
+        removed = std::move(i->second);
+        sessions.erase(i);
+    }
 }
 
 void ms::TimeoutApplicationNotRespondingDetector::pong_received(
    scene::Session const* received_for)
 {
     bool needs_now_responsive_notification{false};
-    bool alarm_needs_rescheduling;
     {
-        std::lock_guard<std::mutex> lock{session_mutex};
+        std::lock_guard<std::shared_timed_mutex> lock{session_mutex};
 
         auto& session_ctx = sessions.at(dynamic_cast<Session const*>(received_for));
         if (session_ctx->flagged_as_unresponsive)
@@ -100,16 +120,25 @@ void ms::TimeoutApplicationNotRespondingDetector::pong_received(
         }
         session_ctx->replied_since_last_ping = true;
 
-        alarm_needs_rescheduling = alarm->state() != mt::Alarm::State::pending;
+        if (session_ctx->alarm->state() != mt::Alarm::State::pending)
+            session_ctx->alarm->reschedule_in(period);
     }
     if (needs_now_responsive_notification)
     {
         observers.session_now_responsive(dynamic_cast<Session const*>(received_for));
     }
-    if (alarm_needs_rescheduling)
-    {
-        alarm->reschedule_in(period);
-    }
+}
+
+void ms::TimeoutApplicationNotRespondingDetector::activity_received(
+    scene::Session const* session)
+{
+    // Just note it: the session's alarm is left alone, and skips the next ping. This is
+    // called on every buffer submission, so concurrent callers mustn't serialise here.
+    std::shared_lock<std::shared_timed_mutex> lock{session_mutex};
+
+    auto const i = sessions.find(dynamic_cast<Session const*>(session));
+    if (i != sessions.end())
+        i->second->active_since_last_check = true;
 }
 
 void ms::TimeoutApplicationNotRespondingDetector::register_observer(
@@ -119,7 +148,7 @@ void ms::TimeoutApplicationNotRespondingDetector::register_observer(
 
     std::vector<Session const*> unresponsive_sessions;
     {
-        std::lock_guard<std::mutex> lock{session_mutex};
+        std::shared_lock<std::shared_timed_mutex> lock{session_mutex};
         for (auto const& session_pair : sessions)
         {
             if (session_pair.second->flagged_as_unresponsive)
@@ -141,43 +170,41 @@ void ms::TimeoutApplicationNotRespondingDetector::unregister_observer(
     observers.remove(observer);
 }
 
-void ms::TimeoutApplicationNotRespondingDetector::handle_ping_cycle()
+void ms::TimeoutApplicationNotRespondingDetector::handle_ping_due(
+    Session const* session, ANRContext* context)
 {
-    bool needs_rearm{false};
+    bool newly_unresponsive{false};
     {
-        std::lock_guard<std::mutex> lock{session_mutex};
-        for (auto const& session_pair : sessions)
-        {
-            bool const newly_unresponsive =
-                !session_pair.second->replied_since_last_ping &&
-                !session_pair.second->flagged_as_unresponsive;
-            bool const needs_ping =
-                session_pair.second->replied_since_last_ping;
+        std::lock_guard<std::shared_timed_mutex> lock{session_mutex};
 
-            if (newly_unresponsive)
-            {
-                session_pair.second->flagged_as_unresponsive = true;
-                unresponsive_sessions_temporary.push_back(session_pair.first);
-            }
-            else if (needs_ping)
-            {
-                session_pair.second->pinger();
-                session_pair.second->replied_since_last_ping = false;
-                needs_rearm = true;
-            }
+        // The session may have been unregistered (or re-registered) while we
+        // waited for the lock
+        auto const i = sessions.find(session);
+        if (i == sessions.end() || i->second.get() != context)
+            return;
+
+        if (!context->replied_since_last_ping)
+        {
+            // Leave the alarm idle until the session pongs
+            newly_unresponsive = !context->flagged_as_unresponsive;
+            context->flagged_as_unresponsive = true;
+        }
+        else if (context->active_since_last_check.exchange(false))
+        {
+            // A session that has been making requests is evidently alive
+            context->alarm->reschedule_in(period);
+        }
+        else
+        {
+            context->pinger();
+            context->replied_since_last_ping = false;
+            context->alarm->reschedule_in(period);
         }
     }
 
     // Dispatch notifications outside the lock.
-    for (auto const& unresponsive_session : unresponsive_sessions_temporary)
-    {
-        observers.session_unresponsive(unresponsive_session);
-    }
-
-    unresponsive_sessions_temporary.clear();
-
-    if (needs_rearm)
+    if (newly_unresponsive)
     {
-        this->alarm->reschedule_in(this->period);
+        observers.session_unresponsive(session);
     }
 }
@@ -25,6 +25,7 @@
 #include <chrono>
 #include <unordered_map>
 #include <functional>
+#include <shared_mutex>
 
 namespace mir
 {
@@ -60,14 +61,15 @@ public:
     void unregister_session(scene::Session const* session) override;
 
     void pong_received(scene::Session const* received_for) override;
+    void activity_received(scene::Session const* session) override;
 
     void register_observer(std::shared_ptr<Observer> const& observer) override;
     void unregister_observer(std::shared_ptr<Observer> const& observer) override;
 private:
-    void handle_ping_cycle();
-
     struct ANRContext;
 
+    void handle_ping_due(Session const* session, ANRContext* context);
+
     class ANRObservers : public Observer, private BasicObservers<Observer>
     {
     public:
@@ -78,12 +80,12 @@ private:
         void session_now_responsive(Session const* session) override;
     } observers;
 
-    std::mutex session_mutex;
-    std::unordered_map<Session const*, std::unique_ptr<ANRContext>> sessions;
-    std::vector<Session const*> unresponsive_sessions_temporary;
-
+    time::AlarmFactory& alarms;
     std::chrono::milliseconds const period;
-    std::unique_ptr<time::Alarm> const alarm;
+
+    /// Exclusive to change the map or a session's state; activity_received() only needs it shared
+    std::shared_timed_mutex session_mutex;
+    std::unordered_map<Session const*, std::unique_ptr<ANRContext>> sessions;
 };
 }
 }
@@ -535,6 +535,15 @@ void mir::Server::set_wayland_extension_filter(
     }
 }
 
+void mir::Server::set_wayland_pointer_coalescing_filter(
+    std::function<bool(std::shared_ptr<scene::Session> const&)> const& filter)
+{
+    if (auto const config = self->server_config)
+    {
+        config->set_wayland_pointer_coalescing_filter(filter);
+    }
+}
+
 void mir::Server::set_enabled_wayland_extensions(std::vector<std::string> const& extensions)
 {
     if (auto const config = self->server_config)
@@ -0,0 +1,217 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/time/timer_wheel.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace mt = mir::time;
+
+namespace
+{
+auto first_set(uint64_t bits) -> unsigned int
+{
+    return __builtin_ctzll(bits);
+}
+}
+
+mt::TimerWheel::TimerWheel(Timestamp origin, Duration tick) :
+    origin{origin},
+    tick{tick}
+{
+}
+
+auto mt::TimerWheel::schedule(Timer& timer, Timestamp time) -> bool
+{
+    auto const was_scheduled = cancel(timer);
+
+    timer.time = time;
+    insert(timer, tick_at_or_after(time));
+
+    return was_scheduled;
+}
+
+auto mt::TimerWheel::cancel(Timer& timer) -> bool
+{
+    if (!timer.is_scheduled())
+        return false;
+
+    unlink(timer);
+    return true;
+}
+
+void mt::TimerWheel::expire(Timestamp now, std::vector<Timer*>& expired)
+{
+    while (auto const timer = overdue)
+    {
+        unlink(*timer);
+        expired.push_back(timer);
+    }
+
+    if (now < origin)
+        return;
+
+    auto const last = static_cast<uint64_t>((now - origin) / tick);
+
+    while (scheduled && current <= last)
+    {
+        // At the start of each level's block, bring its next slot down
+        for (int level = 1; level != levels && !(current & ((uint64_t{1} << (slot_bits*level)) - 1)); ++level)
+            cascade(level);
+
+        auto& slot = wheel[0].slots[current & slot_mask];
+        while (auto const timer = slot)
+        {
+            unlink(*timer);
+            expired.push_back(timer);
+        }
+
+        ++current;
+        if (scheduled)
+            current = std::min(next_event_tick(), last + 1);
+    }
+
+    // Nothing left to process before now, so time can skip ahead
+    current = std::max(current, last + 1);
+}
+
+auto mt::TimerWheel::next_deadline() const -> Timestamp
+{
+    if (!scheduled)
+        return Timestamp::max();
+
+    if (overdue)
+        return overdue->time;
+
+    return time_of(next_event_tick());
+}
+
+auto mt::TimerWheel::tick_at_or_after(Timestamp time) const -> uint64_t
+{
+    if (time <= origin)
+        return 0;
+
+    auto const since_origin = time - origin;
+    return since_origin / tick + (since_origin % tick != Duration::zero());
+}
+
+auto mt::TimerWheel::time_of(uint64_t ticks) const -> Timestamp
+{
+    return origin + ticks * tick;
+}
+
+auto mt::TimerWheel::next_event_tick() const -> uint64_t
+{
+    auto result = overdue ? current : std::numeric_limits<uint64_t>::max();
+
+    for (int level = 0; level != levels; ++level)
+    {
+        auto const occupied = wheel[level].occupied;
+        if (!occupied)
+            continue;
+
+        // The first block boundary of this level at or after current, then the
+        // first boundary from there whose slot has something to process
+        auto const shift = slot_bits*level;
+        auto const block = (current + (uint64_t{1} << shift) - 1) >> shift;
+        auto const later = occupied & (~uint64_t{0} << (block & slot_mask));
+        auto const next_block = later ?
+            (block & ~slot_mask) + first_set(later) :
+            (block & ~slot_mask) + slot_count + first_set(occupied);
+
+        result = std::min(result, next_block << shift);
+    }
+
+    return result;
+}
+
+void mt::TimerWheel::insert(Timer& timer, uint64_t due)
+{
+    if (due < current)
+    {
+        timer.level = levels;
+        timer.index = 0;
+    }
+    else
+    {
+        // Anything beyond the wheel's span parks at the far end and is
+        // reinserted each time that slot cascades
+        static uint64_t const span = uint64_t{1} << (slot_bits*levels);
+        auto const delta = std::min(due - current, span - 1);
+        auto const placed = current + delta;
+
+        int level = 0;
+        while (delta >> (slot_bits*(level + 1)))
+            ++level;
+
+        timer.level = level;
+        timer.index = static_cast<unsigned int>((placed >> (slot_bits*level)) & slot_mask);
+        wheel[level].occupied |= uint64_t{1} << timer.index;
+    }
+
+    auto& head = head_of(timer);
+    timer.prev = nullptr;
+    timer.next = head;
+    if (head)
+        head->prev = &timer;
+    head = &timer;
+
+    ++scheduled;
+}
+
+void mt::TimerWheel::unlink(Timer& timer)
+{
+    auto& head = head_of(timer);
+
+    if (timer.prev)
+        timer.prev->next = timer.next;
+    else
+        head = timer.next;
+
+    if (timer.next)
+        timer.next->prev = timer.prev;
+
+    if (!head && timer.level != levels)
+        wheel[timer.level].occupied &= ~(uint64_t{1} << timer.index);
+
+    timer.level = -1;
+    timer.prev = nullptr;
+    timer.next = nullptr;
+    --scheduled;
+}
+
+auto mt::TimerWheel::head_of(Timer const& timer) -> Timer*&
+{
+    return timer.level == levels ? overdue : wheel[timer.level].slots[timer.index];
+}
+
+void mt::TimerWheel::cascade(int level)
+{
+    auto const index = (current >> (slot_bits*level)) & slot_mask;
+
+    auto timer = wheel[level].slots[index];
+    wheel[level].slots[index] = nullptr;
+    wheel[level].occupied &= ~(uint64_t{1} << index);
+
+    while (timer)
+    {
+        auto const next = timer->next;
+        --scheduled;
+        insert(*timer, tick_at_or_after(timer->time));
+        timer = next;
+    }
+}
@@ -31,13 +31,17 @@
 #include <boost/program_options.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <thread>
 #include <iostream>
 #include <stdexcept>
-#include <future>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
 #include <vector>
 #include <utility>
 #include <chrono>
@@ -243,19 +247,273 @@ MirGraphicsRegion graphics_region_for(MirBufferStream* buffer_stream)
     return region;
 }
 
+/**
+ * Optional encoding of the captured frames.
+ *
+ * A delta stream starts with the 8 bytes "MIRDELTA" and a uint32 frame size
+ * in bytes. Each frame is then a sequence of runs covering exactly that many
+ * bytes: a uint32 count of bytes unchanged from the previous frame, a uint32
+ * count of bytes that follow literally, and those bytes. The first frame is
+ * compared against a frame of zeros. All integers are in native byte order.
+ */
+enum class Encoding { raw, delta };
+
+char const delta_magic[] = {'M', 'I', 'R', 'D', 'E', 'L', 'T', 'A'};
+
+void append_uint32(std::vector<char>& out, uint32_t value)
+{
+    auto const bytes = reinterpret_cast<char const*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof value);
+}
+
+void encode_delta(
+    std::vector<char> const& frame,
+    std::vector<char> const* previous,
+    std::vector<char>& out)
+{
+    // Compare in blocks: finer runs cost more in headers than they save
+    size_t const block{64};
+    size_t const size{frame.size()};
+    bool const comparable{previous && previous->size() == size};
+
+    out.clear();
+    size_t offset{0};
+    while (offset < size)
+    {
+        auto const same_block = [&](size_t at)
+            {
+                return comparable &&
+                    memcmp(frame.data() + at, previous->data() + at, std::min(block, size - at)) == 0;
+            };
+
+        auto const unchanged_start = offset;
+        while (offset < size && same_block(offset))
+            offset += std::min(block, size - offset);
+
+        auto const literal_start = offset;
+        while (offset < size && !same_block(offset))
+            offset += std::min(block, size - offset);
+
+        append_uint32(out, literal_start - unchanged_start);
+        append_uint32(out, offset - literal_start);
+        out.insert(out.end(), frame.data() + literal_start, frame.data() + offset);
+    }
+}
+
+int decode_delta(std::istream& in, std::ostream& out)
+{
+    auto const read = [&](void* to, size_t size)
+        {
+            in.read(static_cast<char*>(to), size);
+            return static_cast<size_t>(in.gcount()) == size;
+        };
+
+    char magic[sizeof delta_magic];
+    uint32_t frame_size;
+    if (!read(magic, sizeof magic) || memcmp(magic, delta_magic, sizeof magic) != 0 ||
+        !read(&frame_size, sizeof frame_size))
+    {
+        throw std::runtime_error("Input is not a mirscreencast delta stream");
+    }
+
+    std::vector<char> frame(frame_size);
+    while (in.peek() != std::char_traits<char>::eof())
+    {
+        uint32_t offset{0};
+        while (offset < frame_size)
+        {
+            uint32_t unchanged, literal;
+            if (!read(&unchanged, sizeof unchanged) || !read(&literal, sizeof literal) ||
+                unchanged > frame_size - offset || literal > frame_size - offset - unchanged ||
+                !read(frame.data() + offset + unchanged, literal))
+            {
+                throw std::runtime_error("Truncated or corrupt delta stream");
+            }
+            offset += unchanged + literal;
+        }
+
+        out.write(frame.data(), frame.size());
+    }
+
+    return EXIT_SUCCESS;
+}
+
+struct PipelineOptions
+{
+    int frames_in_flight;
+    int encoder_threads;
+    Encoding encoding;
+    bool skip_unchanged;
+};
+
+/**
+ * Frames captured on one thread, then compared and encoded on a pool of
+ * threads and written to the stream in capture order.
+ *
+ * Capture only waits when frames_in_flight frames are still to be written,
+ * so reading back one frame overlaps with encoding and writing the last.
+ */
+class FramePipeline
+{
+public:
+    using Frame = std::shared_ptr<std::vector<char>>;
+
+    FramePipeline(std::ostream& stream, PipelineOptions const& options)
+        : stream(stream),
+          options(options)
+    {
+        for (int i = 0; i != options.encoder_threads; ++i)
+            encoders.emplace_back([this] { encode_frames(); });
+    }
+
+    ~FramePipeline()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            finishing = true;
+        }
+        work_available.notify_all();
+
+        for (auto& encoder : encoders)
+            encoder.join();
+
+        last_frame.reset();
+    }
+
+    /// A buffer to capture into, once there is room in the pipeline
+    auto acquire() -> Frame
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        frame_written.wait(lock, [this] { return in_flight < options.frames_in_flight; });
+        ++in_flight;
+
+        std::unique_ptr<std::vector<char>> buffer;
+        if (free_buffers.empty())
+        {
+            buffer = std::make_unique<std::vector<char>>();
+        }
+        else
+        {
+            buffer = std::move(free_buffers.back());
+            free_buffers.pop_back();
+        }
+
+        // Buffers return to the pool once the frame and its successor are encoded
+        return Frame{buffer.release(), [this](std::vector<char>* released)
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                free_buffers.emplace_back(released);
+            }};
+    }
+
+    void submit(Frame const& frame)
+    {
+        Frame previous;
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            previous = std::move(last_frame);
+            jobs.push_back(Job{next_sequence++, frame, previous});
+            last_frame = frame;
+        }
+        work_available.notify_one();
+
+        // previous may be the last reference, and recycling it takes the lock
+    }
+
+private:
+    struct Job
+    {
+        uint64_t sequence;
+        Frame frame;
+        Frame previous;
+    };
+
+    void encode_frames()
+    {
+        std::vector<char> encoded;
+
+        for (;;)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                work_available.wait(lock, [this] { return finishing || !jobs.empty(); });
+                if (jobs.empty())
+                    return;
+
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            auto const& frame = *job.frame;
+            bool const unchanged =
+                options.skip_unchanged && job.previous && *job.previous == frame;
+
+            if (!unchanged && options.encoding == Encoding::delta)
+                encode_delta(frame, job.previous.get(), encoded);
+
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                frame_written.wait(lock, [&] { return next_to_write == job.sequence; });
+            }
+
+            // Only the encoder whose turn it is gets here, so it has the stream
+            if (job.sequence == 0 && options.encoding == Encoding::delta)
+            {
+                uint32_t const frame_size = frame.size();
+                stream.write(delta_magic, sizeof delta_magic);
+                stream.write(reinterpret_cast<char const*>(&frame_size), sizeof frame_size);
+            }
+
+            if (!unchanged && options.encoding == Encoding::delta)
+                stream.write(encoded.data(), encoded.size());
+            else if (!unchanged)
+                stream.write(frame.data(), frame.size());
+
+            job = Job{};
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                ++next_to_write;
+                --in_flight;
+            }
+            frame_written.notify_all();
+        }
+    }
+
+    std::ostream& stream;
+    PipelineOptions const options;
+
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable frame_written;
+    std::deque<Job> jobs;
+    std::vector<std::unique_ptr<std::vector<char>>> free_buffers;
+    Frame last_frame;
+    uint64_t next_sequence{0};
+    uint64_t next_to_write{0};
+    int in_flight{0};
+    bool finishing{false};
+
+    std::vector<std::thread> encoders;
+};
+
 class Screencast
 {
 public:
     virtual ~Screencast() = default;
     virtual std::string pixel_format() = 0;
 
-    void run(std::ostream& stream)
+    void run(std::ostream& stream, PipelineOptions const& options)
     {
+        FramePipeline pipeline{stream, options};
+
         while (running && (number_of_captures != 0))
         {
             auto time_point = std::chrono::steady_clock::now() + capture_period;
 
-            capture_to(stream);
+            auto const frame = pipeline.acquire();
+            capture_to(*frame);
+            pipeline.submit(frame);
 
             if (number_of_captures > 0)
                 number_of_captures--;
@@ -264,7 +522,8 @@ public:
         }
     }
 
-    virtual void capture_to(std::ostream& stream) = 0;
+    /// Reads the current frame into \a frame and moves on to the next
+    virtual void capture_to(std::vector<char>& frame) = 0;
 
 protected:
     Screencast(int number_of_captures, double capture_fps)
@@ -299,17 +558,20 @@ public:
         return pixel_format_;
     }
 
-    void capture_to(std::ostream& stream) override
+    void capture_to(std::vector<char>& frame) override
     {
         MirGraphicsRegion const region{graphics_region_for(buffer_stream)};
         int const line_size{region.width * MIR_BYTES_PER_PIXEL(region.pixel_format)};
+        frame.resize(line_size * region.height);
 
         // Contents are rendered up-side down, read them bottom to top
         auto addr = region.vaddr + (region.height - 1)*region.stride;
+        auto out = frame.data();
         for (int i = 0; i < region.height; i++)
         {
-            stream.write(addr, line_size);
+            memcpy(out, addr, line_size);
             addr -= region.stride;
+            out += line_size;
         }
 
         mir_buffer_stream_swap_buffers_sync(buffer_stream);
@@ -379,10 +641,6 @@ public:
             read_pixel_format = GL_BGRA_EXT;
         else
             read_pixel_format = GL_RGBA;
-
-        int const rgba_pixel_size{4};
-        auto const frame_size_bytes = rgba_pixel_size * width * height;
-        buffer.resize(frame_size_bytes);
     }
 
     ~EGLScreencast()
@@ -393,21 +651,17 @@ public:
         eglTerminate(egl_display);
     }
 
-    void capture_to(std::ostream& stream) override
+    void capture_to(std::vector<char>& frame) override
     {
-        void* data = buffer.data();
-        glReadPixels(0, 0, width, height, read_pixel_format, GL_UNSIGNED_BYTE, data);
+        int const rgba_pixel_size{4};
+        frame.resize(rgba_pixel_size * width * height);
 
-        auto write_out_future = std::async(
-            std::launch::async,
-            [this, &stream] {
-            stream.write(buffer.data(), buffer.size());
-            });
+        // GLES2 has no pixel pack buffers, so the readback itself is synchronous;
+        // the pipeline overlaps it with encoding and writing earlier frames.
+        glReadPixels(0, 0, width, height, read_pixel_format, GL_UNSIGNED_BYTE, frame.data());
 
         if (eglSwapBuffers(egl_display, egl_surface) != EGL_TRUE)
             throw std::runtime_error("Failed to swap screencast surface buffers");
-
-        write_out_future.wait();
     }
 
     std::string pixel_format() override
@@ -418,7 +672,6 @@ public:
 private:
     unsigned int const width;
     unsigned int const height;
-    std::vector<char> buffer;
     EGLDisplay egl_display;
     EGLContext egl_context;
     EGLSurface egl_surface;
@@ -455,6 +708,9 @@ try
     bool use_std_out = false;
     bool query_params_only = false;
     int capture_interval = 1;
+    PipelineOptions pipeline_options{2, 1, Encoding::raw, false};
+    bool delta_encoding = false;
+    bool decode_only = false;
 
     po::options_description desc("Usage");
     desc.add_options()
@@ -480,7 +736,22 @@ try
         ("cap-interval",
             po::value<int>(&capture_interval),
             "adjusts the capture rate to <arg> display refresh intervals\n"
-            "1 -> capture at display rate\n2 -> capture at half the display rate, etc..");
+            "1 -> capture at display rate\n2 -> capture at half the display rate, etc..")
+        ("frames-in-flight",
+            po::value<int>(&pipeline_options.frames_in_flight),
+            "frames captured but not yet written before capture waits (default 2)")
+        ("encoder-threads",
+            po::value<int>(&pipeline_options.encoder_threads),
+            "threads comparing, encoding and writing frames (default 1)")
+        ("skip-unchanged",
+            po::value<bool>(&pipeline_options.skip_unchanged)->zero_tokens(),
+            "don't write frames identical to the one before")
+        ("delta",
+            po::value<bool>(&delta_encoding)->zero_tokens(),
+            "write a lossless delta stream of the bytes changed in each frame")
+        ("decode-delta",
+            po::value<bool>(&decode_only)->zero_tokens(),
+            "convert a delta stream on standard in to raw frames on standard out, then exit");
 
     po::variables_map vm;
     try
@@ -499,6 +770,12 @@ try
 
         if (vm.count("cap-interval") && capture_interval < 1)
             throw po::error("invalid capture interval");
+
+        if (pipeline_options.frames_in_flight < 1)
+            throw po::error("invalid number of frames in flight");
+
+        if (pipeline_options.encoder_threads < 1)
+            throw po::error("invalid number of encoder threads");
     }
     catch(po::error& e)
     {
@@ -513,6 +790,12 @@ try
         return EXIT_SUCCESS;
     }
 
+    if (decode_only)
+        return decode_delta(std::cin, std::cout);
+
+    if (delta_encoding)
+        pipeline_options.encoding = Encoding::delta;
+
     running = true;
     signal(SIGINT, shutdown);
     signal(SIGTERM, shutdown);
@@ -575,6 +858,8 @@ try
         ss << screencast_config.width << "x" << screencast_config.height;
         ss << "_" << capture_fps << "Hz";
         ss << to_file_extension(screencast->pixel_format());
+        if (pipeline_options.encoding == Encoding::delta)
+            ss << ".delta";
         output_filename = ss.str();
     }
 
@@ -591,12 +876,12 @@ try
 
     if (use_std_out)
     {
-        screencast->run(std::cout);
+        screencast->run(std::cout, pipeline_options);
     }
     else
     {
         std::ofstream file_stream(output_filename);
-        screencast->run(file_stream);
+        screencast->run(file_stream, pipeline_options);
     }
 
     return EXIT_SUCCESS;
@@ -20,6 +20,7 @@
 #define MIR_TEST_DOUBLES_MOCK_SCENE_H_
 
 #include "mir/compositor/scene.h"
+#include "mir/geometry/rectangle.h"
 #include <gmock/gmock.h>
 
 namespace mir
@@ -44,6 +45,7 @@ public:
     MOCK_CONST_METHOD1(frames_pending, int(compositor::CompositorID));
     MOCK_METHOD1(register_compositor, void(compositor::CompositorID));
     MOCK_METHOD1(unregister_compositor, void(compositor::CompositorID));
+    MOCK_METHOD2(set_compositor_area, void(compositor::CompositorID, geometry::Rectangle const&));
 
     MOCK_METHOD1(add_observer, void(std::shared_ptr<scene::Observer> const&));
     MOCK_METHOD1(remove_observer, void(std::weak_ptr<scene::Observer> const&));
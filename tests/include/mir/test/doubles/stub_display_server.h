@@ -106,6 +106,10 @@ struct StubDisplayServer : public mir::frontend::detail::DisplayServer
         mir::protobuf::BufferStreamId const* /*request*/,
         mir::protobuf::Void* /*response*/,
         google::protobuf::Closure* /*done*/) override {}
+    void create_buffer_ring(
+        mir::protobuf::BufferStreamId const* /*request*/,
+        mir::protobuf::SocketFD* /*response*/,
+        google::protobuf::Closure* /*done*/) override {}
     void configure_cursor(
         mir::protobuf::CursorSetting const* /*request*/,
         mir::protobuf::Void* /*response*/,
@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_TEST_DOUBLES_STUB_SW_DISPLAY_BUFFER_H_
+#define MIR_TEST_DOUBLES_STUB_SW_DISPLAY_BUFFER_H_
+
+#include "mir/test/doubles/stub_display_buffer.h"
+#include "mir/renderer/sw/render_target.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace mir
+{
+namespace test
+{
+namespace doubles
+{
+
+/// A display buffer backed by plain memory, one uint32_t per pixel
+class StubSWDisplayBuffer : public StubDisplayBuffer,
+                            public renderer::software::RenderTarget
+{
+public:
+    StubSWDisplayBuffer(
+        geometry::Rectangle const& view_area,
+        MirPixelFormat format = mir_pixel_format_argb_8888)
+        : StubSWDisplayBuffer{view_area, view_area.size, format}
+    {
+    }
+
+    StubSWDisplayBuffer(
+        geometry::Rectangle const& view_area,
+        geometry::Size const& target_size,
+        MirPixelFormat format = mir_pixel_format_argb_8888)
+        : StubDisplayBuffer{view_area},
+          format{format},
+          target_size{target_size},
+          pixels(target_size.width.as_int() * target_size.height.as_int())
+    {
+    }
+
+    MirPixelFormat pixel_format() const override { return format; }
+    geometry::Size size() const override { return target_size; }
+    geometry::Stride stride() const override
+    {
+        return geometry::Stride{target_size.width.as_int() * sizeof(uint32_t)};
+    }
+
+    void write(std::function<void(unsigned char* pixels)> const& do_with_pixels) override
+    {
+        do_with_pixels(reinterpret_cast<unsigned char*>(pixels.data()));
+    }
+
+    void swap_buffers() override { ++swaps; }
+
+    uint32_t pixel_at(int x, int y) const
+    {
+        return pixels[y * target_size.width.as_int() + x];
+    }
+
+    MirPixelFormat const format;
+    geometry::Size const target_size;
+    std::vector<uint32_t> pixels;
+    int swaps{0};
+};
+
+}
+}
+}
+
+#endif /* MIR_TEST_DOUBLES_STUB_SW_DISPLAY_BUFFER_H_ */
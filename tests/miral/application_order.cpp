@@ -0,0 +1,77 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_window_manager_tools.h"
+
+#include <mir/test/doubles/stub_session.h>
+
+using namespace miral;
+using namespace testing;
+namespace mt = mir::test;
+namespace mtd = mir::test::doubles;
+
+namespace
+{
+struct ApplicationOrder : mt::TestWindowManagerTools
+{
+    std::vector<std::shared_ptr<mir::scene::Session>> const sessions{
+        std::make_shared<mtd::StubSession>(),
+        std::make_shared<mtd::StubSession>(),
+        std::make_shared<mtd::StubSession>()};
+
+    void SetUp() override
+    {
+        // Add them in the opposite order to allocation, so address order doesn't give the right answer by accident
+        for (auto session = sessions.rbegin(); session != sessions.rend(); ++session)
+            basic_window_manager.add_session(*session);
+    }
+
+    auto visited() -> std::vector<Application>
+    {
+        std::vector<Application> result;
+        window_manager_tools.for_each_application([&](ApplicationInfo& info) { result.push_back(info.application()); });
+        return result;
+    }
+};
+}
+
+TEST_F(ApplicationOrder, for_each_application_visits_applications_in_the_order_they_were_added)
+{
+    EXPECT_THAT(visited(), ElementsAre(sessions[2], sessions[1], sessions[0]));
+}
+
+TEST_F(ApplicationOrder, removed_application_is_not_visited)
+{
+    basic_window_manager.remove_session(sessions[1]);
+
+    EXPECT_THAT(visited(), ElementsAre(sessions[2], sessions[0]));
+}
+
+TEST_F(ApplicationOrder, find_application_returns_the_first_match_in_order)
+{
+    auto const found = window_manager_tools.find_application([](ApplicationInfo const&) { return true; });
+
+    EXPECT_THAT(found, Eq(sessions[2]));
+}
+
+TEST_F(ApplicationOrder, count_applications_tracks_added_and_removed_sessions)
+{
+    EXPECT_THAT(window_manager_tools.count_applications(), Eq(3u));
+
+    basic_window_manager.remove_session(sessions[0]);
+
+    EXPECT_THAT(window_manager_tools.count_applications(), Eq(2u));
+}
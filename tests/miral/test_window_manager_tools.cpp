@@ -58,11 +58,13 @@ struct StubFocusController : mir::shell::FocusController
     void raise(mir::shell::SurfaceSet const& /*windows*/) override {}
 
     virtual auto surface_at(mir::geometry::Point /*cursor*/) const -> std::shared_ptr<mir::scene::Surface> override
-        { return {}; }
+        { return surface_under_cursor; }
 
     void set_drag_and_drop_handle(std::vector<uint8_t> const& /*handle*/) override {}
 
     void clear_drag_and_drop_handle() override {}
+
+    std::shared_ptr<mir::scene::Surface> surface_under_cursor;
 };
 
 struct StubDisplayLayout : mir::shell::DisplayLayout
@@ -297,6 +299,11 @@ mt::TestWindowManagerTools::TestWindowManagerTools()
 
 mt::TestWindowManagerTools::~TestWindowManagerTools() = default;
 
+void mt::TestWindowManagerTools::set_surface_at(std::shared_ptr<mir::scene::Surface> const& surface)
+{
+    self->focus_controller.surface_under_cursor = surface;
+}
+
 auto mt::TestWindowManagerTools::create_surface(
     std::shared_ptr<mir::scene::Session> const& session,
     mir::scene::SurfaceCreationParameters const& params) -> std::shared_ptr<mir::scene::Surface>
@@ -89,6 +89,9 @@ public:
         std::shared_ptr<mir::scene::Session> const& session,
         mir::scene::SurfaceCreationParameters const& params) -> std::shared_ptr<mir::scene::Surface>;
 
+    /// Sets the surface the focus controller finds under the cursor (wherever it is)
+    void set_surface_at(std::shared_ptr<mir::scene::Surface> const& surface);
+
     auto static create_fake_display_configuration(std::vector<miral::Rectangle> outputs)
         -> std::shared_ptr<graphics::DisplayConfiguration const>;
     void notify_configuration_applied(
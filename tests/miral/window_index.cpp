@@ -0,0 +1,121 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_window_manager_tools.h"
+
+#include <mir/test/doubles/stub_surface.h>
+
+#include <type_traits>
+
+using namespace miral;
+using namespace testing;
+namespace mt = mir::test;
+namespace mtd = mir::test::doubles;
+
+namespace
+{
+struct WindowIndex : mt::TestWindowManagerTools
+{
+    void SetUp() override
+    {
+        basic_window_manager.add_session(session);
+    }
+
+    // Every surface is built in the same storage, so a new one reuses the address of the last
+    std::aligned_storage<sizeof(mtd::StubSurface), alignof(mtd::StubSurface)>::type storage;
+    std::shared_ptr<mir::scene::Surface> surface;
+
+    auto add_window() -> Window
+    {
+        Window result;
+
+        EXPECT_CALL(*window_manager_policy, advise_new_window(_))
+            .WillOnce(Invoke([&result](WindowInfo const& window_info) { result = window_info.window(); }));
+
+        basic_window_manager.add_surface(
+            session,
+            mir::scene::SurfaceCreationParameters{},
+            [this](std::shared_ptr<mir::scene::Session> const&, mir::scene::SurfaceCreationParameters const&)
+            {
+                surface = std::shared_ptr<mtd::StubSurface>(
+                    new (&storage) mtd::StubSurface,
+                    [](mtd::StubSurface* surface) { surface->~StubSurface(); });
+                return surface;
+            });
+
+        Mock::VerifyAndClearExpectations(window_manager_policy);
+
+        return result;
+    }
+};
+}
+
+TEST_F(WindowIndex, window_at_finds_the_window_of_the_surface_under_the_cursor)
+{
+    auto const window = add_window();
+    set_surface_at(window);
+
+    EXPECT_THAT(basic_window_manager.window_at({}), Eq(window));
+}
+
+TEST_F(WindowIndex, window_at_does_not_find_a_removed_window)
+{
+    auto const window = add_window();
+    set_surface_at(window);
+
+    basic_window_manager.remove_surface(session, surface);
+
+    EXPECT_FALSE(basic_window_manager.window_at({}));
+}
+
+TEST_F(WindowIndex, window_at_does_not_find_a_surface_that_is_not_managed)
+{
+    add_window();
+    set_surface_at(std::make_shared<mtd::StubSurface>());
+
+    EXPECT_FALSE(basic_window_manager.window_at({}));
+}
+
+TEST_F(WindowIndex, removes_a_window_whose_surface_has_already_gone)
+{
+    add_window();
+    std::weak_ptr<mir::scene::Surface> const gone = surface;
+    surface.reset();
+    ASSERT_TRUE(gone.expired());
+
+    basic_window_manager.remove_surface(session, gone);
+
+    EXPECT_THAT(basic_window_manager.info_for(session).windows(), IsEmpty());
+}
+
+TEST_F(WindowIndex, replaces_a_stale_entry_when_a_surface_address_is_reused)
+{
+    add_window();
+    std::weak_ptr<mir::scene::Surface> const stale = surface;
+    surface.reset();
+
+    auto const window = add_window();
+    ASSERT_THAT(surface.get(), Eq(static_cast<void*>(&storage)));
+
+    EXPECT_THAT(basic_window_manager.info_for(window).window(), Eq(window));
+    set_surface_at(window);
+    EXPECT_THAT(basic_window_manager.window_at({}), Eq(window));
+
+    // Being told of the old surface's removal late doesn't take the new window with it
+    basic_window_manager.remove_surface(session, stale);
+    EXPECT_THAT(basic_window_manager.info_for(window).window(), Eq(window));
+    EXPECT_THAT(basic_window_manager.window_at({}), Eq(window));
+}
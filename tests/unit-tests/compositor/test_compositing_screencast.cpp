@@ -20,6 +20,7 @@
 #include "mir/compositor/display_buffer_compositor_factory.h"
 #include "mir/compositor/display_buffer_compositor.h"
 #include "mir/compositor/scene.h"
+#include "mir/scene/observer.h"
 #include "mir/graphics/display_buffer.h"
 #include "mir/graphics/graphic_buffer_allocator.h"
 #include "mir/geometry/rectangle.h"
@@ -189,6 +190,8 @@ struct StubDisplayBufferCompositorFactory : mc::DisplayBufferCompositorFactory
     StubDisplayBufferCompositor stub_db_compositor;
 };
 
+std::chrono::nanoseconds const no_rate_limit{0};
+
 MATCHER_P(DisplayBufferCoversArea, output_extents, "")
 {
     return arg.view_area() == output_extents;
@@ -205,7 +208,8 @@ struct CompositingScreencastTest : testing::Test
         : screencast{mt::fake_shared(stub_scene),
                      mt::fake_shared(stub_display),
                      mt::fake_shared(stub_buffer_allocator),
-                     mt::fake_shared(stub_db_compositor_factory)},
+                     mt::fake_shared(stub_db_compositor_factory),
+                     no_rate_limit},
           default_size{1, 1},
           default_region{{0, 0}, {1, 1}},
           default_pixel_format{mir_pixel_format_xbgr_8888}
@@ -289,7 +293,8 @@ TEST_F(CompositingScreencastTest, captures_by_compositing_with_provided_region)
         mt::fake_shared(mock_scene),
         mt::fake_shared(stub_display),
         mt::fake_shared(stub_buffer_allocator),
-        mt::fake_shared(mock_db_compositor_factory)};
+        mt::fake_shared(mock_db_compositor_factory),
+        no_rate_limit};
 
     auto session_id = screencast_local.create_session(
         default_region, default_size, default_pixel_format,
@@ -320,7 +325,8 @@ TEST_F(CompositingScreencastTest, captures_to_buffer_by_compositing)
         mt::fake_shared(mock_scene),
         mt::fake_shared(stub_display),
         mt::fake_shared(stub_buffer_allocator),
-        mt::fake_shared(mock_db_compositor_factory)};
+        mt::fake_shared(mock_db_compositor_factory),
+        no_rate_limit};
 
     auto session_id = screencast.create_session(
         default_region, default_size, default_pixel_format,
@@ -340,7 +346,8 @@ TEST_F(CompositingScreencastTest, captures_to_buffer_by_compositing_with_reserve
         mt::fake_shared(mock_scene),
         mt::fake_shared(stub_display),
         mt::fake_shared(stub_buffer_allocator),
-        mt::fake_shared(mock_db_compositor_factory)};
+        mt::fake_shared(mock_db_compositor_factory),
+        no_rate_limit};
 
     auto session_id = screencast.create_session(
         default_region, default_size, default_pixel_format,
@@ -365,7 +372,8 @@ TEST_F(CompositingScreencastTest, allocates_and_uses_buffer_with_provided_size)
         mt::fake_shared(stub_scene),
         mt::fake_shared(stub_display),
         mt::fake_shared(mock_buffer_allocator),
-        mt::fake_shared(stub_db_compositor_factory)};
+        mt::fake_shared(stub_db_compositor_factory),
+        no_rate_limit};
 
     auto session_id = screencast_local.create_session(
         default_region, default_size, default_pixel_format,
@@ -391,7 +399,8 @@ TEST_F(CompositingScreencastTest, allocates_different_buffers_per_session)
         mt::fake_shared(stub_scene),
         mt::fake_shared(stub_display),
         mt::fake_shared(mock_buffer_allocator),
-        mt::fake_shared(stub_db_compositor_factory)};
+        mt::fake_shared(stub_db_compositor_factory),
+        no_rate_limit};
 
     auto session_id1 = screencast_local.create_session(
         default_region, default_size, default_pixel_format,
@@ -428,7 +437,8 @@ TEST_F(CompositingScreencastTest, registers_and_unregisters_from_scene)
         mt::fake_shared(mock_scene),
         mt::fake_shared(stub_display),
         mt::fake_shared(mock_buffer_allocator),
-        mt::fake_shared(stub_db_compositor_factory)};
+        mt::fake_shared(stub_db_compositor_factory),
+        no_rate_limit};
 
     auto session_id = screencast_local.create_session(
         default_region, default_size, default_pixel_format,
@@ -446,7 +456,8 @@ TEST_F(CompositingScreencastTest, attempts_to_create_output_display_when_given_r
         mt::fake_shared(stub_scene),
         mt::fake_shared(stub_display),
         mt::fake_shared(stub_buffer_allocator),
-        mt::fake_shared(stub_db_compositor_factory)};
+        mt::fake_shared(stub_db_compositor_factory),
+        no_rate_limit};
 
     auto session_id = screencast_local.create_session(
             region_outside_display, default_size, default_pixel_format,
@@ -467,7 +478,8 @@ TEST_F(CompositingScreencastTest, does_not_create_virtual_output_when_given_regi
         mt::fake_shared(stub_scene),
         mt::fake_shared(stub_display),
         mt::fake_shared(stub_buffer_allocator),
-        mt::fake_shared(stub_db_compositor_factory)};
+        mt::fake_shared(stub_db_compositor_factory),
+        no_rate_limit};
 
     auto session_id = screencast_local.create_session(
             region_inside_display, default_size, default_pixel_format,
@@ -483,6 +495,8 @@ TEST_F(CompositingScreencastTest, uses_requested_number_of_buffers)
 {
     using namespace testing;
 
+    NiceMock<mtd::MockScene> mock_scene;
+    ON_CALL(mock_scene, frames_pending(_)).WillByDefault(Return(1));
     MockBufferAllocator mock_buffer_allocator;
     int const expected_num_buffers = 4;
     std::vector<mtd::StubGLBuffer> buffers(expected_num_buffers);
@@ -495,10 +509,11 @@ TEST_F(CompositingScreencastTest, uses_requested_number_of_buffers)
         .WillOnce(Return(mt::fake_shared(buffers[3])));
 
     mc::CompositingScreencast screencast_local{
-        mt::fake_shared(stub_scene),
+        mt::fake_shared(mock_scene),
         mt::fake_shared(stub_display),
         mt::fake_shared(mock_buffer_allocator),
-        mt::fake_shared(stub_db_compositor_factory)};
+        mt::fake_shared(stub_db_compositor_factory),
+        no_rate_limit};
 
     auto session_id = screencast_local.create_session(
         default_region, default_size, default_pixel_format,
@@ -512,3 +527,116 @@ TEST_F(CompositingScreencastTest, uses_requested_number_of_buffers)
 }
 
 
+
+TEST_F(CompositingScreencastTest, does_not_composite_again_when_nothing_changed)
+{
+    using namespace testing;
+
+    mtd::StubGLBuffer stub_buffer;
+    NiceMock<mtd::MockScene> mock_scene;
+    MockDisplayBufferCompositorFactory mock_db_compositor_factory;
+
+    EXPECT_CALL(mock_db_compositor_factory.mock_db_compositor, composite_(_))
+        .Times(1);
+
+    mc::CompositingScreencast screencast{
+        mt::fake_shared(mock_scene),
+        mt::fake_shared(stub_display),
+        mt::fake_shared(stub_buffer_allocator),
+        mt::fake_shared(mock_db_compositor_factory),
+        no_rate_limit};
+
+    auto session_id = screencast.create_session(
+        default_region, default_size, default_pixel_format,
+        0, default_mirror_mode);
+
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+}
+
+TEST_F(CompositingScreencastTest, composites_again_after_scene_changes)
+{
+    using namespace testing;
+
+    mtd::StubGLBuffer stub_buffer;
+    NiceMock<mtd::MockScene> mock_scene;
+    MockDisplayBufferCompositorFactory mock_db_compositor_factory;
+    std::shared_ptr<mir::scene::Observer> observer;
+
+    EXPECT_CALL(mock_scene, add_observer(_))
+        .WillOnce(SaveArg<0>(&observer));
+    EXPECT_CALL(mock_db_compositor_factory.mock_db_compositor, composite_(_))
+        .Times(2);
+
+    mc::CompositingScreencast screencast{
+        mt::fake_shared(mock_scene),
+        mt::fake_shared(stub_display),
+        mt::fake_shared(stub_buffer_allocator),
+        mt::fake_shared(mock_db_compositor_factory),
+        no_rate_limit};
+
+    auto session_id = screencast.create_session(
+        default_region, default_size, default_pixel_format,
+        0, default_mirror_mode);
+
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+    ASSERT_THAT(observer, NotNull());
+    observer->scene_changed();
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+}
+
+TEST_F(CompositingScreencastTest, composites_no_faster_than_min_capture_interval)
+{
+    using namespace testing;
+
+    mtd::StubGLBuffer stub_buffer;
+    NiceMock<mtd::MockScene> mock_scene;
+    ON_CALL(mock_scene, frames_pending(_)).WillByDefault(Return(1));
+    MockDisplayBufferCompositorFactory mock_db_compositor_factory;
+
+    EXPECT_CALL(mock_db_compositor_factory.mock_db_compositor, composite_(_))
+        .Times(1);
+
+    mc::CompositingScreencast screencast{
+        mt::fake_shared(mock_scene),
+        mt::fake_shared(stub_display),
+        mt::fake_shared(stub_buffer_allocator),
+        mt::fake_shared(mock_db_compositor_factory),
+        std::chrono::hours{1}};
+
+    auto session_id = screencast.create_session(
+        default_region, default_size, default_pixel_format,
+        0, default_mirror_mode);
+
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+    screencast.capture(session_id, mt::fake_shared(stub_buffer));
+}
+
+TEST_F(CompositingScreencastTest, composites_into_buffer_without_latest_frame_despite_rate_limit)
+{
+    using namespace testing;
+
+    mtd::StubGLBuffer stub_buffer1;
+    mtd::StubGLBuffer stub_buffer2;
+    NiceMock<mtd::MockScene> mock_scene;
+    MockDisplayBufferCompositorFactory mock_db_compositor_factory;
+
+    EXPECT_CALL(mock_db_compositor_factory.mock_db_compositor, composite_(_))
+        .Times(2);
+
+    mc::CompositingScreencast screencast{
+        mt::fake_shared(mock_scene),
+        mt::fake_shared(stub_display),
+        mt::fake_shared(stub_buffer_allocator),
+        mt::fake_shared(mock_db_compositor_factory),
+        std::chrono::hours{1}};
+
+    auto session_id = screencast.create_session(
+        default_region, default_size, default_pixel_format,
+        0, default_mirror_mode);
+
+    screencast.capture(session_id, mt::fake_shared(stub_buffer1));
+    screencast.capture(session_id, mt::fake_shared(stub_buffer2));
+    screencast.capture(session_id, mt::fake_shared(stub_buffer1));
+    screencast.capture(session_id, mt::fake_shared(stub_buffer2));
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/graphics/offscreen/frame_exporter.h"
+#include "mir_toolkit/common.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace mgo = mir::graphics::offscreen;
+namespace geom = mir::geometry;
+using namespace testing;
+
+namespace
+{
+struct Consumer
+{
+    explicit Consumer(std::string const& path)
+        : socket{::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0)}
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path.c_str(), sizeof address.sun_path - 1);
+        if (connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof address) < 0)
+            throw std::system_error{errno, std::system_category(), "connect"};
+
+        char control[CMSG_SPACE(sizeof(int))];
+        iovec iov{&setup, sizeof setup};
+        msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof control;
+
+        if (recvmsg(socket, &message, 0) != sizeof setup || !CMSG_FIRSTHDR(&message))
+            throw std::runtime_error{"no setup"};
+
+        int fd;
+        memcpy(&fd, CMSG_DATA(CMSG_FIRSTHDR(&message)), sizeof fd);
+        shm = mir::Fd{fd};
+
+        mapping_size = setup.slot_size * setup.slot_count;
+        mapping = static_cast<unsigned char*>(mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, shm, 0));
+    }
+
+    ~Consumer()
+    {
+        munmap(mapping, mapping_size);
+    }
+
+    bool next_frame(uint32_t& slot)
+    {
+        pollfd fd{socket, POLLIN, 0};
+        mgo::frame_export::FrameReady ready;
+        if (poll(&fd, 1, 5000) != 1 || recv(socket, &ready, sizeof ready, 0) != sizeof ready)
+            return false;
+        slot = ready.slot;
+        return true;
+    }
+
+    auto header(uint32_t slot) const -> mgo::frame_export::FrameHeader const&
+    {
+        return *reinterpret_cast<mgo::frame_export::FrameHeader const*>(mapping + slot * setup.slot_size);
+    }
+
+    auto pixel(uint32_t slot, int x, int y) const -> uint32_t
+    {
+        uint32_t value;
+        memcpy(&value, mapping + slot * setup.slot_size + setup.header_size + y * setup.stride + 4 * x, 4);
+        return value;
+    }
+
+    void release(uint32_t slot)
+    {
+        send(socket, &slot, sizeof slot, MSG_NOSIGNAL);
+    }
+
+    mir::Fd const socket;
+    mgo::frame_export::Setup setup;
+    mir::Fd shm;
+    size_t mapping_size;
+    unsigned char* mapping;
+};
+
+struct FrameExporter : Test
+{
+    std::string const path{"/tmp/mir-test-frame-export-" + std::to_string(getpid())};
+    geom::Size const size{3, 2};
+
+    static void fill(unsigned char* pixels, uint32_t stride, int y, uint32_t value)
+    {
+        for (int x = 0; x != 3; ++x)
+            memcpy(pixels + y * stride + 4 * x, &value, 4);
+    }
+};
+}
+
+TEST_F(FrameExporter, drops_frames_nobody_is_watching)
+{
+    mgo::FrameExporter exporter{path, size};
+
+    EXPECT_THAT(exporter.begin_frame(), IsNull());
+}
+
+TEST_F(FrameExporter, consumer_gets_frames_top_down_with_damage)
+{
+    mgo::FrameExporter exporter{path, size};
+    Consumer consumer{path};
+
+    EXPECT_THAT(consumer.setup.magic, Eq(mgo::frame_export::magic));
+    EXPECT_THAT(consumer.setup.width, Eq(3u));
+    EXPECT_THAT(consumer.setup.height, Eq(2u));
+    EXPECT_THAT(consumer.setup.pixel_format, Eq(uint32_t{mir_pixel_format_abgr_8888}));
+
+    // As glReadPixels() would write them: the bottom row first
+    auto pixels = exporter.begin_frame();
+    ASSERT_THAT(pixels, NotNull());
+    fill(pixels, exporter.stride(), 0, 0x11111111);
+    fill(pixels, exporter.stride(), 1, 0x22222222);
+    exporter.end_frame();
+
+    uint32_t slot;
+    ASSERT_TRUE(consumer.next_frame(slot));
+    EXPECT_THAT(consumer.header(slot).sequence, Eq(0u));
+    EXPECT_THAT(consumer.pixel(slot, 0, 0), Eq(0x22222222u));
+    EXPECT_THAT(consumer.pixel(slot, 2, 1), Eq(0x11111111u));
+    EXPECT_THAT(consumer.header(slot).damage_width, Eq(3));
+    EXPECT_THAT(consumer.header(slot).damage_height, Eq(2));
+    auto const first_timestamp = consumer.header(slot).timestamp_ns;
+    consumer.release(slot);
+
+    pixels = exporter.begin_frame();
+    ASSERT_THAT(pixels, NotNull());
+    fill(pixels, exporter.stride(), 0, 0x11111111);
+    fill(pixels, exporter.stride(), 1, 0x22222222);
+    uint32_t const changed{0x33333333};
+    memcpy(pixels + 4, &changed, 4);
+    exporter.end_frame();
+
+    ASSERT_TRUE(consumer.next_frame(slot));
+    auto const& header = consumer.header(slot);
+    EXPECT_THAT(header.sequence, Eq(1u));
+    EXPECT_THAT(header.timestamp_ns, Ge(first_timestamp));
+    EXPECT_THAT(header.damage_x, Eq(1));
+    EXPECT_THAT(header.damage_y, Eq(1));
+    EXPECT_THAT(header.damage_width, Eq(1));
+    EXPECT_THAT(header.damage_height, Eq(1));
+}
+
+TEST_F(FrameExporter, leaves_frames_written_top_first_the_right_way_up)
+{
+    mgo::FrameExporter exporter{path, size};
+    Consumer consumer{path};
+
+    auto const pixels = exporter.begin_frame();
+    ASSERT_THAT(pixels, NotNull());
+    fill(pixels, exporter.stride(), 0, 0x11111111);
+    fill(pixels, exporter.stride(), 1, 0x22222222);
+    exporter.end_frame(mgo::FrameExporter::RowOrder::top_first);
+
+    uint32_t slot;
+    ASSERT_TRUE(consumer.next_frame(slot));
+    EXPECT_THAT(consumer.pixel(slot, 0, 0), Eq(0x11111111u));
+    EXPECT_THAT(consumer.pixel(slot, 2, 1), Eq(0x22222222u));
+}
+
+TEST_F(FrameExporter, drops_frames_while_consumer_holds_every_slot)
+{
+    mgo::FrameExporter exporter{path, size, 2};
+    Consumer consumer{path};
+
+    uint32_t slot;
+    for (int i = 0; i != 2; ++i)
+    {
+        ASSERT_THAT(exporter.begin_frame(), NotNull());
+        exporter.end_frame();
+        ASSERT_TRUE(consumer.next_frame(slot));
+    }
+
+    EXPECT_THAT(exporter.begin_frame(), IsNull());
+
+    consumer.release(slot);
+
+    // The release is handled asynchronously
+    unsigned char* pixels{nullptr};
+    for (int i = 0; i != 500 && !pixels; ++i)
+    {
+        pixels = exporter.begin_frame();
+        if (!pixels)
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    EXPECT_THAT(pixels, NotNull());
+    exporter.end_frame();
+}
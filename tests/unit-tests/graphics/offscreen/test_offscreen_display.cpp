@@ -1,8 +1,10 @@
 #include "mir/graphics/display_buffer.h"
 
 #include "src/server/graphics/offscreen/display.h"
+#include "src/server/graphics/offscreen/software_display.h"
 #include "mir/graphics/default_display_configuration_policy.h"
 #include "mir/renderer/gl/render_target.h"
+#include "mir/renderer/sw/render_target.h"
 #include "src/server/report/null_report_factory.h"
 
 #include "mir/test/doubles/mock_egl.h"
@@ -59,7 +61,8 @@ TEST_F(OffscreenDisplayTest, uses_basic_platform_egl_native_display)
     mgo::Display display{
         native_display,
         std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
-        mr::null_display_report()};
+        mr::null_display_report(),
+        std::string{}};
 }
 
 TEST_F(OffscreenDisplayTest, orientation_normal)
@@ -68,7 +71,8 @@ TEST_F(OffscreenDisplayTest, orientation_normal)
     mgo::Display display{
         native_display,
         std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
-        mr::null_display_report()};
+        mr::null_display_report(),
+        std::string{}};
 
     int count = 0;
     display.for_each_display_sync_group([&](mg::DisplaySyncGroup& group) {
@@ -86,7 +90,8 @@ TEST_F(OffscreenDisplayTest, never_enables_predictive_bypass)
     mgo::Display display{
         native_display,
         std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
-        mr::null_display_report()};
+        mr::null_display_report(),
+        std::string{}};
 
     int groups = 0;
     display.for_each_display_sync_group([&](mg::DisplaySyncGroup& group){
@@ -121,7 +126,8 @@ TEST_F(OffscreenDisplayTest, makes_fbo_current_rendering_target)
     mgo::Display display{
         native_display,
         std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
-        mr::null_display_report()};
+        mr::null_display_report(),
+        std::string{}};
 
     Mock::VerifyAndClearExpectations(&mock_gl);
 
@@ -170,6 +176,55 @@ TEST_F(OffscreenDisplayTest, restores_previous_state_on_fbo_setup_failure)
         mgo::Display display(
             native_display,
             std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
-            mr::null_display_report());
+            mr::null_display_report(),
+            std::string{});
     }, std::runtime_error);
 }
+
+TEST_F(OffscreenDisplayTest, software_display_makes_no_egl_calls)
+{
+    using namespace ::testing;
+    EXPECT_CALL(mock_egl, eglGetDisplay(_)).Times(0);
+    EXPECT_CALL(mock_egl, eglInitialize(_,_,_)).Times(0);
+    EXPECT_CALL(mock_egl, eglCreateContext(_,_,_,_)).Times(0);
+    EXPECT_CALL(mock_gl, glGenFramebuffers(_,_)).Times(0);
+
+    mgo::SoftwareDisplay display{
+        std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
+        std::string{}};
+
+    display.for_each_display_sync_group([&](mg::DisplaySyncGroup& group) {
+        group.for_each_display_buffer([&](mg::DisplayBuffer& db) {
+            auto const target = dynamic_cast<mir::renderer::software::RenderTarget*>(db.native_display_buffer());
+            ASSERT_THAT(target, NotNull());
+            target->write([](unsigned char* pixels) { pixels[0] = 0xff; });
+            target->swap_buffers();
+        });
+    });
+}
+
+TEST_F(OffscreenDisplayTest, software_display_buffers_are_software_render_targets_only)
+{
+    mgo::SoftwareDisplay display{
+        std::make_shared<mg::CloneDisplayConfigurationPolicy>(),
+        std::string{}};
+
+    int count = 0;
+    display.for_each_display_sync_group([&](mg::DisplaySyncGroup& group) {
+        group.for_each_display_buffer([&](mg::DisplayBuffer& db) {
+            ++count;
+            auto const native = db.native_display_buffer();
+            EXPECT_FALSE(dynamic_cast<mir::renderer::gl::RenderTarget*>(native));
+
+            auto const target = dynamic_cast<mir::renderer::software::RenderTarget*>(native);
+            ASSERT_TRUE(target);
+            EXPECT_EQ(db.view_area().size, target->size());
+            EXPECT_EQ(mir_pixel_format_abgr_8888, target->pixel_format());
+            EXPECT_EQ(
+                mir::geometry::Stride{target->size().width.as_int() * 4},
+                target->stride());
+        });
+    });
+
+    EXPECT_TRUE(count);
+}
@@ -18,11 +18,14 @@
 
 #include <gtest/gtest.h>
 #include <fcntl.h>
+#include <fstream>
+#include <mutex>
 #include <boost/throw_exception.hpp>
 
 #include "mir/graphics/platform.h"
 #include "src/server/graphics/platform_probe.h"
 #include "mir/options/program_option.h"
+#include "mir/options/configuration.h"
 
 #include "mir/raii.h"
 
@@ -255,6 +258,54 @@ TEST(ServerPlatformProbe, LoadsSupportedModuleWhenNoBestModule)
     EXPECT_THAT(description->name, HasSubstr("mir:stub-graphics"));
 }
 
+TEST(ServerPlatformProbe, RemembersSelectedModuleInProbeCache)
+{
+    using namespace testing;
+    char cache_file[] = "/tmp/mir-platform-probe-cache-XXXXXX";
+    close(mkstemp(cache_file));
+    auto const remove_cache = mir::raii::deleter_for(cache_file, [](char const* file) { unlink(file); });
+
+    mir::options::ProgramOption options;
+    boost::program_options::options_description desc("");
+    desc.add_options()
+        (mir::options::platform_probe_cache, boost::program_options::value<std::string>(), "");
+    std::array<char const*, 3> args {{ "./aserver", "--platform-probe-cache", cache_file }};
+    options.parse_arguments(desc, args.size(), args.data());
+
+    auto block_mesa = ensure_mesa_probing_fails();
+
+    auto modules = available_platforms();
+    add_dummy_platform(modules);
+
+    std::mutex probed_mutex;
+    std::vector<mir::SharedLibrary*> probed;
+    auto const console = std::make_shared<mtd::NullConsoleServices>();
+    auto const recording_probe =
+        [&](mir::SharedLibrary& module)
+        {
+            {
+                std::lock_guard<std::mutex> lock{probed_mutex};
+                probed.push_back(&module);
+            }
+            return mir::graphics::probe_module(module, options, console);
+        };
+
+    auto const first = mir::graphics::select_module(modules, options, recording_probe);
+
+    std::ifstream cache{cache_file};
+    std::string key, cached_module;
+    std::getline(cache, key);
+    std::getline(cache, cached_module);
+    EXPECT_THAT(cached_module, HasSubstr("graphics-dummy"));
+    EXPECT_THAT(probed, SizeIs(modules.size()));
+
+    probed.clear();
+    auto const second = mir::graphics::select_module(modules, options, recording_probe);
+    EXPECT_THAT(second, Eq(first));
+    // Only the remembered module is asked whether it still applies
+    EXPECT_THAT(probed, ElementsAre(first.get()));
+}
+
 TEST_F(ServerPlatformProbeMockDRM, IgnoresNonPlatformModules)
 {
     using namespace testing;
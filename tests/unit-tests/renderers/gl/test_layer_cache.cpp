@@ -0,0 +1,177 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/renderers/gl/layer_cache.h"
+
+#include <mir/test/doubles/mock_gl.h>
+#include <mir/test/doubles/stub_buffer.h>
+#include <mir/test/doubles/stub_renderable.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mg = mir::graphics;
+namespace mrg = mir::renderer::gl;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+struct MovableRenderable : mtd::StubRenderable
+{
+    MovableRenderable(geom::Rectangle const& rect)
+        : StubRenderable{rect},
+          position{rect}
+    {
+    }
+
+    geom::Rectangle screen_position() const override
+    {
+        return position;
+    }
+
+    geom::Rectangle position;
+};
+
+struct LayerCache : Test
+{
+    LayerCache()
+    {
+        for (int i = 0; i != 4; ++i)
+        {
+            renderables.push_back(std::make_shared<MovableRenderable>(geom::Rectangle{{i * 10, 0}, {100, 100}}));
+            scene.push_back(renderables.back());
+        }
+    }
+
+    /// Plans frames until the scene has settled into the cache
+    void settle()
+    {
+        for (int frame = 0; frame != 3; ++frame)
+            cache.plan(scene);
+        ASSERT_THAT(cache.plan(scene).redraw, Eq(true));
+    }
+
+    NiceMock<mtd::MockGL> mock_gl;
+    mrg::LayerCache cache;
+    std::vector<std::shared_ptr<MovableRenderable>> renderables;
+    mg::RenderableList scene;
+};
+
+MATCHER_P2(IsPlan, cached, redraw, "")
+{
+    return arg.cached == size_t(cached) && arg.redraw == redraw;
+}
+}
+
+TEST_F(LayerCache, caches_renderables_once_they_have_settled)
+{
+    for (int frame = 0; frame != 3; ++frame)
+        EXPECT_THAT(cache.plan(scene), IsPlan(0, false));
+
+    EXPECT_THAT(cache.plan(scene), IsPlan(4, true));
+    EXPECT_THAT(cache.plan(scene), IsPlan(4, false));
+    EXPECT_THAT(cache.plan(scene), IsPlan(4, false));
+}
+
+TEST_F(LayerCache, caches_only_the_settled_bottom_of_the_stack)
+{
+    for (int frame = 0; frame != 3; ++frame)
+    {
+        renderables[2]->set_buffer(std::make_shared<mtd::StubBuffer>(geom::Size{100, 100}));
+        cache.plan(scene);
+    }
+
+    renderables[2]->set_buffer(std::make_shared<mtd::StubBuffer>(geom::Size{100, 100}));
+    EXPECT_THAT(cache.plan(scene), IsPlan(2, true));
+
+    renderables[2]->set_buffer(std::make_shared<mtd::StubBuffer>(geom::Size{100, 100}));
+    EXPECT_THAT(cache.plan(scene), IsPlan(2, false));
+}
+
+TEST_F(LayerCache, redraws_when_a_cached_renderable_changes_buffer)
+{
+    settle();
+
+    renderables[2]->set_buffer(std::make_shared<mtd::StubBuffer>(geom::Size{100, 100}));
+
+    EXPECT_THAT(cache.plan(scene), IsPlan(2, true));
+}
+
+TEST_F(LayerCache, redraws_when_a_cached_renderable_moves)
+{
+    settle();
+
+    renderables[3]->position.top_left = {5, 5};
+
+    EXPECT_THAT(cache.plan(scene), IsPlan(3, true));
+}
+
+TEST_F(LayerCache, redraws_when_cached_renderables_are_restacked_or_removed)
+{
+    settle();
+
+    std::swap(scene[1], scene[3]);
+    EXPECT_THAT(cache.plan(scene), IsPlan(4, true));
+
+    scene.erase(scene.begin());
+    EXPECT_THAT(cache.plan(scene), IsPlan(3, true));
+}
+
+TEST_F(LayerCache, stops_caching_when_too_little_has_settled)
+{
+    settle();
+
+    renderables[1]->set_buffer(std::make_shared<mtd::StubBuffer>(geom::Size{100, 100}));
+
+    EXPECT_THAT(cache.plan(scene), IsPlan(0, false));
+}
+
+TEST_F(LayerCache, redraws_after_being_invalidated)
+{
+    settle();
+
+    cache.invalidate();
+
+    EXPECT_THAT(cache.plan(scene), IsPlan(4, true));
+}
+
+TEST_F(LayerCache, allocates_its_framebuffer_once_per_size)
+{
+    GLuint const framebuffer = 7;
+    ON_CALL(mock_gl, glGenFramebuffers(1, _))
+        .WillByDefault(SetArgPointee<1>(framebuffer));
+    ON_CALL(mock_gl, glCheckFramebufferStatus(GL_FRAMEBUFFER))
+        .WillByDefault(Return(GL_FRAMEBUFFER_COMPLETE));
+
+    EXPECT_CALL(mock_gl, glGenFramebuffers(1, _)).Times(2);
+    EXPECT_CALL(mock_gl, glViewport(0, 0, 640, 480)).Times(2);
+    EXPECT_CALL(mock_gl, glViewport(0, 0, 800, 600)).Times(1);
+
+    EXPECT_TRUE(cache.bind_for_redraw({640, 480}));
+    EXPECT_TRUE(cache.bind_for_redraw({640, 480}));
+    EXPECT_TRUE(cache.bind_for_redraw({800, 600}));
+}
+
+TEST_F(LayerCache, fails_if_the_driver_cannot_render_to_a_texture)
+{
+    ON_CALL(mock_gl, glCheckFramebufferStatus(GL_FRAMEBUFFER))
+        .WillByDefault(Return(GL_FRAMEBUFFER_UNSUPPORTED));
+
+    EXPECT_FALSE(cache.bind_for_redraw({640, 480}));
+}
@@ -0,0 +1,291 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/renderers/gl/program_binary_cache.h"
+#include "src/renderers/gl/program_family.h"
+#include "mir/raii.h"
+
+#include <mir/test/doubles/mock_gl.h>
+#include <mir/test/doubles/mock_egl.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <fstream>
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace mrg = mir::renderer::gl;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+
+namespace
+{
+void remove_directory(char const* path)
+{
+    if (auto const dir = opendir(path))
+    {
+        while (auto const entry = readdir(dir))
+        {
+            if (entry->d_name[0] != '.')
+                unlink((std::string{path} + "/" + entry->d_name).c_str());
+        }
+        closedir(dir);
+    }
+    rmdir(path);
+}
+
+auto files_in(std::string const& path) -> std::vector<std::string>
+{
+    std::vector<std::string> files;
+    if (auto const dir = opendir(path.c_str()))
+    {
+        while (auto const entry = readdir(dir))
+        {
+            if (entry->d_name[0] != '.')
+                files.push_back(path + "/" + entry->d_name);
+        }
+        closedir(dir);
+    }
+    return files;
+}
+
+auto binary_of(std::vector<char> const& data) -> std::shared_ptr<mrg::ProgramBinaryCache::Binary const>
+{
+    return std::make_shared<mrg::ProgramBinaryCache::Binary const>(mrg::ProgramBinaryCache::Binary{0x1234, data});
+}
+
+struct ProgramBinaryCache : Test
+{
+    ProgramBinaryCache()
+    {
+        mkdtemp(directory);
+    }
+
+    ~ProgramBinaryCache()
+    {
+        remove_directory(directory);
+    }
+
+    char directory[40] = "/tmp/mir-program-binary-cache-XXXXXX";
+    std::string const key{std::string{"vendor\nrenderer\nversion\nvertex source"} + '\0' + "fragment source"};
+};
+
+struct MockProgramBinaryExtension
+{
+    MOCK_METHOD5(glGetProgramBinaryOES, void(GLuint, GLsizei, GLsizei*, GLenum*, void*));
+    MOCK_METHOD4(glProgramBinaryOES, void(GLuint, GLenum, void const*, GLint));
+};
+
+MockProgramBinaryExtension* global_mock_extension = nullptr;
+
+// The cache resolves these once per process, so they forward to whichever test's mock is current
+void fake_glGetProgramBinaryOES(GLuint program, GLsizei size, GLsizei* length, GLenum* format, void* binary)
+{
+    global_mock_extension->glGetProgramBinaryOES(program, size, length, format, binary);
+}
+
+void fake_glProgramBinaryOES(GLuint program, GLenum format, void const* binary, GLint length)
+{
+    global_mock_extension->glProgramBinaryOES(program, format, binary, length);
+}
+
+struct ProgramBinaryCacheWithDriver : ProgramBinaryCache
+{
+    ProgramBinaryCacheWithDriver()
+    {
+        using func_ptr_t = mtd::MockEGL::generic_function_pointer_t;
+
+        global_mock_extension = &mock_extension;
+
+        ON_CALL(mock_gl, glGetString(GL_EXTENSIONS))
+            .WillByDefault(Return(reinterpret_cast<GLubyte const*>("GL_OES_EGL_image GL_OES_get_program_binary")));
+        ON_CALL(mock_gl, glGetString(GL_VENDOR)).WillByDefault(Return(reinterpret_cast<GLubyte const*>("vendor")));
+        ON_CALL(mock_gl, glGetString(GL_RENDERER)).WillByDefault(Return(reinterpret_cast<GLubyte const*>("renderer")));
+        ON_CALL(mock_gl, glGetString(GL_VERSION)).WillByDefault(Return(reinterpret_cast<GLubyte const*>("version")));
+        ON_CALL(mock_gl, glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, _)).WillByDefault(SetArgPointee<1>(1));
+        ON_CALL(mock_gl, glCreateProgram()).WillByDefault(Return(program));
+
+        ON_CALL(mock_egl, eglGetProcAddress(StrEq("glGetProgramBinaryOES")))
+            .WillByDefault(Return(reinterpret_cast<func_ptr_t>(&fake_glGetProgramBinaryOES)));
+        ON_CALL(mock_egl, eglGetProcAddress(StrEq("glProgramBinaryOES")))
+            .WillByDefault(Return(reinterpret_cast<func_ptr_t>(&fake_glProgramBinaryOES)));
+    }
+
+    ~ProgramBinaryCacheWithDriver()
+    {
+        global_mock_extension = nullptr;
+    }
+
+    GLuint const program{42};
+
+    NiceMock<mtd::MockGL> mock_gl;
+    NiceMock<mtd::MockEGL> mock_egl;
+    NiceMock<MockProgramBinaryExtension> mock_extension;
+};
+
+MATCHER_P(BytesAre, expected, "")
+{
+    return std::equal(expected.begin(), expected.end(), static_cast<char const*>(arg));
+}
+}
+
+TEST_F(ProgramBinaryCache, finds_binaries_it_was_given)
+{
+    mrg::ProgramBinaryCache cache;
+
+    EXPECT_THAT(cache.find(key), IsNull());
+
+    cache.insert(key, binary_of({1, 2, 3}));
+
+    auto const found = cache.find(key);
+    ASSERT_THAT(found, NotNull());
+    EXPECT_THAT(found->format, Eq(0x1234u));
+    EXPECT_THAT(found->data, ElementsAre(1, 2, 3));
+    EXPECT_THAT(cache.find(key + "x"), IsNull());
+}
+
+TEST_F(ProgramBinaryCache, keeps_the_first_binary_for_a_key)
+{
+    mrg::ProgramBinaryCache cache;
+
+    cache.insert(key, binary_of({1, 2, 3}));
+    cache.insert(key, binary_of({4, 5, 6}));
+
+    EXPECT_THAT(cache.find(key)->data, ElementsAre(1, 2, 3));
+}
+
+TEST_F(ProgramBinaryCache, keeps_binaries_between_runs_in_its_directory)
+{
+    mrg::ProgramBinaryCache{directory}.insert(key, binary_of({1, 2, 3}));
+
+    mrg::ProgramBinaryCache cache{directory};
+
+    auto const found = cache.find(key);
+    ASSERT_THAT(found, NotNull());
+    EXPECT_THAT(found->format, Eq(0x1234u));
+    EXPECT_THAT(found->data, ElementsAre(1, 2, 3));
+}
+
+TEST_F(ProgramBinaryCache, ignores_damaged_files)
+{
+    mrg::ProgramBinaryCache{directory}.insert(key, binary_of({1, 2, 3}));
+
+    for (auto const& file : files_in(directory))
+    {
+        std::ofstream out{file, std::ios::trunc};
+        out << "mir-gl-program-binary 1\nnot really";
+    }
+
+    EXPECT_THAT(mrg::ProgramBinaryCache{directory}.find(key), IsNull());
+}
+
+TEST_F(ProgramBinaryCache, erase_forgets_binary_and_its_file)
+{
+    mrg::ProgramBinaryCache cache{directory};
+    cache.insert(key, binary_of({1, 2, 3}));
+    ASSERT_THAT(files_in(directory), SizeIs(1));
+
+    cache.erase(key);
+
+    EXPECT_THAT(cache.find(key), IsNull());
+    EXPECT_THAT(files_in(directory), IsEmpty());
+}
+
+TEST_F(ProgramBinaryCache, does_not_load_programs_when_driver_has_no_program_binaries)
+{
+    NiceMock<mtd::MockGL> mock_gl;
+    ON_CALL(mock_gl, glGetString(GL_EXTENSIONS))
+        .WillByDefault(Return(reinterpret_cast<GLubyte const*>("GL_OES_texture_npot GL_EXT_texture_format_BGRA8888")));
+
+    mrg::ProgramBinaryCache cache;
+
+    EXPECT_CALL(mock_gl, glCreateProgram()).Times(0);
+    EXPECT_THAT(cache.load_program("vertex source", "fragment source"), Eq(0u));
+}
+
+TEST_F(ProgramBinaryCacheWithDriver, loads_program_from_cached_binary)
+{
+    mrg::ProgramBinaryCache cache;
+    cache.insert(key, binary_of({1, 2, 3}));
+
+    EXPECT_CALL(mock_extension, glProgramBinaryOES(program, 0x1234u, BytesAre(std::vector<char>{1, 2, 3}), 3));
+    EXPECT_CALL(mock_gl, glDeleteProgram(_)).Times(0);
+
+    EXPECT_THAT(cache.load_program("vertex source", "fragment source"), Eq(program));
+}
+
+TEST_F(ProgramBinaryCacheWithDriver, stores_binary_of_linked_program)
+{
+    mrg::ProgramBinaryCache cache;
+
+    ON_CALL(mock_gl, glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, _)).WillByDefault(SetArgPointee<2>(3));
+    EXPECT_CALL(mock_extension, glGetProgramBinaryOES(program, 3, _, _, _))
+        .WillOnce(Invoke([](GLuint, GLsizei, GLsizei* length, GLenum* format, void* binary)
+            {
+                *length = 3;
+                *format = 0x1234;
+                memcpy(binary, "\1\2\3", 3);
+            }));
+
+    cache.store_program(program, "vertex source", "fragment source");
+
+    auto const found = cache.find(key);
+    ASSERT_THAT(found, NotNull());
+    EXPECT_THAT(found->format, Eq(0x1234u));
+    EXPECT_THAT(found->data, ElementsAre(1, 2, 3));
+}
+
+TEST_F(ProgramBinaryCacheWithDriver, drops_binary_the_driver_rejects)
+{
+    mrg::ProgramBinaryCache cache{directory};
+    cache.insert(key, binary_of({1, 2, 3}));
+
+    ON_CALL(mock_gl, glGetProgramiv(program, GL_LINK_STATUS, _)).WillByDefault(SetArgPointee<2>(GL_FALSE));
+    EXPECT_CALL(mock_gl, glDeleteProgram(program));
+
+    EXPECT_THAT(cache.load_program("vertex source", "fragment source"), Eq(0u));
+    EXPECT_THAT(cache.find(key), IsNull());
+    EXPECT_THAT(files_in(directory), IsEmpty());
+}
+
+TEST_F(ProgramBinaryCacheWithDriver, program_with_rejected_binary_is_compiled_from_source)
+{
+    auto const cache = std::make_shared<mrg::ProgramBinaryCache>();
+    cache->insert(key, binary_of({1, 2, 3}));
+
+    GLuint const loaded{41};
+    EXPECT_CALL(mock_gl, glCreateProgram())
+        .WillOnce(Return(loaded))
+        .WillOnce(Return(program));
+    ON_CALL(mock_gl, glGetProgramiv(loaded, GL_LINK_STATUS, _)).WillByDefault(SetArgPointee<2>(GL_FALSE));
+    ON_CALL(mock_gl, glCreateShader(_)).WillByDefault(Return(7));
+    EXPECT_CALL(mock_gl, glDeleteProgram(_)).Times(AnyNumber());
+
+    {
+        InSequence seq;
+        EXPECT_CALL(mock_gl, glDeleteProgram(loaded));
+        EXPECT_CALL(mock_gl, glShaderSource(_, 1, Pointee(StrEq("vertex source")), _));
+        EXPECT_CALL(mock_gl, glShaderSource(_, 1, Pointee(StrEq("fragment source")), _));
+        EXPECT_CALL(mock_gl, glLinkProgram(program));
+    }
+
+    mrg::ProgramFamily family{cache};
+    EXPECT_THAT(family.add_program("vertex source", "fragment source"), Eq(program));
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/renderers/gl/texture_atlas.h"
+
+#include <mir/test/doubles/mock_gl.h>
+#include <mir/test/doubles/stub_buffer.h>
+#include <mir/test/doubles/stub_renderable.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+namespace mg = mir::graphics;
+namespace mrg = mir::renderer::gl;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+int const atlas_size = 64;
+
+auto shm_buffer(geom::Size const& size, MirPixelFormat format = mir_pixel_format_abgr_8888)
+    -> std::shared_ptr<mtd::StubBuffer>
+{
+    return std::make_shared<mtd::StubBuffer>(
+        mg::BufferProperties{size, format, mg::BufferUsage::software});
+}
+
+struct ClippedRenderable : mtd::StubRenderable
+{
+    using StubRenderable::StubRenderable;
+
+    std::experimental::optional<geom::Rectangle> clip_area() const override
+    {
+        return geom::Rectangle{{0, 0}, {4, 4}};
+    }
+};
+
+struct ScaledRenderable : mtd::StubRenderable
+{
+    using StubRenderable::StubRenderable;
+
+    glm::mat4 transformation() const override
+    {
+        glm::mat4 transform{1};
+        transform[0][0] = 2;
+        return transform;
+    }
+};
+
+struct TextureAtlas : Test
+{
+    NiceMock<mtd::MockGL> mock_gl;
+    mrg::TextureAtlas atlas{atlas_size};
+    geom::Size const small{16, 16};
+};
+}
+
+TEST_F(TextureAtlas, uploads_a_new_renderable_once)
+{
+    mtd::StubRenderable renderable{shm_buffer(small), {{10, 10}, small}};
+
+    // With a pixel of padding all round
+    EXPECT_CALL(mock_gl, glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 18, 18, GL_RGBA, GL_UNSIGNED_BYTE, _))
+        .Times(1);
+
+    for (int frame = 0; frame != 3; ++frame)
+    {
+        auto const region = atlas.region_for(renderable);
+        ASSERT_THAT(region, NotNull());
+        EXPECT_THAT(region->left, FloatEq(1.0f / atlas_size));
+        EXPECT_THAT(region->top, FloatEq(1.0f / atlas_size));
+        EXPECT_THAT(region->right, FloatEq(17.0f / atlas_size));
+        EXPECT_THAT(region->bottom, FloatEq(17.0f / atlas_size));
+        atlas.drop_unused();
+    }
+}
+
+TEST_F(TextureAtlas, uploads_a_settled_renderable_again_when_its_buffer_changes)
+{
+    mtd::StubRenderable renderable{shm_buffer(small), {{10, 10}, small}};
+
+    EXPECT_CALL(mock_gl, glTexSubImage2D(_, _, _, _, _, _, _, _, _)).Times(2);
+
+    for (int frame = 0; frame != 10; ++frame)
+    {
+        EXPECT_THAT(atlas.region_for(renderable), NotNull());
+        atlas.drop_unused();
+    }
+
+    renderable.set_buffer(shm_buffer(small));
+    EXPECT_THAT(atlas.region_for(renderable), NotNull());
+}
+
+TEST_F(TextureAtlas, leaves_a_rapidly_changing_renderable_to_be_drawn_normally)
+{
+    mtd::StubRenderable renderable{shm_buffer(small), {{10, 10}, small}};
+
+    EXPECT_CALL(mock_gl, glTexSubImage2D(_, _, _, _, _, _, _, _, _)).Times(1);
+
+    EXPECT_THAT(atlas.region_for(renderable), NotNull());
+    atlas.drop_unused();
+
+    for (int frame = 0; frame != 3; ++frame)
+    {
+        renderable.set_buffer(shm_buffer(small));
+        EXPECT_THAT(atlas.region_for(renderable), IsNull());
+        atlas.drop_unused();
+    }
+}
+
+TEST_F(TextureAtlas, takes_in_a_renderable_that_stops_changing)
+{
+    mtd::StubRenderable renderable{shm_buffer(small), {{10, 10}, small}};
+
+    EXPECT_THAT(atlas.region_for(renderable), NotNull());
+    atlas.drop_unused();
+
+    for (int frame = 0; frame != 2; ++frame)
+    {
+        renderable.set_buffer(shm_buffer(small));
+        EXPECT_THAT(atlas.region_for(renderable), IsNull());
+        atlas.drop_unused();
+    }
+
+    // The last buffer is kept from now on
+    for (int frame = 0; frame != 7; ++frame)
+    {
+        EXPECT_THAT(atlas.region_for(renderable), IsNull());
+        atlas.drop_unused();
+    }
+
+    EXPECT_CALL(mock_gl, glTexSubImage2D(_, _, _, _, _, _, _, _, _)).Times(1);
+
+    for (int frame = 0; frame != 3; ++frame)
+    {
+        EXPECT_THAT(atlas.region_for(renderable), NotNull());
+        atlas.drop_unused();
+    }
+}
+
+TEST_F(TextureAtlas, rejects_renderables_it_cannot_draw_one_to_one)
+{
+    geom::Size const large{48, 48};
+    mtd::StubRenderable too_large{shm_buffer(large), {{0, 0}, large}};
+    mtd::StubRenderable stretched{shm_buffer(small), {{0, 0}, {32, 32}}};
+    mtd::StubRenderable not_rgb{shm_buffer(small, mir_pixel_format_rgb_565), {{0, 0}, small}};
+    ClippedRenderable clipped{shm_buffer(small), {{0, 0}, small}};
+    ScaledRenderable scaled{shm_buffer(small), {{0, 0}, small}};
+
+    EXPECT_CALL(mock_gl, glTexSubImage2D(_, _, _, _, _, _, _, _, _)).Times(0);
+
+    EXPECT_THAT(atlas.region_for(too_large), IsNull());
+    EXPECT_THAT(atlas.region_for(stretched), IsNull());
+    EXPECT_THAT(atlas.region_for(not_rgb), IsNull());
+    EXPECT_THAT(atlas.region_for(clipped), IsNull());
+    EXPECT_THAT(atlas.region_for(scaled), IsNull());
+}
+
+TEST_F(TextureAtlas, uploads_pixels_as_rgba)
+{
+    geom::Size const one_pixel{1, 1};
+    auto const argb = shm_buffer(one_pixel, mir_pixel_format_argb_8888);
+    auto const xrgb = shm_buffer(one_pixel, mir_pixel_format_xrgb_8888);
+    uint32_t const pixel = 0x80112233;
+    argb->write(reinterpret_cast<unsigned char const*>(&pixel), sizeof pixel);
+    xrgb->write(reinterpret_cast<unsigned char const*>(&pixel), sizeof pixel);
+    mtd::StubRenderable translucent{argb, {{0, 0}, one_pixel}};
+    mtd::StubRenderable opaque{xrgb, {{0, 0}, one_pixel}};
+
+    std::vector<uint32_t> uploaded;
+    ON_CALL(mock_gl, glTexSubImage2D(_, _, _, _, _, _, _, _, _))
+        .WillByDefault(Invoke(
+            [&](GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, GLvoid const* pixels)
+            {
+                uint32_t value;
+                std::memcpy(&value, pixels, sizeof value);
+                uploaded.push_back(value);
+            }));
+
+    atlas.region_for(translucent);
+    atlas.region_for(opaque);
+
+    EXPECT_THAT(uploaded, ElementsAre(0x80332211u, 0xff332211u));
+}
+
+TEST_F(TextureAtlas, pads_renderables_with_copies_of_their_edge_pixels)
+{
+    geom::Size const two_by_two{2, 2};
+    auto const buffer = shm_buffer(two_by_two);
+    uint32_t const pixels[] = {0xff000001, 0xff000002, 0xff000003, 0xff000004};
+    buffer->write(reinterpret_cast<unsigned char const*>(pixels), sizeof pixels);
+    mtd::StubRenderable renderable{buffer, {{0, 0}, two_by_two}};
+
+    std::vector<uint32_t> uploaded;
+    EXPECT_CALL(mock_gl, glTexSubImage2D(_, _, 0, 0, 4, 4, _, _, _))
+        .WillOnce(Invoke(
+            [&](GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum, GLenum, GLvoid const* pixels)
+            {
+                auto const begin = static_cast<uint32_t const*>(pixels);
+                uploaded.assign(begin, begin + width * height);
+            }));
+
+    atlas.region_for(renderable);
+
+    EXPECT_THAT(uploaded, ElementsAre(
+        0xff000001u, 0xff000001u, 0xff000002u, 0xff000002u,
+        0xff000001u, 0xff000001u, 0xff000002u, 0xff000002u,
+        0xff000003u, 0xff000003u, 0xff000004u, 0xff000004u,
+        0xff000003u, 0xff000003u, 0xff000004u, 0xff000004u));
+}
+
+TEST_F(TextureAtlas, reclaims_space_once_full)
+{
+    // 16x16 slots (18x18 with padding) fit three to a shelf and three shelves high
+    std::vector<std::unique_ptr<mtd::StubRenderable>> renderables;
+    for (int i = 0; i != 10; ++i)
+        renderables.push_back(std::make_unique<mtd::StubRenderable>(shm_buffer(small), geom::Rectangle{{0, 0}, small}));
+
+    for (int i = 0; i != 9; ++i)
+        EXPECT_THAT(atlas.region_for(*renderables[i]), NotNull());
+    EXPECT_THAT(atlas.region_for(*renderables[9]), IsNull());
+    atlas.drop_unused();
+
+    renderables[0].reset();
+    for (int i = 1; i != 10; ++i)
+        atlas.region_for(*renderables[i]);
+    atlas.drop_unused();
+
+    for (int i = 1; i != 10; ++i)
+        EXPECT_THAT(atlas.region_for(*renderables[i]), NotNull());
+}
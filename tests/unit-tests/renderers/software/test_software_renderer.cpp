@@ -0,0 +1,254 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <src/renderers/software/renderer.h>
+#include <src/renderers/software/pixel_ops.h>
+#include <mir/test/doubles/stub_sw_display_buffer.h>
+#include <mir/test/doubles/stub_buffer.h>
+#include <mir/test/doubles/stub_renderable.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+
+namespace mg = mir::graphics;
+namespace mrs = mir::renderer::software;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+uint32_t const red = 0xffff0000;   // as argb_8888
+uint32_t const green = 0xff00ff00;
+uint32_t const blue = 0xff0000ff;
+uint32_t const half_white = 0x80808080;
+
+struct TestRenderable : mtd::StubRenderable
+{
+    TestRenderable(std::shared_ptr<mg::Buffer> const& buffer, geom::Rectangle const& rect)
+        : StubRenderable{buffer, rect}
+    {
+    }
+
+    std::experimental::optional<geom::Rectangle> clip_area() const override { return clip; }
+    float alpha() const override { return alpha_; }
+    bool shaped() const override { return shaped_; }
+
+    std::experimental::optional<geom::Rectangle> clip;
+    float alpha_{1.0f};
+    bool shaped_{false};
+};
+
+struct CountingBuffer : mtd::StubBuffer
+{
+    using StubBuffer::StubBuffer;
+
+    void read(std::function<void(unsigned char const*)> const& do_with_pixels) override
+    {
+        ++reads;
+        StubBuffer::read(do_with_pixels);
+    }
+
+    int reads{0};
+};
+
+struct SoftwareRenderer : Test
+{
+    std::shared_ptr<CountingBuffer> buffer_of(
+        geom::Size size, std::vector<uint32_t> const& pixels,
+        MirPixelFormat format = mir_pixel_format_argb_8888)
+    {
+        auto const buffer = std::make_shared<CountingBuffer>(
+            mg::BufferProperties{size, format, mg::BufferUsage::software});
+        buffer->write(reinterpret_cast<unsigned char const*>(pixels.data()), pixels.size() * sizeof(uint32_t));
+        return buffer;
+    }
+
+    std::shared_ptr<CountingBuffer> filled(geom::Size size, uint32_t pixel)
+    {
+        return buffer_of(size, std::vector<uint32_t>(size.width.as_int() * size.height.as_int(), pixel));
+    }
+
+    geom::Rectangle const screen{{0, 0}, {4, 2}};
+    mtd::StubSWDisplayBuffer display_buffer{screen};
+};
+}
+
+TEST_F(SoftwareRenderer, throws_for_display_buffer_without_software_support)
+{
+    mtd::StubDisplayBuffer gl_only{screen};
+
+    EXPECT_THROW(mrs::Renderer{gl_only}, std::logic_error);
+}
+
+TEST_F(SoftwareRenderer, clears_to_transparent_black_when_nothing_is_visible)
+{
+    std::fill(display_buffer.pixels.begin(), display_buffer.pixels.end(), red);
+    mrs::Renderer renderer{display_buffer};
+
+    renderer.render({});
+
+    EXPECT_THAT(display_buffer.pixels, Each(Eq(0u)));
+    EXPECT_THAT(display_buffer.swaps, Eq(1));
+}
+
+TEST_F(SoftwareRenderer, copies_opaque_surface_to_its_position_in_the_viewport)
+{
+    mrs::Renderer renderer{display_buffer};
+    renderer.set_viewport({{10, 20}, screen.size});
+    auto const surface = std::make_shared<TestRenderable>(
+        buffer_of({2, 1}, {red, green}), geom::Rectangle{{11, 21}, {2, 1}});
+
+    renderer.render({surface});
+
+    EXPECT_THAT(display_buffer.pixels, ElementsAre(
+        0u, 0u, 0u, 0u,
+        0u, red, green, 0u));
+}
+
+TEST_F(SoftwareRenderer, converts_between_red_first_and_blue_first_formats)
+{
+    mrs::Renderer renderer{display_buffer};
+    // abgr_8888 is R, G, B, A in memory
+    auto const surface = std::make_shared<TestRenderable>(
+        buffer_of({1, 1}, {0xff0000ff}, mir_pixel_format_abgr_8888), geom::Rectangle{{0, 0}, {1, 1}});
+
+    renderer.render({surface});
+
+    EXPECT_THAT(display_buffer.pixel_at(0, 0), Eq(red));
+}
+
+TEST_F(SoftwareRenderer, treats_padding_of_unshaped_surfaces_as_opaque)
+{
+    mrs::Renderer renderer{display_buffer};
+    auto const surface = std::make_shared<TestRenderable>(
+        buffer_of({1, 1}, {0x0000ff00}, mir_pixel_format_xrgb_8888), geom::Rectangle{{0, 0}, {1, 1}});
+
+    renderer.render({surface});
+
+    EXPECT_THAT(display_buffer.pixel_at(0, 0), Eq(green));
+}
+
+TEST_F(SoftwareRenderer, blends_shaped_surface_over_what_is_beneath)
+{
+    mrs::Renderer renderer{display_buffer};
+    auto const below = std::make_shared<TestRenderable>(filled(screen.size, blue), screen);
+    auto const above = std::make_shared<TestRenderable>(
+        buffer_of({2, 1}, {half_white, 0}), geom::Rectangle{{0, 0}, {2, 1}});
+    above->shaped_ = true;
+
+    renderer.render({below, above});
+
+    EXPECT_THAT(display_buffer.pixel_at(0, 0), Eq(0xff8080ffu));
+    EXPECT_THAT(display_buffer.pixel_at(1, 0), Eq(blue));
+    EXPECT_THAT(display_buffer.pixel_at(2, 0), Eq(blue));
+}
+
+TEST_F(SoftwareRenderer, applies_surface_alpha)
+{
+    mrs::Renderer renderer{display_buffer};
+    auto const below = std::make_shared<TestRenderable>(filled(screen.size, blue), screen);
+    auto const above = std::make_shared<TestRenderable>(filled(screen.size, red), screen);
+    above->alpha_ = 0.5f;
+
+    renderer.render({below, above});
+
+    EXPECT_THAT(display_buffer.pixels, Each(Eq(0xff80007fu)));
+}
+
+TEST_F(SoftwareRenderer, only_draws_inside_clip_area)
+{
+    mrs::Renderer renderer{display_buffer};
+    auto const surface = std::make_shared<TestRenderable>(filled(screen.size, red), screen);
+    surface->clip = geom::Rectangle{{1, 1}, {2, 5}};
+
+    renderer.render({surface});
+
+    EXPECT_THAT(display_buffer.pixels, ElementsAre(
+        0u, 0u, 0u, 0u,
+        0u, red, red, 0u));
+}
+
+TEST_F(SoftwareRenderer, scales_viewport_to_fit_the_display_buffer)
+{
+    mtd::StubSWDisplayBuffer small{screen, {2, 1}};
+    mrs::Renderer renderer{small};
+    auto const surface = std::make_shared<TestRenderable>(
+        buffer_of(screen.size, {red, red, green, green, red, red, green, green}), screen);
+
+    renderer.render({surface});
+
+    EXPECT_THAT(small.pixels, ElementsAre(red, green));
+}
+
+TEST_F(SoftwareRenderer, letterboxes_viewport_with_different_aspect_ratio)
+{
+    mtd::StubSWDisplayBuffer tall{screen, {4, 4}};
+    mrs::Renderer renderer{tall};
+    auto const surface = std::make_shared<TestRenderable>(filled(screen.size, red), screen);
+
+    renderer.render({surface});
+
+    EXPECT_THAT(tall.pixels, ElementsAre(
+        0u, 0u, 0u, 0u,
+        red, red, red, red,
+        red, red, red, red,
+        0u, 0u, 0u, 0u));
+}
+
+TEST_F(SoftwareRenderer, rotates_output_by_output_transform)
+{
+    mtd::StubSWDisplayBuffer portrait{screen, {2, 4}};
+    mrs::Renderer renderer{portrait};
+    renderer.set_output_transform(glm::mat2{0, 1, -1, 0});
+    auto const surface = std::make_shared<TestRenderable>(
+        buffer_of(screen.size, {red, 0, 0, 0, 0, 0, 0, 0}), screen);
+
+    renderer.render({surface});
+
+    // 90° anticlockwise: the top-left of the scene ends up at the bottom-left
+    EXPECT_THAT(portrait.pixel_at(0, 3), Eq(red));
+    EXPECT_THAT(std::count(portrait.pixels.begin(), portrait.pixels.end(), red), Eq(1));
+}
+
+TEST_F(SoftwareRenderer, does_not_read_surfaces_hidden_by_an_opaque_fullscreen_surface)
+{
+    mrs::Renderer renderer{display_buffer};
+    auto const hidden_buffer = filled(screen.size, blue);
+    auto const hidden = std::make_shared<TestRenderable>(hidden_buffer, screen);
+    auto const fullscreen = std::make_shared<TestRenderable>(filled(screen.size, red), screen);
+
+    renderer.render({hidden, fullscreen});
+
+    EXPECT_THAT(hidden_buffer->reads, Eq(0));
+    EXPECT_THAT(display_buffer.pixels, Each(Eq(red)));
+}
+
+TEST(SoftwarePixelOps, blend_row_matches_premultiplied_over_for_all_lengths)
+{
+    for (size_t count = 0; count != 11; ++count)
+    {
+        std::vector<uint32_t> dest(count, 0xff0000ff);
+        std::vector<uint32_t> const src(count, 0x80800000);
+
+        mrs::blend_row(dest.data(), src.data(), count, 255);
+
+        EXPECT_THAT(dest, Each(Eq(0xff80007fu))) << "count = " << count;
+    }
+}
@@ -782,6 +782,109 @@ TEST_F(SurfaceStack, occludes_surface_when_unregistering_all_compositors_that_re
     stack.unregister_compositor(compositor_id3);
 }
 
+TEST_F(SurfaceStack, only_gives_compositor_elements_that_can_appear_in_its_area)
+{
+    using namespace testing;
+
+    auto const on_screen = std::make_shared<ms::BasicSurface>(
+        nullptr /* session */,
+        std::string("on screen"),
+        geom::Rectangle{{0, 0}, {100, 100}},
+        mir_pointer_unconfined,
+        std::list<ms::StreamInfo> { { stub_buffer_stream1, {}, geom::Size{100, 100} } },
+        std::shared_ptr<mg::CursorImage>(),
+        report);
+    auto const off_screen = std::make_shared<ms::BasicSurface>(
+        nullptr /* session */,
+        std::string("off screen"),
+        geom::Rectangle{{200, 200}, {100, 100}},
+        mir_pointer_unconfined,
+        std::list<ms::StreamInfo> { { stub_buffer_stream2, {}, geom::Size{100, 100} } },
+        std::shared_ptr<mg::CursorImage>(),
+        report);
+
+    stack.register_compositor(compositor_id);
+    stack.set_compositor_area(compositor_id, {{0, 0}, {150, 150}});
+    stack.add_surface(on_screen, default_params.input_mode);
+    stack.add_surface(off_screen, default_params.input_mode);
+
+    EXPECT_THAT(
+        stack.scene_elements_for(compositor_id),
+        ElementsAre(SceneElementForStream(stub_buffer_stream1)));
+
+    off_screen->move_to({50, 50});
+
+    EXPECT_THAT(
+        stack.scene_elements_for(compositor_id),
+        ElementsAre(
+            SceneElementForStream(stub_buffer_stream1),
+            SceneElementForStream(stub_buffer_stream2)));
+}
+
+TEST_F(SurfaceStack, occludes_surface_outside_the_area_of_all_compositors)
+{
+    using namespace testing;
+
+    mc::CompositorID const compositor_id2{&compositor_id};
+
+    stack.register_compositor(compositor_id);
+    stack.register_compositor(compositor_id2);
+    stack.set_compositor_area(compositor_id, {{0, 0}, {100, 100}});
+    stack.set_compositor_area(compositor_id2, {{100, 0}, {100, 100}});
+
+    auto const mock_surface = std::make_shared<MockConfigureSurface>();
+    mock_surface->set_streams({ { std::make_shared<mtd::StubBufferStream>(), {}, geom::Size{10, 10} } });
+    mock_surface->move_to({500, 500});
+    stack.add_surface(mock_surface, default_params.input_mode);
+
+    EXPECT_CALL(*mock_surface, configure(mir_window_attrib_visibility, mir_window_visibility_occluded))
+        .Times(AtLeast(1));
+
+    EXPECT_THAT(stack.scene_elements_for(compositor_id), IsEmpty());
+    EXPECT_THAT(stack.scene_elements_for(compositor_id2), IsEmpty());
+}
+
+TEST_F(SurfaceStack, compositor_does_not_count_pending_frames_from_surfaces_outside_its_area)
+{
+    using namespace testing;
+
+    auto const on_screen_stream = std::make_shared<mc::Stream>(geom::Size{10, 10}, mir_pixel_format_abgr_8888);
+    auto const off_screen_stream = std::make_shared<mc::Stream>(geom::Size{10, 10}, mir_pixel_format_abgr_8888);
+
+    auto const on_screen = std::make_shared<ms::BasicSurface>(
+        nullptr /* session */,
+        std::string("on screen"),
+        geom::Rectangle{{0, 0}, {10, 10}},
+        mir_pointer_unconfined,
+        std::list<ms::StreamInfo> { { on_screen_stream, {}, {} } },
+        std::shared_ptr<mg::CursorImage>(),
+        report);
+    auto const off_screen = std::make_shared<ms::BasicSurface>(
+        nullptr /* session */,
+        std::string("off screen"),
+        geom::Rectangle{{200, 200}, {10, 10}},
+        mir_pointer_unconfined,
+        std::list<ms::StreamInfo> { { off_screen_stream, {}, {} } },
+        std::shared_ptr<mg::CursorImage>(),
+        report);
+
+    stack.register_compositor(compositor_id);
+    stack.set_compositor_area(compositor_id, {{0, 0}, {100, 100}});
+    stack.add_surface(on_screen, default_params.input_mode);
+    stack.add_surface(off_screen, default_params.input_mode);
+
+    post_a_frame(*on_screen_stream);
+    post_a_frame(*off_screen_stream);
+    for (auto& element : stack.scene_elements_for(compositor_id))
+        element->renderable()->buffer();
+
+    post_a_frame(*off_screen_stream);
+    EXPECT_THAT(stack.frames_pending(compositor_id), Eq(0));
+
+    post_a_frame(*on_screen_stream);
+    EXPECT_THAT(stack.frames_pending(compositor_id), Eq(1));
+}
+
 TEST_F(SurfaceStack, observer_can_trigger_state_change_within_notification)
 {
     using namespace ::testing;
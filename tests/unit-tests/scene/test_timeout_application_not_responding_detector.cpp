@@ -469,3 +469,87 @@ TEST(TimeoutApplicationNotRespondingDetector, sends_pings_on_schedule_as_session
 
     EXPECT_THAT(ping_count, Ge(duration / cycle_time));
 }
+
+TEST(TimeoutApplicationNotRespondingDetector, pings_each_session_a_period_after_it_registered)
+{
+    using namespace testing;
+    using namespace std::literals::chrono_literals;
+
+    mtd::FakeAlarmFactory fake_alarms;
+
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+
+    bool first_session_pinged{false}, second_session_pinged{false};
+
+    NiceMock<mtd::MockSceneSession> session_one, session_two;
+
+    detector.register_session(&session_one, [&first_session_pinged]() { first_session_pinged = true; });
+    fake_alarms.advance_by(500ms);
+    detector.register_session(&session_two, [&second_session_pinged]() { second_session_pinged = true; });
+
+    fake_alarms.advance_by(501ms);
+
+    EXPECT_TRUE(first_session_pinged);
+    EXPECT_FALSE(second_session_pinged);
+
+    fake_alarms.advance_by(500ms);
+
+    EXPECT_TRUE(second_session_pinged);
+}
+
+TEST(TimeoutApplicationNotRespondingDetector, does_not_ping_session_that_has_been_active)
+{
+    using namespace testing;
+    using namespace std::literals::chrono_literals;
+
+    mtd::FakeAlarmFactory fake_alarms;
+
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+
+    int ping_count{0};
+
+    NiceMock<mtd::MockSceneSession> session;
+
+    detector.register_session(&session, [&ping_count]() { ++ping_count; });
+
+    fake_alarms.advance_by(500ms);
+    detector.activity_received(&session);
+    fake_alarms.advance_by(501ms);
+
+    EXPECT_THAT(ping_count, Eq(0));
+
+    // With no further activity the session is pinged a period later
+    fake_alarms.advance_by(1001ms);
+
+    EXPECT_THAT(ping_count, Eq(1));
+}
+
+TEST(TimeoutApplicationNotRespondingDetector, activity_does_not_answer_an_outstanding_ping)
+{
+    using namespace testing;
+    using namespace std::literals::chrono_literals;
+
+    mtd::FakeAlarmFactory fake_alarms;
+
+    ms::TimeoutApplicationNotRespondingDetector detector{fake_alarms, 1s};
+
+    bool session_not_responding{false};
+    auto observer = std::make_shared<NiceMock<MockObserver>>();
+    ON_CALL(*observer, session_unresponsive(_))
+        .WillByDefault(Invoke([&session_not_responding](auto /*session*/)
+    {
+        session_not_responding = true;
+    }));
+    detector.register_observer(observer);
+
+    NiceMock<mtd::MockSceneSession> session;
+
+    detector.register_session(&session, [](){});
+
+    fake_alarms.advance_by(1001ms);
+    // Should now have pung
+    detector.activity_received(&session);
+
+    fake_alarms.advance_by(1001ms);
+    EXPECT_TRUE(session_not_responding);
+}
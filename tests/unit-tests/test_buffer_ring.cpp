@@ -0,0 +1,106 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/frontend/buffer_ring.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <poll.h>
+#include <sys/mman.h>
+
+namespace mf = mir::frontend;
+using namespace testing;
+
+namespace
+{
+bool readable(mir::Fd const& fd)
+{
+    pollfd pfd{fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) == 1;
+}
+
+struct BufferRing : Test
+{
+    std::unique_ptr<mf::BufferRing> const server{mf::BufferRing::create()};
+    std::vector<mir::Fd> const fds{server->fds()};
+    mf::BufferRing client{fds[0], fds[1], fds[2], mf::BufferRing::End::client};
+
+    std::vector<int32_t> drain(mf::BufferRing& ring)
+    {
+        std::vector<int32_t> ids;
+        ring.drain([&](int32_t id) { ids.push_back(id); });
+        return ids;
+    }
+};
+}
+
+TEST_F(BufferRing, submissions_reach_server_in_order)
+{
+    EXPECT_TRUE(client.push(3));
+    EXPECT_TRUE(client.push(1));
+    EXPECT_TRUE(client.push(2));
+
+    EXPECT_THAT(drain(*server), ElementsAre(3, 1, 2));
+}
+
+TEST_F(BufferRing, releases_reach_client_in_order)
+{
+    EXPECT_TRUE(server->push(7));
+    EXPECT_TRUE(server->push(8));
+
+    EXPECT_THAT(drain(client), ElementsAre(7, 8));
+}
+
+TEST_F(BufferRing, only_signals_a_sleeping_consumer)
+{
+    client.push(1);
+    EXPECT_TRUE(readable(server->incoming_event()));
+
+    // Consumer hasn't drained yet, so hasn't said it's sleeping again
+    client.push(2);
+    drain(*server);
+    EXPECT_FALSE(readable(server->incoming_event()));
+
+    client.push(3);
+    EXPECT_TRUE(readable(server->incoming_event()));
+}
+
+TEST_F(BufferRing, full_ring_refuses_push)
+{
+    for (auto i = 0u; i != mf::BufferRing::capacity; ++i)
+        EXPECT_TRUE(client.push(i));
+
+    EXPECT_FALSE(client.push(-1));
+
+    drain(*server);
+    EXPECT_TRUE(client.push(-1));
+}
+
+TEST_F(BufferRing, impossible_producer_index_breaks_ring)
+{
+    auto const shared = static_cast<std::atomic<uint32_t>*>(
+        mmap(nullptr, sizeof(std::atomic<uint32_t>), PROT_READ|PROT_WRITE, MAP_SHARED, fds[0], 0));
+    ASSERT_THAT(shared, Ne(MAP_FAILED));
+
+    // The submission queue's head is the first thing in the mapping
+    shared->store(mf::BufferRing::capacity + 1);
+    munmap(shared, sizeof(std::atomic<uint32_t>));
+
+    EXPECT_THAT(drain(*server), IsEmpty());
+    EXPECT_TRUE(server->is_broken());
+    EXPECT_FALSE(server->push(1));
+}
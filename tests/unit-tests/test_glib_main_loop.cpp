@@ -792,6 +792,37 @@ TEST_F(GLibMainLoopTest, dispatches_actions_resumed_externally)
     EXPECT_THAT(actions, ElementsAre(1, 0));
 }
 
+TEST_F(GLibMainLoopTest, dispatches_burst_of_actions_from_another_thread_in_order)
+{
+    using namespace testing;
+
+    int const num_actions{1000};
+    std::vector<int> actions;
+    int const owner{0};
+
+    std::thread t{
+        [&]
+        {
+            for (int i = 0; i < num_actions; ++i)
+            {
+                ml.enqueue(
+                    &owner,
+                    [&,i]
+                    {
+                        actions.push_back(i);
+                        if (i == num_actions - 1)
+                            ml.stop();
+                    });
+            }
+        }};
+
+    ml.run();
+
+    t.join();
+
+    EXPECT_THAT(actions, ContainerEq(values_from_to(0, num_actions - 1)));
+}
+
 TEST_F(GLibMainLoopTest, propagates_exception_from_server_action)
 {
     // Execute in forked process to work around
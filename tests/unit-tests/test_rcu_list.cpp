@@ -0,0 +1,304 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/rcu_list.h"
+#include "mir/test/signal.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <thread>
+
+using namespace testing;
+
+namespace
+{
+
+struct Dummy {};
+using Element = std::shared_ptr<Dummy>;
+using SharedPtrList = mir::RcuList<Element>;
+
+struct RcuListTest : testing::Test
+{
+    SharedPtrList list;
+
+    Element const element1 = std::make_shared<Dummy>();
+    Element const element2 = std::make_shared<Dummy>();
+
+    auto elements_seen() -> std::vector<Element>
+    {
+        std::vector<Element> result;
+        list.for_each([&] (Element const& element) { result.push_back(element); });
+        return result;
+    }
+};
+
+}
+
+TEST_F(RcuListTest, visits_elements_in_the_order_they_were_added)
+{
+    list.add(element1);
+    list.add(element2);
+
+    EXPECT_THAT(elements_seen(), ElementsAre(element1, element2));
+}
+
+TEST_F(RcuListTest, can_remove_element_while_iterating_same_element)
+{
+    list.add(element1);
+
+    list.for_each(
+        [&] (Element const& element)
+        {
+            list.remove(element);
+        });
+
+    EXPECT_THAT(elements_seen(), IsEmpty());
+}
+
+TEST_F(RcuListTest, removed_element_is_not_visited_by_iteration_in_progress)
+{
+    list.add(element1);
+    list.add(element2);
+
+    int elements_seen = 0;
+
+    list.for_each(
+        [&] (Element const&)
+        {
+            list.remove(element2);
+            ++elements_seen;
+        });
+
+    EXPECT_THAT(elements_seen, Eq(1));
+}
+
+TEST_F(RcuListTest, element_added_during_iteration_is_visited_next_time)
+{
+    list.add(element1);
+
+    int elements_seen = 0;
+
+    list.for_each(
+        [&] (Element const&)
+        {
+            list.add(element2);
+            ++elements_seen;
+        });
+
+    EXPECT_THAT(elements_seen, Eq(1));
+    EXPECT_THAT(this->elements_seen(), ElementsAre(element1, element2));
+}
+
+TEST_F(RcuListTest, remove_waits_for_element_in_use_on_another_thread)
+{
+    list.add(element1);
+
+    mir::test::Signal element_in_use;
+    std::atomic<bool> call_finished{false};
+
+    std::thread t{
+        [&]
+        {
+            list.for_each(
+                [&] (Element const&)
+                {
+                    element_in_use.raise();
+                    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+                    call_finished = true;
+                });
+        }};
+
+    element_in_use.wait_for(std::chrono::seconds{3});
+    list.remove(element1);
+
+    EXPECT_TRUE(call_finished);
+
+    t.join();
+}
+
+TEST_F(RcuListTest, can_remove_unused_element_while_different_element_is_used_in_different_thread)
+{
+    list.add(element1);
+    list.add(element2);
+
+    mir::test::Signal first_element_in_use;
+    mir::test::Signal second_element_removed;
+
+    int elements_seen = 0;
+
+    std::thread t{
+        [&]
+        {
+            list.for_each(
+                [&] (Element const&)
+                {
+                    first_element_in_use.raise();
+                    second_element_removed.wait_for(std::chrono::seconds{3});
+                    EXPECT_TRUE(second_element_removed.raised());
+                    ++elements_seen;
+                });
+        }};
+
+    first_element_in_use.wait_for(std::chrono::seconds{3});
+    list.remove(element2);
+    second_element_removed.raise();
+
+    t.join();
+
+    EXPECT_THAT(elements_seen, Eq(1));
+}
+
+TEST_F(RcuListTest, removes_all_matching_elements)
+{
+    list.add(element1);
+    list.add(element2);
+    list.add(element1);
+
+    EXPECT_THAT(list.remove_all(element1), Eq(2u));
+    EXPECT_THAT(elements_seen(), ElementsAre(element2));
+}
+
+TEST_F(RcuListTest, remove_only_removes_one_matching_element)
+{
+    list.add(element1);
+    list.add(element2);
+    list.add(element1);
+
+    list.remove(element1);
+
+    EXPECT_THAT(elements_seen(), ElementsAre(element2, element1));
+}
+
+TEST_F(RcuListTest, clears_all_elements)
+{
+    list.add(element1);
+    list.add(element2);
+    list.add(element1);
+
+    list.clear();
+
+    EXPECT_THAT(elements_seen(), IsEmpty());
+}
+
+TEST_F(RcuListTest, removed_element_is_released_once_iteration_finishes)
+{
+    auto element = std::make_shared<Dummy>();
+    std::weak_ptr<Dummy> const weak{element};
+
+    list.add(element);
+    element.reset();
+
+    list.for_each(
+        [&] (Element const& element)
+        {
+            list.remove(element);
+            EXPECT_FALSE(weak.expired());
+        });
+
+    EXPECT_TRUE(weak.expired());
+}
+
+TEST_F(RcuListTest, removing_element_from_its_own_call_waits_only_for_other_threads)
+{
+    list.add(element1);
+
+    mir::test::Signal first_call_started;
+    mir::test::Signal first_call_can_finish;
+    mir::test::Signal removing;
+    mir::test::Signal removed;
+
+    std::thread first{
+        [&]
+        {
+            list.for_each(
+                [&] (Element const&)
+                {
+                    first_call_started.raise();
+                    first_call_can_finish.wait_for(std::chrono::seconds{3});
+                });
+        }};
+
+    first_call_started.wait_for(std::chrono::seconds{3});
+
+    std::thread second{
+        [&]
+        {
+            list.for_each(
+                [&] (Element const& element)
+                {
+                    removing.raise();
+                    list.remove(element);
+                    removed.raise();
+                });
+        }};
+
+    removing.wait_for(std::chrono::seconds{3});
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    first_call_can_finish.raise();
+
+    EXPECT_TRUE(removed.wait_for(std::chrono::seconds{3}));
+
+    first.join();
+    second.join();
+}
+
+TEST_F(RcuListTest, removed_element_is_released_while_later_iterations_are_in_progress)
+{
+    auto element = std::make_shared<Dummy>();
+    std::weak_ptr<Dummy> const weak{element};
+
+    list.add(element1);
+    list.add(element);
+    element.reset();
+
+    auto const read_until = [&](mir::test::Signal& reading, mir::test::Signal& finish)
+        {
+            return std::thread{
+                [&]
+                {
+                    list.for_each(
+                        [&] (Element const& e)
+                        {
+                            if (e != element1)
+                                return;
+
+                            reading.raise();
+                            finish.wait_for(std::chrono::seconds{3});
+                        });
+                }};
+        };
+
+    mir::test::Signal first_reading, first_can_finish;
+    auto first = read_until(first_reading, first_can_finish);
+    first_reading.wait_for(std::chrono::seconds{3});
+
+    list.remove_all(weak.lock());
+
+    mir::test::Signal second_reading, second_can_finish;
+    auto second = read_until(second_reading, second_can_finish);
+    second_reading.wait_for(std::chrono::seconds{3});
+
+    EXPECT_FALSE(weak.expired());
+
+    first_can_finish.raise();
+    first.join();
+
+    EXPECT_TRUE(weak.expired());
+
+    second_can_finish.raise();
+    second.join();
+}
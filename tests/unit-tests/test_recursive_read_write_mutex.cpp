@@ -174,3 +174,39 @@ TEST_F(RecursiveReadWriteMutex, read_lock_waits_for_write_locks_on_other_threads
 
     threads.push_back(std::thread{writer_function});
 }
+
+TEST_F(RecursiveReadWriteMutex, read_lock_on_thread_with_read_lock_does_not_wait_for_waiting_writer)
+{
+    EXPECT_CALL(*this, notify_write_locked()).Times(1);
+
+    mutex.read_lock();
+
+    threads.push_back(std::thread{
+        [&]{
+            mutex.write_lock();
+            notify_write_locked();
+            mutex.write_unlock();
+        }});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+    mutex.read_lock();
+    mutex.read_unlock();
+    mutex.read_unlock();
+}
+
+TEST_F(RecursiveReadWriteMutex, read_locks_left_on_a_destroyed_mutex_do_not_affect_a_new_one)
+{
+    {
+        auto const destroyed = std::make_unique<mir::RecursiveReadWriteMutex>();
+        destroyed->read_lock();
+    }
+
+    // Probably at the same address
+    auto const replacement = std::make_unique<mir::RecursiveReadWriteMutex>();
+
+    replacement->write_lock();
+    replacement->read_lock();
+    replacement->read_unlock();
+    replacement->write_unlock();
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/time/timer_wheel.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <map>
+#include <random>
+
+namespace mt = mir::time;
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct TimerWheelTest : Test
+{
+    mt::Timestamp const origin{1000h};
+    mt::TimerWheel wheel{origin, 1ms};
+
+    auto expire_at(mt::Duration since_origin) -> std::vector<mt::TimerWheel::Timer*>
+    {
+        std::vector<mt::TimerWheel::Timer*> expired;
+        wheel.expire(origin + since_origin, expired);
+        return expired;
+    }
+};
+}
+
+TEST_F(TimerWheelTest, expires_timer_at_its_time_and_not_before)
+{
+    mt::TimerWheel::Timer timer;
+    wheel.schedule(timer, origin + 10ms);
+
+    EXPECT_THAT(expire_at(9ms), IsEmpty());
+    EXPECT_TRUE(timer.is_scheduled());
+    EXPECT_THAT(expire_at(10ms), ElementsAre(&timer));
+    EXPECT_FALSE(timer.is_scheduled());
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST_F(TimerWheelTest, timer_between_ticks_expires_on_the_tick_after)
+{
+    mt::TimerWheel::Timer timer;
+    wheel.schedule(timer, origin + 10ms + 1us);
+
+    EXPECT_THAT(expire_at(10ms + 500us), IsEmpty());
+    EXPECT_THAT(expire_at(11ms), ElementsAre(&timer));
+}
+
+TEST_F(TimerWheelTest, timers_due_in_the_same_tick_expire_together)
+{
+    mt::TimerWheel::Timer first, second, third;
+    wheel.schedule(first, origin + 5ms);
+    wheel.schedule(second, origin + 5ms);
+    wheel.schedule(third, origin + 6ms);
+
+    EXPECT_THAT(expire_at(5ms), UnorderedElementsAre(&first, &second));
+    EXPECT_THAT(expire_at(6ms), ElementsAre(&third));
+}
+
+TEST_F(TimerWheelTest, overdue_timer_expires_on_next_expire)
+{
+    EXPECT_THAT(expire_at(100ms), IsEmpty());
+
+    mt::TimerWheel::Timer timer;
+    wheel.schedule(timer, origin + 50ms);
+
+    EXPECT_THAT(expire_at(100ms), ElementsAre(&timer));
+}
+
+TEST_F(TimerWheelTest, cancelled_timer_does_not_expire)
+{
+    mt::TimerWheel::Timer timer;
+    wheel.schedule(timer, origin + 10ms);
+
+    EXPECT_TRUE(wheel.cancel(timer));
+    EXPECT_FALSE(wheel.cancel(timer));
+    EXPECT_THAT(expire_at(1s), IsEmpty());
+}
+
+TEST_F(TimerWheelTest, rescheduling_replaces_previous_time)
+{
+    mt::TimerWheel::Timer timer;
+    EXPECT_FALSE(wheel.schedule(timer, origin + 10ms));
+    EXPECT_TRUE(wheel.schedule(timer, origin + 20ms));
+
+    EXPECT_THAT(expire_at(19ms), IsEmpty());
+    EXPECT_THAT(expire_at(20ms), ElementsAre(&timer));
+}
+
+TEST_F(TimerWheelTest, timers_on_every_level_cascade_and_expire_on_time)
+{
+    std::vector<mt::Duration> const delays{63ms, 64ms, 4095ms, 4096ms, 300s, 5h, 100h};
+    std::vector<mt::TimerWheel::Timer> timers(delays.size());
+
+    for (auto i = 0u; i != delays.size(); ++i)
+        wheel.schedule(timers[i], origin + delays[i]);
+
+    for (auto i = 0u; i != delays.size(); ++i)
+    {
+        EXPECT_THAT(expire_at(delays[i] - 1ms), IsEmpty()) << "delay " << delays[i].count();
+        EXPECT_THAT(expire_at(delays[i]), ElementsAre(&timers[i])) << "delay " << delays[i].count();
+    }
+}
+
+TEST_F(TimerWheelTest, next_deadline_is_never_after_first_expiry)
+{
+    EXPECT_THAT(wheel.next_deadline(), Eq(mt::Timestamp::max()));
+
+    mt::TimerWheel::Timer near, far;
+    wheel.schedule(far, origin + 10s);
+    EXPECT_THAT(wheel.next_deadline(), Le(origin + 10s));
+
+    wheel.schedule(near, origin + 7ms);
+    EXPECT_THAT(wheel.next_deadline(), Eq(origin + 7ms));
+
+    expire_at(7ms);
+    auto deadline = wheel.next_deadline();
+    while (deadline < origin + 10s)
+    {
+        EXPECT_THAT(expire_at(deadline - origin), IsEmpty());
+        deadline = wheel.next_deadline();
+    }
+
+    EXPECT_THAT(deadline, Eq(origin + 10s));
+    EXPECT_THAT(expire_at(10s), ElementsAre(&far));
+}
+
+TEST_F(TimerWheelTest, following_next_deadline_matches_a_sorted_schedule)
+{
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> delay_ms{0, 20000};
+    std::vector<mt::TimerWheel::Timer> timers(2000);
+    std::multimap<mt::Timestamp, mt::TimerWheel::Timer*> expected;
+
+    for (auto& timer : timers)
+    {
+        auto const time = origin + std::chrono::milliseconds{delay_ms(random)};
+        wheel.schedule(timer, time);
+        expected.emplace(time, &timer);
+    }
+
+    // Cancel and reschedule some, as a busy server would
+    for (auto i = 0u; i < timers.size(); i += 7)
+    {
+        auto& timer = timers[i];
+        auto const old = std::find_if(begin(expected), end(expected),
+            [&](auto const& entry) { return entry.second == &timer; });
+        expected.erase(old);
+
+        if (i % 2)
+        {
+            wheel.cancel(timer);
+        }
+        else
+        {
+            auto const time = origin + std::chrono::milliseconds{delay_ms(random)};
+            wheel.schedule(timer, time);
+            expected.emplace(time, &timer);
+        }
+    }
+
+    while (!wheel.empty())
+    {
+        auto const now = wheel.next_deadline();
+        auto const due = expected.upper_bound(now);
+
+        std::vector<mt::TimerWheel::Timer*> expired;
+        wheel.expire(now, expired);
+
+        std::vector<mt::TimerWheel::Timer*> expected_expired;
+        for (auto i = begin(expected); i != due; ++i)
+            expected_expired.push_back(i->second);
+        expected.erase(begin(expected), due);
+
+        ASSERT_THAT(expired, UnorderedElementsAreArray(expected_expired));
+    }
+
+    EXPECT_THAT(expected, IsEmpty());
+}
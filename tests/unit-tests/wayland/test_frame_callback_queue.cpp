@@ -0,0 +1,86 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/frame_callback_queue.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+
+using namespace testing;
+
+namespace
+{
+struct FrameCallbackQueue : Test
+{
+    mf::FrameCallbackQueue<int> queue;
+};
+}
+
+TEST_F(FrameCallbackQueue, callbacks_without_a_buffer_are_due_at_once_while_exposed)
+{
+    EXPECT_THAT(queue.add_without_buffer({1, 2}), ElementsAre(1, 2));
+    EXPECT_THAT(queue.take_all(), IsEmpty());
+}
+
+TEST_F(FrameCallbackQueue, callbacks_with_a_buffer_wait_for_it_to_be_consumed)
+{
+    queue.add_with_buffer({1});
+    queue.add_with_buffer({2});
+
+    EXPECT_THAT(queue.take_all(), ElementsAre(1, 2));
+    EXPECT_THAT(queue.take_all(), IsEmpty());
+}
+
+TEST_F(FrameCallbackQueue, callbacks_without_a_buffer_are_withheld_while_not_exposed)
+{
+    EXPECT_THAT(queue.set_exposed(false), IsEmpty());
+
+    EXPECT_THAT(queue.add_without_buffer({1}), IsEmpty());
+    EXPECT_THAT(queue.add_without_buffer({2}), IsEmpty());
+    EXPECT_FALSE(queue.exposed());
+}
+
+TEST_F(FrameCallbackQueue, withheld_callbacks_are_released_when_exposed)
+{
+    queue.set_exposed(false);
+    queue.add_without_buffer({1, 2});
+
+    EXPECT_THAT(queue.set_exposed(true), ElementsAre(1, 2));
+    EXPECT_THAT(queue.set_exposed(true), IsEmpty());
+    EXPECT_TRUE(queue.exposed());
+}
+
+TEST_F(FrameCallbackQueue, exposure_does_not_release_callbacks_waiting_on_a_buffer)
+{
+    queue.set_exposed(false);
+    queue.add_with_buffer({1});
+    queue.add_without_buffer({2});
+
+    EXPECT_THAT(queue.set_exposed(true), ElementsAre(2));
+    EXPECT_THAT(queue.take_all(), ElementsAre(1));
+}
+
+TEST_F(FrameCallbackQueue, consuming_a_buffer_releases_withheld_callbacks_too)
+{
+    queue.set_exposed(false);
+    queue.add_without_buffer({1});
+    queue.add_with_buffer({2});
+
+    EXPECT_THAT(queue.take_all(), UnorderedElementsAre(1, 2));
+    EXPECT_THAT(queue.set_exposed(true), IsEmpty());
+}
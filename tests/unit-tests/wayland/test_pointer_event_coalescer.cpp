@@ -0,0 +1,176 @@
+/*
+ * Copyright © 2026 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/pointer_event_coalescer.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+namespace geom = mir::geometry;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct MockSink
+{
+    MOCK_METHOD2(send_motion, void(std::chrono::milliseconds const&, geom::Point const&));
+    MOCK_METHOD2(send_axis, void(std::chrono::milliseconds const&, geom::Displacement const&));
+    MOCK_METHOD0(frame, void());
+    MOCK_METHOD1(other, void(char const*));
+};
+
+struct PointerEventCoalescer : Test
+{
+    StrictMock<MockSink> sink;
+    mf::PointerEventCoalescer<MockSink> coalescer{sink, true};
+
+    void hold_motion_and_scroll()
+    {
+        coalescer.motion(1ms, {10, 10});
+        coalescer.axis(2ms, {0, 5});
+    }
+
+    void expect_held_motion_and_scroll_then(char const* event)
+    {
+        InSequence seq;
+        EXPECT_CALL(sink, send_motion(2ms, geom::Point{10, 10}));
+        EXPECT_CALL(sink, send_axis(2ms, geom::Displacement{0, 5}));
+        EXPECT_CALL(sink, frame());
+        EXPECT_CALL(sink, other(StrEq(event)));
+    }
+};
+}
+
+TEST_F(PointerEventCoalescer, holds_back_motion_and_scroll)
+{
+    hold_motion_and_scroll();
+
+    EXPECT_TRUE(coalescer.holding());
+}
+
+TEST_F(PointerEventCoalescer, sends_only_the_latest_position)
+{
+    coalescer.motion(1ms, {1, 1});
+    coalescer.motion(2ms, {2, 2});
+    coalescer.motion(3ms, {3, 3});
+
+    InSequence seq;
+    EXPECT_CALL(sink, send_motion(3ms, geom::Point{3, 3}));
+    EXPECT_CALL(sink, frame());
+
+    coalescer.flush();
+}
+
+TEST_F(PointerEventCoalescer, sums_scroll_deltas)
+{
+    coalescer.axis(1ms, {1, 5});
+    coalescer.axis(2ms, {0, -2});
+    coalescer.axis(3ms, {2, 4});
+
+    InSequence seq;
+    EXPECT_CALL(sink, send_axis(3ms, geom::Displacement{3, 7}));
+    EXPECT_CALL(sink, frame());
+
+    coalescer.flush();
+}
+
+TEST_F(PointerEventCoalescer, sends_nothing_more_once_flushed)
+{
+    hold_motion_and_scroll();
+    EXPECT_CALL(sink, send_motion(_, _));
+    EXPECT_CALL(sink, send_axis(_, _));
+    EXPECT_CALL(sink, frame());
+    coalescer.flush();
+
+    EXPECT_FALSE(coalescer.holding());
+    coalescer.flush();
+}
+
+TEST_F(PointerEventCoalescer, held_events_are_not_overtaken_by_a_button)
+{
+    hold_motion_and_scroll();
+    expect_held_motion_and_scroll_then("button");
+
+    coalescer.send_after_held([this] { sink.other("button"); });
+}
+
+TEST_F(PointerEventCoalescer, held_events_are_not_overtaken_by_enter)
+{
+    hold_motion_and_scroll();
+    expect_held_motion_and_scroll_then("enter");
+
+    coalescer.send_after_held([this] { sink.other("enter"); });
+}
+
+TEST_F(PointerEventCoalescer, held_events_are_not_overtaken_by_leave)
+{
+    hold_motion_and_scroll();
+    expect_held_motion_and_scroll_then("leave");
+
+    coalescer.send_after_held([this] { sink.other("leave"); });
+}
+
+// WaylandInputDispatcher flushes every pointer before it sends a key or touch event
+TEST_F(PointerEventCoalescer, held_events_are_not_overtaken_by_a_key)
+{
+    hold_motion_and_scroll();
+    expect_held_motion_and_scroll_then("key");
+
+    coalescer.flush();
+    sink.other("key");
+}
+
+TEST_F(PointerEventCoalescer, held_events_are_not_overtaken_by_a_touch)
+{
+    hold_motion_and_scroll();
+    expect_held_motion_and_scroll_then("touch");
+
+    coalescer.flush();
+    sink.other("touch");
+}
+
+TEST_F(PointerEventCoalescer, events_after_a_flush_are_held_afresh)
+{
+    coalescer.axis(1ms, {0, 5});
+    EXPECT_CALL(sink, send_axis(1ms, geom::Displacement{0, 5}));
+    EXPECT_CALL(sink, frame());
+    coalescer.flush();
+    Mock::VerifyAndClearExpectations(&sink);
+
+    coalescer.axis(2ms, {0, 1});
+
+    EXPECT_CALL(sink, send_axis(2ms, geom::Displacement{0, 1}));
+    EXPECT_CALL(sink, frame());
+    coalescer.flush();
+}
+
+TEST_F(PointerEventCoalescer, passes_everything_straight_through_when_disabled)
+{
+    mf::PointerEventCoalescer<MockSink> disabled{sink, false};
+
+    InSequence seq;
+    EXPECT_CALL(sink, send_motion(1ms, geom::Point{1, 1}));
+    EXPECT_CALL(sink, send_axis(2ms, geom::Displacement{0, 5}));
+    EXPECT_CALL(sink, other(StrEq("button")));
+
+    disabled.motion(1ms, {1, 1});
+    disabled.axis(2ms, {0, 5});
+    EXPECT_FALSE(disabled.holding());
+    disabled.send_after_held([this] { sink.other("button"); });
+}